@@ -0,0 +1,144 @@
+// Random lookups into sorted int arrays from L1-sized to DRAM-sized.
+//
+//   g++ -O2 -I. bench/algorithm/binary_search.cpp -o binary_search
+//   (add -mavx2 for the vector compares of static_search_tree)
+//   ./binary_search [log2 of the largest size, default 26]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/binary_search.hpp"
+#include "sml/algorithm/binary_search_min_max.hpp"
+#include "sml/algorithm/eytzinger_index.hpp"
+#include "sml/algorithm/static_search_tree.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+// the three-way search binary_search used before the branchless kernel
+const int* classic_binary_search(const int* begin, const int* end, int v) {
+  long first = 0, last = (end - begin) - 1;
+
+  while (first <= last) {
+    const long medium = first + (last - first) / 2;
+    const int  m      = begin[medium];
+
+    if (v < m)      last  = medium - 1;
+    else if (v > m) first = medium + 1;
+    else            return begin + medium;
+  }
+  return end;
+}
+
+struct classic_search {
+  const int* operator()(const int* b, const int* e, int v) const {
+    return classic_binary_search(b, e, v);
+  }
+};
+
+struct std_lower_bound {
+  const int* operator()(const int* b, const int* e, int v) const {
+    return std::lower_bound(b, e, v);
+  }
+};
+
+struct sml_binary_search {
+  const int* operator()(const int* b, const int* e, int v) const {
+    return sml::algorithm::binary_search(b, e, v);
+  }
+};
+
+struct sml_binary_search_min_max {
+  const int* operator()(const int* b, const int* e, int v) const {
+    return sml::algorithm::binary_search_min_max(b, e, v).first;
+  }
+};
+
+double measure_eytzinger(
+  std::vector<int> const& seq,
+  std::vector<int> const& keys,
+  long&                   checksum
+) {
+  sml::algorithm::eytzinger_index<int> const index(seq.begin(), seq.end());
+
+  bench::timer timer;
+  for (std::vector<int>::size_type i = 0; i < keys.size(); ++i) {
+    checksum += index.lower_bound(keys[i]);
+  }
+  return timer.seconds() * 1e9 / static_cast<double>(keys.size());
+}
+
+double measure_static_search_tree(
+  std::vector<int> const& seq,
+  std::vector<int> const& keys,
+  long&                   checksum
+) {
+  sml::algorithm::static_search_tree<int> const tree(seq.begin(), seq.end());
+
+  bench::timer timer;
+  for (std::vector<int>::size_type i = 0; i < keys.size(); ++i) {
+    checksum += tree.lower_bound(keys[i]);
+  }
+  return timer.seconds() * 1e9 / static_cast<double>(keys.size());
+}
+
+template<class Search>
+double measure(
+  std::vector<int> const& seq,
+  std::vector<int> const& keys,
+  Search                  search,
+  long&                   checksum
+) {
+  const int* const b = &seq[0];
+  const int* const e = b + seq.size();
+
+  bench::timer timer;
+  for (std::vector<int>::size_type i = 0; i < keys.size(); ++i) {
+    checksum += search(b, e, keys[i]) - b;
+  }
+  return timer.seconds() * 1e9 / static_cast<double>(keys.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int max_log2 = argc > 1 ? std::atoi(argv[1]) : 26;
+  const int LOOKUPS  = 1 << 20;
+
+  sml::random::xoshiro256ss rand(1);
+  long checksum = 0;
+
+  std::printf("%12s %10s %10s %10s %10s %10s %10s   (ns per lookup)\n",
+              "bytes", "classic", "std", "sml", "min_max", "eytzinger",
+              "s+tree");
+
+  for (int lg = 10; lg <= max_log2; lg += 2) {
+    const std::size_t n = std::size_t(1) << lg;
+
+    std::vector<int> seq(n);
+    for (std::size_t i = 0; i < n; ++i) seq[i] = static_cast<int>(2 * i);
+
+    std::vector<int> keys(LOOKUPS);
+    for (int i = 0; i < LOOKUPS; ++i) {
+      keys[i] = static_cast<int>(sml::random::bounded_rand(rand, 2 * n));
+    }
+
+    const double classic = measure(seq, keys, classic_search(), checksum);
+    const double stdlb   = measure(seq, keys, std_lower_bound(), checksum);
+    const double sml     = measure(seq, keys, sml_binary_search(), checksum);
+    const double minmax  =
+      measure(seq, keys, sml_binary_search_min_max(), checksum);
+    const double eytz    = measure_eytzinger(seq, keys, checksum);
+    const double stree   = measure_static_search_tree(seq, keys, checksum);
+
+    std::printf("%12lu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                static_cast<unsigned long>(n * sizeof(int)),
+                classic, stdlb, sml, minmax, eytz, stree);
+  }
+
+  std::printf("checksum %ld\n", checksum);
+  return 0;
+}
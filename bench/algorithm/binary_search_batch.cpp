@@ -0,0 +1,98 @@
+// Batched lookups of random and of sorted keys, against one lookup at a
+// time, from L1-sized to DRAM-sized tables.
+//
+//   g++ -O2 -I. bench/algorithm/binary_search_batch.cpp -o binary_search_batch
+//   ./binary_search_batch [log2 of the largest size, default 26]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/binary_search.hpp"
+#include "sml/algorithm/binary_search_batch.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+double measure_single(
+  std::vector<int> const&  seq,
+  std::vector<int> const&  keys,
+  std::vector<const int*>& res
+) {
+  const int* const b = &seq[0];
+  const int* const e = b + seq.size();
+
+  bench::timer timer;
+  for (std::vector<int>::size_type i = 0; i < keys.size(); ++i) {
+    res[i] = sml::algorithm::binary_search(b, e, keys[i]);
+  }
+  return timer.seconds() * 1e9 / static_cast<double>(keys.size());
+}
+
+double measure_batch(
+  std::vector<int> const&  seq,
+  std::vector<int> const&  keys,
+  std::vector<const int*>& res
+) {
+  const int* const b = &seq[0];
+  const int* const e = b + seq.size();
+
+  bench::timer timer;
+  sml::algorithm::binary_search_batch(b, e, keys.begin(), keys.end(), res.begin());
+  return timer.seconds() * 1e9 / static_cast<double>(keys.size());
+}
+
+long checksum(std::vector<int> const& seq, std::vector<const int*> const& res) {
+  long sum = 0;
+  for (std::vector<const int*>::size_type i = 0; i < res.size(); ++i) {
+    sum += res[i] - &seq[0];
+  }
+  return sum;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int max_log2 = argc > 1 ? std::atoi(argv[1]) : 26;
+  const int LOOKUPS  = 1 << 20;
+
+  sml::random::xoshiro256ss rand(1);
+  long sum = 0;
+
+  std::printf("%12s %10s %10s %10s %10s   (ns per lookup)\n",
+              "bytes", "single", "batch", "sorted", "sorted_b");
+
+  for (int lg = 10; lg <= max_log2; lg += 2) {
+    const std::size_t n = std::size_t(1) << lg;
+
+    std::vector<int> seq(n);
+    for (std::size_t i = 0; i < n; ++i) seq[i] = static_cast<int>(2 * i);
+
+    std::vector<int> keys(LOOKUPS);
+    for (int i = 0; i < LOOKUPS; ++i) {
+      keys[i] = static_cast<int>(sml::random::bounded_rand(rand, 2 * n));
+    }
+    std::vector<int> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<const int*> res(LOOKUPS);
+
+    const double single   = measure_single(seq, keys, res);
+    sum += checksum(seq, res);
+    const double batch    = measure_batch(seq, keys, res);
+    sum += checksum(seq, res);
+    const double ssingle  = measure_single(seq, sorted, res);
+    sum += checksum(seq, res);
+    const double sbatch   = measure_batch(seq, sorted, res);
+    sum += checksum(seq, res);
+
+    std::printf("%12lu %10.1f %10.1f %10.1f %10.1f\n",
+                static_cast<unsigned long>(n * sizeof(int)),
+                single, batch, ssingle, sbatch);
+  }
+
+  std::printf("checksum %ld\n", sum);
+  return 0;
+}
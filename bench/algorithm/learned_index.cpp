@@ -0,0 +1,72 @@
+// Random lookups into near-linear sorted arrays, such as timestamps with
+// jitter: learned_index against binary_search, with the model's build
+// time and size.
+//
+//   g++ -O2 -I. bench/algorithm/learned_index.cpp -o learned_index
+//   ./learned_index [log2 of the largest size, default 26] [epsilon, default 32]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/binary_search.hpp"
+#include "sml/algorithm/learned_index.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+int main(int argc, char** argv) {
+  typedef std::vector<long>::const_iterator iterator;
+
+  const int         max_log2 = argc > 1 ? std::atoi(argv[1]) : 26;
+  const std::size_t epsilon  = argc > 2 ? std::atoi(argv[2]) : 32;
+  const int         LOOKUPS  = 1 << 20;
+
+  sml::random::xoshiro256ss rand(1);
+  long checksum = 0;
+
+  std::printf("%12s %10s %10s %10s %10s %10s   (ns per lookup)\n",
+              "keys", "build ms", "segments", "model KB", "binary", "learned");
+
+  for (int lg = 10; lg <= max_log2; lg += 2) {
+    const std::size_t n = std::size_t(1) << lg;
+
+    std::vector<long> seq(n);
+    long t = 1700000000000L;
+    for (std::size_t i = 0; i < n; ++i) {
+      t += 90 + static_cast<long>(sml::random::bounded_rand(rand, 20));
+      seq[i] = t;
+    }
+
+    std::vector<long> keys(LOOKUPS);
+    for (int i = 0; i < LOOKUPS; ++i) {
+      keys[i] = seq[sml::random::bounded_rand(rand, n)];
+    }
+
+    bench::timer build;
+    const sml::algorithm::learned_index<iterator> index(
+      seq.begin(), seq.end(), epsilon
+    );
+    const double build_ms = build.seconds() * 1e3;
+
+    bench::timer binary;
+    for (int i = 0; i < LOOKUPS; ++i) {
+      checksum += sml::algorithm::binary_search(seq.begin(), seq.end(), keys[i])
+        - seq.begin();
+    }
+    const double binary_ns = binary.seconds() * 1e9 / LOOKUPS;
+
+    bench::timer learned;
+    for (int i = 0; i < LOOKUPS; ++i) {
+      checksum += index.find(keys[i]) - seq.begin();
+    }
+    const double learned_ns = learned.seconds() * 1e9 / LOOKUPS;
+
+    std::printf("%12lu %10.2f %10lu %10.1f %10.1f %10.1f\n",
+                static_cast<unsigned long>(n), build_ms,
+                static_cast<unsigned long>(index.segments()),
+                index.model_bytes() / 1024.0, binary_ns, learned_ns);
+  }
+
+  std::printf("checksum %ld\n", checksum);
+  return 0;
+}
@@ -0,0 +1,75 @@
+// min_max over arrays that fit in cache and arrays that do not: the
+// pairwise scan (forced with a comparator other than sml::op::lesser)
+// against the vector kernel.
+//
+//   g++ -O2 -I. bench/algorithm/min_max.cpp -o min_max
+//   (add -mavx2 for 256-bit lanes)
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/min_max.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+struct pairwise_lesser {
+  template<class T>
+  bool operator()(const T& a, const T& b) const {
+    return a < b;
+  }
+};
+
+template<class T, class Lesser>
+double measure(std::vector<T> const& seq, Lesser lesser, long& checksum) {
+  const T* const b = &seq[0];
+  const T* const e = b + seq.size();
+  const int rounds = static_cast<int>((std::size_t(1) << 26) / seq.size()) + 1;
+
+  bench::timer timer;
+  for (int r = 0; r < rounds; ++r) {
+    const std::pair<const T*, const T*> res =
+      sml::algorithm::min_max(b, e, lesser);
+    checksum += (res.first - b) + (res.second - b);
+  }
+  const double bytes = double(rounds) * double(seq.size() * sizeof(T));
+  return bytes / timer.seconds() * 1e-9;
+}
+
+template<class T>
+void run(const char* name, long& checksum) {
+  sml::random::xoshiro256ss rand(1);
+
+  for (int lg = 12; lg <= 24; lg += 6) {
+    std::vector<T> seq(std::size_t(1) << lg);
+    for (std::size_t i = 0; i < seq.size(); ++i) {
+      seq[i] = T(sml::random::bounded_rand(rand, 1000000));
+    }
+
+    const double pairwise = measure(seq, pairwise_lesser(), checksum);
+    const double vector   = measure(seq, sml::op::lesser(), checksum);
+
+    std::printf("%8s %12lu %10.2f %10.2f\n", name,
+                static_cast<unsigned long>(seq.size() * sizeof(T)),
+                pairwise, vector);
+  }
+}
+
+} // namespace
+
+int main() {
+  long checksum = 0;
+
+  std::printf("%8s %12s %10s %10s   (GB/s)\n",
+              "type", "bytes", "pairwise", "vector");
+
+  run<int>("int", checksum);
+  run<long>("long", checksum);
+  run<float>("float", checksum);
+  run<double>("double", checksum);
+
+  std::printf("checksum %ld\n", checksum);
+  return 0;
+}
@@ -0,0 +1,105 @@
+// Sorting and searching heap-allocated strings directly, and through 8-
+// and 16-byte sml::utility::prefix_key, with sml::sort and binary_search.
+//
+//   g++ -O2 -I. bench/algorithm/prefix_key.cpp -o prefix_key
+//   ./prefix_key [number of strings, default 1 << 20]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/binary_search.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+#include "sml/sort.hpp"
+#include "sml/utility/prefix_key.hpp"
+
+namespace {
+
+struct result {
+  double      sort;
+  double      search;
+  std::size_t found;
+};
+
+// Keys like "qx:0000123456:profile:settings", longer than the small string
+// buffer so that each lives in its own heap block.
+std::vector<std::string> make_strings(const std::size_t n) {
+  sml::random::xoshiro256ss rand(1);
+  std::vector<std::string> seq(n);
+  char buf[64];
+  for (std::size_t i = 0; i < n; ++i) {
+    std::sprintf(buf, "%c%c:%010lu:profile:settings",
+                 'a' + int(sml::random::bounded_rand(rand, 26)),
+                 'a' + int(sml::random::bounded_rand(rand, 26)),
+                 static_cast<unsigned long>(sml::random::bounded_rand(rand, n)));
+    seq[i] = buf;
+  }
+  return seq;
+}
+
+result measure_strings(const std::vector<std::string>& strings) {
+  result res;
+  std::vector<std::string> seq(strings);
+
+  bench::timer timer;
+  sml::sort(seq.begin(), seq.end());
+  res.sort = timer.seconds();
+
+  res.found = 0;
+  timer.reset();
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    res.found += sml::algorithm::binary_search(
+      seq.begin(), seq.end(), strings[i]
+    ) != seq.end();
+  }
+  res.search = timer.seconds();
+  return res;
+}
+
+template<class Key>
+result measure_keys(const std::vector<std::string>& strings) {
+  result res;
+
+  bench::timer timer;
+  std::vector<Key> seq;
+  seq.reserve(strings.size());
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    seq.push_back(Key(strings[i]));
+  }
+  sml::sort(seq.begin(), seq.end());
+  res.sort = timer.seconds();
+
+  res.found = 0;
+  timer.reset();
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    res.found += sml::algorithm::binary_search(
+      seq.begin(), seq.end(), Key(strings[i])
+    ) != seq.end();
+  }
+  res.search = timer.seconds();
+  return res;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t n = argc > 1 ? std::atol(argv[1]) : std::size_t(1) << 20;
+  const std::vector<std::string> strings = make_strings(n);
+
+  const result direct = measure_strings(strings);
+  const result key8   = measure_keys< sml::utility::prefix_key<8> >(strings);
+  const result key16  = measure_keys< sml::utility::prefix_key<16> >(strings);
+
+  std::printf("%10s %12s %12s %12s   (s, %lu strings)\n",
+              "", "string", "prefix 8", "prefix 16",
+              static_cast<unsigned long>(n));
+  std::printf("%10s %12.3f %12.3f %12.3f\n",
+              "sort", direct.sort, key8.sort, key16.sort);
+  std::printf("%10s %12.3f %12.3f %12.3f\n",
+              "search", direct.search, key8.search, key16.search);
+  std::printf("found %lu\n",
+              static_cast<unsigned long>(direct.found + key8.found + key16.found));
+  return 0;
+}
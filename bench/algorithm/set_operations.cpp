@@ -0,0 +1,80 @@
+// Intersection of sorted id lists of similar and of very different
+// lengths: sml::algorithm::set_intersection against std::set_intersection.
+//
+//   g++ -O2 -I. bench/algorithm/set_operations.cpp -o set_operations
+//   ./set_operations [length of the long list, default 1 << 22]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/set_operations.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+typedef sml::ext::uint32_t id_type;
+
+std::vector<id_type> make_list(
+  sml::random::xoshiro256ss& rand,
+  const std::size_t          n,
+  const id_type              universe
+) {
+  std::vector<id_type> ids(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ids[i] = static_cast<id_type>(sml::random::bounded_rand(rand, universe));
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t n = argc > 1 ? std::atol(argv[1]) : std::size_t(1) << 22;
+
+  sml::random::xoshiro256ss rand(1);
+  const std::vector<id_type> large = make_list(rand, n, 4 * n);
+
+  std::printf("%12s %12s %12s %12s %12s   (ms)\n",
+              "short", "matches", "std", "sml", "sml count");
+
+  for (std::size_t m = n; m >= 16; m /= 16) {
+    const std::vector<id_type> small = make_list(rand, m, 4 * n);
+    const id_type* const a = &large[0];
+    const id_type* const b = &small[0];
+
+    std::vector<id_type> res;
+    res.reserve(small.size());
+
+    bench::timer timer;
+    std::set_intersection(a, a + large.size(), b, b + small.size(),
+                          std::back_inserter(res));
+    const double std_ms = timer.seconds() * 1e3;
+    const std::size_t matches = res.size();
+
+    res.clear();
+    timer.reset();
+    sml::algorithm::set_intersection(a, a + large.size(), b, b + small.size(),
+                                     std::back_inserter(res));
+    const double sml_ms = timer.seconds() * 1e3;
+
+    timer.reset();
+    const std::size_t count = sml::algorithm::set_intersection_size(
+      a, a + large.size(), b, b + small.size()
+    );
+    const double count_ms = timer.seconds() * 1e3;
+
+    std::printf("%12lu %12lu %12.2f %12.2f %12.2f%s\n",
+                static_cast<unsigned long>(small.size()),
+                static_cast<unsigned long>(matches),
+                std_ms, sml_ms, count_ms,
+                res.size() == matches && count == matches ? "" : "  MISMATCH");
+  }
+  return 0;
+}
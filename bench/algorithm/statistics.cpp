@@ -0,0 +1,50 @@
+// Statistics of a large column: separate passes (min_max, then sum, then
+// variance) against the fused single pass, sequential and parallel.
+//
+//   g++ -O2 -I. bench/algorithm/statistics.cpp -o statistics -lpthread
+//   ./statistics [elements, default 1 << 26]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/algorithm/min_max.hpp"
+#include "sml/algorithm/statistics.hpp"
+#include "sml/parallel/statistics.hpp"
+
+int main(int argc, char** argv) {
+  const std::size_t n = argc > 1 ? std::atol(argv[1]) : std::size_t(1) << 26;
+
+  std::vector<double> seq(n);
+  for (std::size_t i = 0; i < n; ++i) seq[i] = double(i % 1000) * 0.5;
+  const double* const b = &seq[0];
+  const double* const e = b + n;
+
+  bench::timer timer;
+  const std::pair<const double*, const double*> mm =
+    sml::algorithm::min_max(b, e);
+  double sum = 0.0;
+  for (const double* it = b; it != e; ++it) sum += *it;
+  const double mean = sum / double(n);
+  double m2 = 0.0;
+  for (const double* it = b; it != e; ++it) m2 += (*it - mean) * (*it - mean);
+  const double passes = timer.seconds();
+
+  timer.reset();
+  const sml::algorithm::statistics<> fused = sml::algorithm::summarize(b, e);
+  const double single = timer.seconds();
+
+  timer.reset();
+  const sml::algorithm::statistics<> parallel = sml::parallel::summarize(b, e);
+  const double threaded = timer.seconds();
+
+  const double gb = double(n * sizeof(double)) * 1e-9;
+  std::printf("%-10s %8.2f GB/s  variance %.6f\n",
+              "passes", gb / passes, m2 / double(n));
+  std::printf("%-10s %8.2f GB/s  variance %.6f\n",
+              "fused", gb / single, fused.variance());
+  std::printf("%-10s %8.2f GB/s  variance %.6f\n",
+              "parallel", gb / threaded, parallel.variance());
+  std::printf("checksum %f\n", *mm.first + *mm.second);
+  return 0;
+}
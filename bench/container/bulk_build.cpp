@@ -0,0 +1,83 @@
+// Building an integer-keyed chain_hash_map from a vector of pairs: one
+// insert at a time, the range constructor (one growth up front), and
+// bulk_insert on 1 to 8 threads.
+//
+//   g++ -O2 -I. bench/container/bulk_build.cpp -o bulk_build -lpthread
+//   ./bulk_build [log2 of the size, default 22]
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/container/chain_hash_map.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+typedef sml::ext::uint64_t key_type;
+
+struct identity_hash {
+  std::size_t operator()(const key_type x) const {
+    return static_cast<std::size_t>(x);
+  }
+};
+
+typedef
+  sml::container::chain_hash_map<
+    key_type, key_type, identity_hash, std::equal_to<key_type>,
+    std::allocator< std::pair<const key_type, key_type> >,
+    sml::container::power_of_two_bucket_policy
+  >
+  map_type;
+
+typedef std::vector< std::pair<key_type, key_type> > input_type;
+
+// nanoseconds per element
+double per_element(bench::timer& timer, const input_type& input) {
+  return timer.seconds() * 1e9 / input.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int log2 = argc > 1 ? std::atoi(argv[1]) : 22;
+
+  sml::random::xoshiro256ss rand(42);
+  input_type input(std::size_t(1) << log2);
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    input[i] = std::make_pair(rand(), i);
+  }
+
+  std::size_t sink = 0;
+  std::printf("%-16s %10s   (ns/element, %lu elements)\n",
+    "build", "time", static_cast<unsigned long>(input.size()));
+
+  {
+    bench::timer timer;
+    map_type m;
+    for (std::size_t i = 0; i < input.size(); ++i) m.insert(input[i]);
+    std::printf("%-16s %10.1f\n", "insert loop", per_element(timer, input));
+    sink += m.size();
+  }
+  {
+    bench::timer timer;
+    map_type m(input.begin(), input.end());
+    std::printf("%-16s %10.1f\n", "range ctor", per_element(timer, input));
+    sink += m.size();
+  }
+  for (unsigned threads = 1; threads <= 8; threads *= 2) {
+    bench::timer timer;
+    map_type m;
+    m.bulk_insert(input.begin(), input.end(), threads);
+    char label[32];
+    std::sprintf(label, "bulk, %u thr", threads);
+    std::printf("%-16s %10.1f\n", label, per_element(timer, input));
+    sink += m.size();
+  }
+
+  return sink == 0;
+}
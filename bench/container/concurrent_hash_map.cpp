@@ -0,0 +1,135 @@
+// Lookup-heavy traffic (one insert or erase per nine finds) from 1 to 32
+// threads: concurrent_hash_map and epoch_hash_map against chain_hash_map
+// behind one mutex.
+//
+//   g++ -O2 -I. bench/container/concurrent_hash_map.cpp -o concurrent_hash_map -lpthread
+//   ./concurrent_hash_map
+
+#include <cstdio>
+#include <utility>
+#include <pthread.h>
+#include "bench/timer.hpp"
+#include "sml/container/chain_hash_map.hpp"
+#include "sml/container/concurrent_hash_map.hpp"
+#include "sml/container/epoch_hash_map.hpp"
+#include "sml/parallel/parallel_for.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+typedef unsigned long key_type;
+
+struct identity_hash {
+  std::size_t operator()(const key_type x) const {
+    return static_cast<std::size_t>(x);
+  }
+};
+
+const key_type    KEYS = 1 << 20;
+const std::size_t OPS  = 1 << 22;
+const std::size_t TASKS = 64;
+
+class locked_map {
+public:
+  locked_map() { pthread_mutex_init(&this->mutex_, 0); }
+  ~locked_map() { pthread_mutex_destroy(&this->mutex_); }
+
+  void insert(const key_type k) {
+    pthread_mutex_lock(&this->mutex_);
+    this->map_.insert(std::make_pair(k, k));
+    pthread_mutex_unlock(&this->mutex_);
+  }
+
+  void erase(const key_type k) {
+    pthread_mutex_lock(&this->mutex_);
+    this->map_.erase(k);
+    pthread_mutex_unlock(&this->mutex_);
+  }
+
+  bool find(const key_type k, key_type& v) {
+    pthread_mutex_lock(&this->mutex_);
+    const sml::container::chain_hash_map<
+      key_type, key_type, identity_hash
+    >::const_iterator pos = this->map_.find(k);
+    const bool found = pos != this->map_.end();
+    if (found) v = pos->second;
+    pthread_mutex_unlock(&this->mutex_);
+    return found;
+  }
+
+private:
+  pthread_mutex_t mutex_;
+  sml::container::chain_hash_map<key_type, key_type, identity_hash> map_;
+};
+
+class striped_map {
+public:
+  void insert(const key_type k) { this->map_.insert(std::make_pair(k, k)); }
+  void erase(const key_type k)  { this->map_.erase(k); }
+  bool find(const key_type k, key_type& v) { return this->map_.find(k, v); }
+
+private:
+  sml::container::concurrent_hash_map<key_type, key_type, identity_hash> map_;
+};
+
+class epoch_map {
+public:
+  void insert(const key_type k) { this->map_.insert(std::make_pair(k, k)); }
+  void erase(const key_type k)  { this->map_.erase(k); }
+  bool find(const key_type k, key_type& v) { return this->map_.find(k, v); }
+
+private:
+  sml::container::epoch_hash_map<key_type, key_type, identity_hash> map_;
+};
+
+template<class Map>
+struct traffic {
+  explicit traffic(Map& m) : map(&m), sink(0) {}
+
+  void operator()(const std::size_t task) {
+    sml::random::xoshiro256ss rand(task + 1);
+    key_type found = 0;
+    for (std::size_t i = 0; i < OPS / TASKS; ++i) {
+      const key_type k = sml::random::bounded_rand(rand, KEYS);
+      const std::size_t op = i % 10;
+      key_type v;
+      if (op == 0)      this->map->insert(k);
+      else if (op == 5) this->map->erase(k);
+      else if (this->map->find(k, v)) found += v;
+    }
+    __sync_fetch_and_add(&this->sink, found);
+  }
+
+  Map*     map;
+  key_type sink;
+};
+
+template<class Map>
+double run(const unsigned threads) {
+  Map m;
+  for (key_type k = 0; k < KEYS; k += 2) m.insert(k);
+
+  traffic<Map> t(m);
+  bench::timer timer;
+  sml::parallel::parallel_for(TASKS, threads, t);
+  return OPS / timer.seconds() * 1e-6;
+}
+
+} // namespace
+
+int main() {
+  std::printf(
+    "%8s %14s %14s %14s   (Mops/s)\n",
+    "threads", "mutex+chain", "concurrent", "epoch"
+  );
+  for (unsigned threads = 1; threads <= 32; threads *= 2) {
+    const double locked  = run<locked_map>(threads);
+    const double striped = run<striped_map>(threads);
+    const double epoch   = run<epoch_map>(threads);
+    std::printf(
+      "%8u %14.2f %14.2f %14.2f\n", threads, locked, striped, epoch
+    );
+  }
+  return 0;
+}
@@ -0,0 +1,128 @@
+// Random hits and misses on integer-keyed hash maps from cache-sized to
+// DRAM-sized: chain_hash_map with each bucket policy against flat_hash_map.
+//
+//   g++ -O2 -I. bench/container/hash_map.cpp -o hash_map
+//   ./hash_map [log2 of the largest size, default 22]
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "bench/timer.hpp"
+#include "sml/container/chain_hash_map.hpp"
+#include "sml/container/flat_hash_map.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+typedef sml::ext::uint64_t key_type;
+
+struct identity_hash {
+  std::size_t operator()(const key_type x) const {
+    return static_cast<std::size_t>(x);
+  }
+};
+
+struct result {
+  double build;
+  double hit;
+  double miss;
+};
+
+// nanoseconds per operation
+template<class Map>
+result measure(
+  const std::vector<key_type>& keys,
+  const std::vector<key_type>& hits,
+  const std::vector<key_type>& misses,
+  std::size_t&                 sink
+) {
+  result res;
+
+  bench::timer timer;
+  Map m;
+  for (std::size_t i = 0; i < keys.size(); ++i) m[keys[i]] = i;
+  res.build = timer.seconds() * 1e9 / keys.size();
+
+  timer.reset();
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    sink += m.find(hits[i])->second;
+  }
+  res.hit = timer.seconds() * 1e9 / hits.size();
+
+  timer.reset();
+  for (std::size_t i = 0; i < misses.size(); ++i) {
+    sink += m.count(misses[i]);
+  }
+  res.miss = timer.seconds() * 1e9 / misses.size();
+
+  return res;
+}
+
+void report(const char* name, const std::size_t n, const result& r) {
+  std::printf("%10lu %-12s %8.1f %8.1f %8.1f\n",
+              static_cast<unsigned long>(n), name, r.build, r.hit, r.miss);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  typedef std::equal_to<key_type> equal;
+  typedef std::allocator< std::pair<const key_type, std::size_t> > alloc;
+
+  typedef
+    sml::container::chain_hash_map<key_type, std::size_t, identity_hash>
+    modulo_map;
+  typedef
+    sml::container::chain_hash_map<
+      key_type, std::size_t, identity_hash, equal, alloc,
+      sml::container::power_of_two_bucket_policy
+    >
+    power_of_two_map;
+  typedef
+    sml::container::chain_hash_map<
+      key_type, std::size_t, identity_hash, equal, alloc,
+      sml::container::fastrange_bucket_policy
+    >
+    fastrange_map;
+  typedef
+    sml::container::flat_hash_map<key_type, std::size_t, identity_hash>
+    flat_map;
+
+  const int max_log = argc > 1 ? std::atoi(argv[1]) : 22;
+  const std::size_t lookups = std::size_t(1) << 22;
+
+  sml::random::xoshiro256ss rand(1);
+  std::size_t sink = 0;
+
+  std::printf("%10s %-12s %8s %8s %8s   (ns/op)\n",
+              "size", "map", "build", "hit", "miss");
+
+  for (int lg = 10; lg <= max_log; lg += 2) {
+    const std::size_t n = std::size_t(1) << lg;
+
+    // odd keys are present, even keys are misses
+    std::vector<key_type> keys(n), hits(lookups), misses(lookups);
+    for (std::size_t i = 0; i < n; ++i) keys[i] = rand() | 1;
+    for (std::size_t i = 0; i < lookups; ++i) {
+      hits[i]   = keys[sml::random::bounded_rand(rand, n)];
+      misses[i] = rand() & ~key_type(1);
+    }
+
+    report("chain/mod", n,
+           measure<modulo_map>(keys, hits, misses, sink));
+    report("chain/pow2", n,
+           measure<power_of_two_map>(keys, hits, misses, sink));
+    report("chain/fast", n,
+           measure<fastrange_map>(keys, hits, misses, sink));
+    report("flat", n,
+           measure<flat_map>(keys, hits, misses, sink));
+  }
+
+  std::printf("checksum %lu\n", static_cast<unsigned long>(sink));
+  return 0;
+}
@@ -0,0 +1,59 @@
+// Worst single insert against total insert time for chain_hash_map, with
+// growth rehashing everything at once and incrementally.
+//
+//   g++ -O2 -I. bench/container/rehash_latency.cpp -o rehash_latency
+//   ./rehash_latency [log2 of the number of inserts, default 23]
+
+#include <cstdio>
+#include <cstdlib>
+#include "bench/timer.hpp"
+#include "sml/container/chain_hash_map.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+typedef sml::ext::uint64_t key_type;
+
+struct identity_hash {
+  std::size_t operator()(const key_type x) const {
+    return static_cast<std::size_t>(x);
+  }
+};
+
+typedef
+  sml::container::chain_hash_map<key_type, key_type, identity_hash>
+  map_type;
+
+void run(const std::size_t n, const std::size_t step) {
+  sml::random::xoshiro256ss rand(1);
+  map_type m;
+  m.rehash_step(step);
+
+  double worst = 0;
+  bench::timer total;
+  bench::timer one;
+  for (std::size_t i = 0; i < n; ++i) {
+    const key_type key = rand();
+    one.reset();
+    m[key] = i;
+    const double t = one.seconds();
+    if (t > worst) worst = t;
+  }
+
+  std::printf("step %4lu: total %7.3f s, worst insert %9.3f ms\n",
+              static_cast<unsigned long>(step), total.seconds(), worst * 1e3);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int lg = argc > 1 ? std::atoi(argv[1]) : 23;
+  const std::size_t n = std::size_t(1) << lg;
+
+  run(n, 0);
+  run(n, 1);
+  run(n, 4);
+  run(n, 16);
+  return 0;
+}
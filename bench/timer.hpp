@@ -0,0 +1,32 @@
+#ifndef _SML_BENCH_TIMER_HPP
+#define _SML_BENCH_TIMER_HPP
+
+#include <time.h>
+
+namespace bench {
+
+class timer {
+public:
+  timer() {
+    this->reset();
+  }
+
+  void reset() {
+    clock_gettime(CLOCK_MONOTONIC, &this->start_);
+  }
+
+  double seconds() const {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return
+      static_cast<double>(now.tv_sec - this->start_.tv_sec) +
+      static_cast<double>(now.tv_nsec - this->start_.tv_nsec) * 1e-9;
+  }
+
+private:
+  struct timespec start_;
+};
+
+} // namespace bench
+
+#endif
@@ -2,7 +2,7 @@
 #define _SML_ALGORITHM_BINARY_SEARCH_HPP
 
 #include <iterator>
-#include "sml/ext/functional.hpp"
+#include "sml/algorithm/branchless_search.hpp"
 #include "sml/op/comparator.hpp"
 
 namespace sml { namespace algorithm {
@@ -14,33 +14,10 @@ Iterator binary_search(
   const T&       v,
   Comparator     cmp
 ) {
-  typedef typename std::iterator_traits<Iterator> traits_type;
-  typedef typename traits_type::difference_type difference_type;
-  typedef typename traits_type::value_type      value_type;
-  typedef
-    typename sml::ext::result_of<Comparator(T, value_type)>::type
-    result_type;
+  const Iterator pos =
+    sml::algorithm::branchless_lower_bound(begin, end, v, cmp);
 
-  const difference_type n = end - begin;
-  if (n == 0) return end;
-
-  difference_type last  = n-1;
-  difference_type first = 0;
-
-  while (first <= last) {
-    const difference_type medium = first + (last - first) / 2;
-    const Iterator m = begin + medium;
-    const result_type result = cmp(v, *m);
-
-    if (result < 0)
-      last = medium - 1;
-    else if (result > 0)
-      first = medium + 1;
-    else
-      return m;
-  }
-
-  return end;
+  return pos != end && cmp(v, *pos) == 0 ? pos : end;
 }
 
 template<class Iterator, class T>
@@ -0,0 +1,158 @@
+#ifndef _SML_ALGORITHM_BINARY_SEARCH_BATCH_HPP
+#define _SML_ALGORITHM_BINARY_SEARCH_BATCH_HPP
+
+#include <iterator>
+#include "sml/algorithm/bounds.hpp"
+#include "sml/algorithm/branchless_search.hpp"
+#include "sml/op/comparator.hpp"
+
+namespace sml { namespace algorithm { namespace detail {
+
+enum { _BATCH_GROUP = 16 };
+
+template<class Iterator, class T, class Comparator>
+Iterator _batch_result(
+  const Iterator pos,
+  const Iterator end,
+  const T&       v,
+  Comparator&    cmp
+) {
+  return pos != end && cmp(v, *pos) == 0 ? pos : end;
+}
+
+// Every search over a range of the same length halves it by the same
+// amounts, so a group of searches can advance one level at a time.  Each
+// search prefetches its next probe and then waits for the rest of the
+// group, which keeps up to _BATCH_GROUP cache misses in flight.
+template<class Iterator, class KeyIterator, class OutputIterator, class Comparator>
+OutputIterator _binary_search_group(
+  const Iterator       begin,
+  const Iterator       end,
+  const KeyIterator*   keys,
+  const int            count,
+  OutputIterator       out,
+  Comparator&          cmp
+) {
+  typedef
+    typename std::iterator_traits<Iterator>::difference_type
+    difference_type;
+
+  const sml::algorithm::detail::_lower_bound_probe probe;
+
+  difference_type n = end - begin;
+  if (n == 0) {
+    for (int g = 0; g < count; ++g) *out++ = end;
+    return out;
+  }
+
+  Iterator base[_BATCH_GROUP];
+  for (int g = 0; g < count; ++g) base[g] = begin;
+
+  while (n > 1) {
+    const difference_type half = n / 2;
+    const difference_type next = (n - half) / 2;
+
+    for (int g = 0; g < count; ++g) {
+      base[g] += static_cast<difference_type>(
+        probe(cmp, *keys[g], *(base[g] + half))
+      ) * half;
+      _prefetch(base[g] + next);
+    }
+    n -= half;
+  }
+
+  for (int g = 0; g < count; ++g) {
+    const Iterator pos =
+      base[g] + static_cast<difference_type>(probe(cmp, *keys[g], *base[g]));
+    *out++ = _batch_result(pos, end, *keys[g], cmp);
+  }
+  return out;
+}
+
+// Sorted keys only ever move forward, so each search gallops from the
+// previous answer.
+template<class Iterator, class KeyIterator, class OutputIterator, class Comparator>
+OutputIterator _binary_search_sorted(
+  const Iterator begin,
+  const Iterator end,
+  KeyIterator    keys_first,
+  KeyIterator    keys_last,
+  OutputIterator out,
+  Comparator&    cmp
+) {
+  Iterator pos = begin;
+  for (; keys_first != keys_last; ++keys_first) {
+    pos = sml::algorithm::gallop_lower_bound(pos, end, pos, *keys_first, cmp);
+    *out++ = _batch_result(pos, end, *keys_first, cmp);
+  }
+  return out;
+}
+
+template<class KeyIterator, class Comparator>
+bool _keys_sorted(KeyIterator first, const KeyIterator last, Comparator& cmp) {
+  if (first == last) return true;
+
+  for (KeyIterator next = first; ++next != last; first = next) {
+    if (cmp(*next, *first) < 0) return false;
+  }
+  return true;
+}
+
+} // namespace detail
+
+// Looks up every key of [keys_first, keys_last) in the sorted range
+// [begin, end) and writes, per key, the position of an equal element or
+// end.  Keys must be a forward range; sorted keys are detected and
+// searched by galloping, others in interleaved groups.
+template<
+  class Iterator, class KeyIterator, class OutputIterator, class Comparator
+>
+OutputIterator binary_search_batch(
+  const Iterator    begin,
+  const Iterator    end,
+  const KeyIterator keys_first,
+  const KeyIterator keys_last,
+  OutputIterator    out,
+  Comparator        cmp
+) {
+  if (sml::algorithm::detail::_keys_sorted(keys_first, keys_last, cmp)) {
+    return sml::algorithm::detail::_binary_search_sorted(
+      begin, end, keys_first, keys_last, out, cmp
+    );
+  }
+
+  KeyIterator keys[sml::algorithm::detail::_BATCH_GROUP];
+  int count = 0;
+
+  for (KeyIterator it = keys_first; it != keys_last; ++it) {
+    keys[count++] = it;
+
+    if (count == sml::algorithm::detail::_BATCH_GROUP) {
+      out = sml::algorithm::detail::_binary_search_group(
+        begin, end, keys, count, out, cmp
+      );
+      count = 0;
+    }
+  }
+
+  return sml::algorithm::detail::_binary_search_group(
+    begin, end, keys, count, out, cmp
+  );
+}
+
+template<class Iterator, class KeyIterator, class OutputIterator>
+OutputIterator binary_search_batch(
+  const Iterator    begin,
+  const Iterator    end,
+  const KeyIterator keys_first,
+  const KeyIterator keys_last,
+  OutputIterator    out
+) {
+  return sml::algorithm::binary_search_batch(
+    begin, end, keys_first, keys_last, out, sml::op::comparator()
+  );
+}
+
+}} // namespace sml::algorithm
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef _SML_ALGORITHM_BOUNDS_HPP
+#define _SML_ALGORITHM_BOUNDS_HPP
+
+#include <iterator>
+#include <utility>
+#include "sml/algorithm/branchless_search.hpp"
+#include "sml/op/comparator.hpp"
+
+namespace sml { namespace algorithm { namespace detail {
+
+// Both bounds take the same halving steps until a probe lands on an
+// element equal to v; from there the lower bound lies in the left part
+// and the upper bound in the right part, and each is finished alone.
+template<class Iterator, class T, class Comparator>
+std::pair<Iterator, Iterator> _equal_range(
+  const Iterator begin,
+  const Iterator end,
+  const T&       v,
+  Comparator     cmp
+) {
+  typedef
+    typename std::iterator_traits<Iterator>::difference_type
+    difference_type;
+
+  const sml::algorithm::detail::_lower_bound_probe lower;
+  const sml::algorithm::detail::_upper_bound_probe upper;
+
+  difference_type n = end - begin;
+  if (n == 0) return std::make_pair(end, end);
+
+  Iterator base = begin;
+  while (n > 1) {
+    const difference_type half = n / 2;
+    const Iterator        mid  = base + half;
+
+    const bool below = lower(cmp, v, *mid);
+    if (below != upper(cmp, v, *mid)) {
+      return std::make_pair(
+        _branchless_bound(base, mid, v, cmp, lower),
+        _branchless_bound(mid, base + n, v, cmp, upper)
+      );
+    }
+
+    base += static_cast<difference_type>(below) * half;
+    n    -= half;
+  }
+
+  return std::make_pair(
+    base + static_cast<difference_type>(lower(cmp, v, *base)),
+    base + static_cast<difference_type>(upper(cmp, v, *base))
+  );
+}
+
+// Doubles the distance from the hint until it brackets the answer, then
+// searches the bracket, so a hint d elements off costs O(log d).
+template<class Iterator, class T, class Comparator, class RightOf>
+Iterator _gallop_bound(
+  const Iterator begin,
+  const Iterator end,
+  const Iterator hint,
+  const T&       v,
+  Comparator     cmp,
+  RightOf        right_of
+) {
+  typedef
+    typename std::iterator_traits<Iterator>::difference_type
+    difference_type;
+
+  if (hint != end && right_of(cmp, v, *hint)) {
+    const difference_type left = end - hint - 1;
+
+    difference_type step = 1;
+    while (step <= left && right_of(cmp, v, *(hint + step))) step *= 2;
+
+    return _branchless_bound(
+      hint + (step / 2 + 1), hint + (step <= left ? step : left + 1),
+      v, cmp, right_of
+    );
+  }
+
+  const difference_type left = hint - begin;
+
+  difference_type step = 1;
+  while (step <= left && !right_of(cmp, v, *(hint - step))) step *= 2;
+
+  return _branchless_bound(
+    hint - (step <= left ? step - 1 : left), hint - (step / 2),
+    v, cmp, right_of
+  );
+}
+
+} // namespace detail
+
+// First position whose element is not less than v.
+template<class Iterator, class T, class Comparator>
+Iterator lower_bound(
+  const Iterator begin,
+  const Iterator end,
+  const T&       v,
+  Comparator     cmp
+) {
+  return sml::algorithm::branchless_lower_bound(begin, end, v, cmp);
+}
+
+template<class Iterator, class T>
+Iterator lower_bound(const Iterator begin, const Iterator end, const T& v) {
+  return sml::algorithm::lower_bound(begin, end, v, sml::op::comparator());
+}
+
+// First position whose element is greater than v.
+template<class Iterator, class T, class Comparator>
+Iterator upper_bound(
+  const Iterator begin,
+  const Iterator end,
+  const T&       v,
+  Comparator     cmp
+) {
+  return sml::algorithm::branchless_upper_bound(begin, end, v, cmp);
+}
+
+template<class Iterator, class T>
+Iterator upper_bound(const Iterator begin, const Iterator end, const T& v) {
+  return sml::algorithm::upper_bound(begin, end, v, sml::op::comparator());
+}
+
+// The run of elements equal to v, as (lower_bound, upper_bound).
+template<class Iterator, class T, class Comparator>
+std::pair<Iterator, Iterator> equal_range(
+  const Iterator begin,
+  const Iterator end,
+  const T&       v,
+  Comparator     cmp
+) {
+  return sml::algorithm::detail::_equal_range(begin, end, v, cmp);
+}
+
+template<class Iterator, class T>
+std::pair<Iterator, Iterator> equal_range(
+  const Iterator begin,
+  const Iterator end,
+  const T&       v
+) {
+  return sml::algorithm::equal_range(begin, end, v, sml::op::comparator());
+}
+
+// lower_bound for when the answer is expected near `hint`, for example
+// the answer for the previous of a sequence of sorted keys.
+template<class Iterator, class T, class Comparator>
+Iterator gallop_lower_bound(
+  const Iterator begin,
+  const Iterator end,
+  const Iterator hint,
+  const T&       v,
+  Comparator     cmp
+) {
+  return sml::algorithm::detail::_gallop_bound(
+    begin, end, hint, v, cmp, sml::algorithm::detail::_lower_bound_probe()
+  );
+}
+
+template<class Iterator, class T>
+Iterator gallop_lower_bound(
+  const Iterator begin,
+  const Iterator end,
+  const Iterator hint,
+  const T&       v
+) {
+  return sml::algorithm::gallop_lower_bound(
+    begin, end, hint, v, sml::op::comparator()
+  );
+}
+
+// upper_bound for when the answer is expected near `hint`.
+template<class Iterator, class T, class Comparator>
+Iterator gallop_upper_bound(
+  const Iterator begin,
+  const Iterator end,
+  const Iterator hint,
+  const T&       v,
+  Comparator     cmp
+) {
+  return sml::algorithm::detail::_gallop_bound(
+    begin, end, hint, v, cmp, sml::algorithm::detail::_upper_bound_probe()
+  );
+}
+
+template<class Iterator, class T>
+Iterator gallop_upper_bound(
+  const Iterator begin,
+  const Iterator end,
+  const Iterator hint,
+  const T&       v
+) {
+  return sml::algorithm::gallop_upper_bound(
+    begin, end, hint, v, sml::op::comparator()
+  );
+}
+
+}} // namespace sml::algorithm
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef _SML_ALGORITHM_EYTZINGER_INDEX_HPP
+#define _SML_ALGORITHM_EYTZINGER_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "sml/op/lesser.hpp"
+
+namespace sml { namespace algorithm {
+
+// Read-only search index over a sorted range, stored in BFS (Eytzinger)
+// order: the node at slot k has its children at 2k and 2k+1, so the top
+// levels of every search share a few cache lines, and the 16 or so
+// descendants four levels down sit in one line that can be prefetched.
+// Results are positions in the original sorted range; size() means
+// "not found".
+template<class T, class Lesser = sml::op::lesser>
+class eytzinger_index {
+public:
+  typedef T           value_type;
+  typedef Lesser      key_compare;
+  typedef std::size_t size_type;
+
+  explicit eytzinger_index(Lesser const& lesser = Lesser()) :
+    storage_(1 + BLOCK),
+    position_(1),
+    lesser_(lesser) {
+  }
+
+  template<class Iterator>
+  eytzinger_index(
+    Iterator      const  first,
+    Iterator      const  last,
+    Lesser        const& lesser = Lesser()
+  ) :
+    storage_(),
+    position_(),
+    lesser_(lesser) {
+    this->assign(first, last);
+  }
+
+  eytzinger_index(eytzinger_index const& other) :
+    storage_(other.storage_.size()),
+    position_(other.position_),
+    lesser_(other.lesser_) {
+    this->copy_tree(other);
+  }
+
+  eytzinger_index& operator=(eytzinger_index const& other) {
+    if (this != &other) {
+      this->storage_.assign(other.storage_.size(), value_type());
+      this->position_ = other.position_;
+      this->lesser_   = other.lesser_;
+      this->copy_tree(other);
+    }
+    return *this;
+  }
+
+  template<class Iterator>
+  void assign(Iterator const first, Iterator const last) {
+    std::vector<value_type> const sorted(first, last);
+
+    this->storage_.assign(sorted.size() + 1 + BLOCK, value_type());
+    this->position_.assign(sorted.size() + 1, sorted.size());
+
+    size_type next = 0;
+    this->fill(sorted, 1, next);
+  }
+
+  size_type size()  const { return this->position_.size() - 1; }
+  bool      empty() const { return this->size() == 0; }
+
+  key_compare key_comp() const { return this->lesser_; }
+
+  // Position of the first element not less than v.
+  size_type lower_bound(value_type const& v) const {
+    return this->position_[this->lower_slot(v)];
+  }
+
+  // Position of the first element greater than v.
+  size_type upper_bound(value_type const& v) const {
+    return this->position_[this->upper_slot(v)];
+  }
+
+  // Position of the first element equivalent to v.
+  size_type find(value_type const& v) const {
+    size_type const slot = this->lower_slot(v);
+    return
+      slot != 0 && !this->lesser_(v, this->tree()[slot]) ?
+      this->position_[slot] : this->size();
+  }
+
+  size_type count(value_type const& v) const {
+    std::pair<size_type, size_type> const range = this->equal_range(v);
+    return range.second - range.first;
+  }
+
+  std::pair<size_type, size_type> equal_range(value_type const& v) const {
+    return std::make_pair(this->lower_bound(v), this->upper_bound(v));
+  }
+
+  // Element at position `pos` of the original sorted range.
+  value_type const& at(size_type const pos) const {
+    if (pos >= this->size()) {
+      throw std::out_of_range("out of range at eytzinger_index#at");
+    }
+    return this->tree()[this->slot_of(pos)];
+  }
+
+private:
+  enum { BLOCK = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1 };
+
+  void fill(
+    std::vector<value_type> const& sorted,
+    size_type               const  slot,
+    size_type&                     next
+  ) {
+    if (slot >= this->position_.size()) return;
+
+    this->fill(sorted, 2 * slot, next);
+    this->tree()[slot]    = sorted[next];
+    this->position_[slot] = next++;
+    this->fill(sorted, 2 * slot + 1, next);
+  }
+
+  void prefetch(size_type const slot) const {
+#ifdef __GNUC__
+    size_type const ahead = slot * BLOCK;
+    __builtin_prefetch(this->tree() + (ahead <= this->size() ? ahead : 0));
+#else
+    (void)slot;
+#endif
+  }
+
+  // Descends to a leaf, then undoes the trailing right turns: the slot
+  // left is the last one where the search turned left, or 0.
+  static size_type resolve(size_type slot) {
+#ifdef __GNUC__
+    return slot >> (__builtin_ctzl(~static_cast<unsigned long>(slot)) + 1);
+#else
+    while (slot & 1) slot >>= 1;
+    return slot >> 1;
+#endif
+  }
+
+  size_type lower_slot(value_type const& v) const {
+    value_type const* const tree = this->tree();
+    size_type const n = this->size();
+
+    size_type slot = 1;
+    while (slot <= n) {
+      this->prefetch(slot);
+      slot = 2 * slot + static_cast<size_type>(this->lesser_(tree[slot], v));
+    }
+    return eytzinger_index::resolve(slot);
+  }
+
+  size_type upper_slot(value_type const& v) const {
+    value_type const* const tree = this->tree();
+    size_type const n = this->size();
+
+    size_type slot = 1;
+    while (slot <= n) {
+      this->prefetch(slot);
+      slot = 2 * slot + static_cast<size_type>(!this->lesser_(v, tree[slot]));
+    }
+    return eytzinger_index::resolve(slot);
+  }
+
+  size_type slot_of(size_type const pos) const {
+    size_type slot = 1;
+    while (this->position_[slot] != pos) {
+      slot = 2 * slot + (this->position_[slot] < pos ? 1 : 0);
+    }
+    return slot;
+  }
+
+  // Slot 0 starts at the first cache line boundary inside storage_, so the
+  // BLOCK slots from BLOCK*k on share one line; copies lay the tree out
+  // again for the same reason.
+  value_type const* tree() const {
+    std::size_t const misalign =
+      reinterpret_cast<std::size_t>(&this->storage_[0]) % 64 / sizeof(T);
+    return &this->storage_[0] + (misalign ? BLOCK - misalign : 0);
+  }
+
+  value_type* tree() {
+    return const_cast<value_type*>(
+      static_cast<eytzinger_index const*>(this)->tree()
+    );
+  }
+
+  void copy_tree(eytzinger_index const& other) {
+    std::copy(
+      other.tree(), other.tree() + other.position_.size(), this->tree()
+    );
+  }
+
+  std::vector<value_type> storage_;
+  std::vector<size_type>  position_;
+  Lesser                  lesser_;
+};
+
+}} // namespace sml::algorithm
+
+#endif
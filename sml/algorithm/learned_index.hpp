@@ -0,0 +1,263 @@
+#ifndef _SML_ALGORITHM_LEARNED_INDEX_HPP
+#define _SML_ALGORITHM_LEARNED_INDEX_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sml/algorithm/branchless_search.hpp"
+#include "sml/op/comparator.hpp"
+
+namespace sml { namespace algorithm { namespace detail {
+
+// Searches [first + lo, first + hi) first, then gallops outwards until
+// the window is known to hold the answer, so a poor guess costs time but
+// never correctness.
+template<class Iterator, class T, class RightOf>
+Iterator _windowed_bound(
+  const Iterator    first,
+  const std::size_t n,
+  std::size_t       lo,
+  std::size_t       hi,
+  const T&          v,
+  RightOf           right_of
+) {
+  sml::op::comparator cmp;
+  std::size_t step = hi - lo + 1;
+
+  while (lo > 0 && !right_of(cmp, v, first[lo - 1])) {
+    hi   = lo - 1;
+    lo   = lo > step ? lo - step : 0;
+    step *= 2;
+  }
+  while (hi < n && right_of(cmp, v, first[hi])) {
+    lo   = hi + 1;
+    hi   = n - hi > step ? hi + step : n;
+    step *= 2;
+  }
+
+  return sml::algorithm::detail::_branchless_bound(
+    first + lo, first + hi, v, cmp, right_of
+  );
+}
+
+} // namespace detail
+
+// Lookup structure over a sorted random-access range of numbers that are
+// close to linear in their position.  The distinct keys are covered by
+// line segments that predict the position of each key's first occurrence
+// to within `epsilon`; the segments' first keys are indexed the same way
+// recursively, until a single segment is left.  A lookup follows one
+// prediction per level and finishes with a binary search over a window of
+// 2 * epsilon + 1 elements.  The range is not copied and must outlive the
+// index.
+template<class Iterator>
+class learned_index {
+public:
+  typedef Iterator    iterator;
+  typedef std::size_t size_type;
+
+  typedef
+    typename std::iterator_traits<Iterator>::value_type
+    value_type;
+
+  explicit learned_index(
+    const Iterator  begin,
+    const Iterator  end,
+    const size_type epsilon = 32
+  ) :
+    begin_(begin),
+    size_(static_cast<size_type>(end - begin)),
+    epsilon_(epsilon),
+    levels_() {
+    if (this->size_ == 0) return;
+
+    this->levels_.push_back(level());
+    learned_index::fit(begin, end, epsilon, this->levels_.back());
+
+    // A level that does not shrink would only repeat itself; lookups
+    // gallop from the first segment of the top level if it keeps several.
+    while (this->levels_.back().key.size() > 1) {
+      const std::vector<value_type>& keys = this->levels_.back().key;
+
+      level upper;
+      learned_index::fit(keys.begin(), keys.end(), INNER_EPSILON, upper);
+      if (upper.key.size() >= keys.size()) break;
+      this->levels_.push_back(upper);
+    }
+  }
+
+  size_type size()    const { return this->size_; }
+  size_type epsilon() const { return this->epsilon_; }
+
+  // Number of segments over the data, and of levels including that one.
+  size_type segments() const {
+    return this->levels_.empty() ? 0 : this->levels_[0].key.size();
+  }
+
+  size_type height() const {
+    return this->levels_.size();
+  }
+
+  // Memory taken by the model, not counting the indexed range.
+  size_type model_bytes() const {
+    size_type bytes = 0;
+    for (size_type l = 0; l < this->levels_.size(); ++l) {
+      bytes += this->levels_[l].key.size() *
+        (sizeof(value_type) + sizeof(segment));
+    }
+    return bytes;
+  }
+
+  // First position whose element is not less than v.
+  Iterator lower_bound(const value_type& v) const {
+    return this->bound(v, sml::algorithm::detail::_lower_bound_probe());
+  }
+
+  // First position whose element is greater than v.
+  Iterator upper_bound(const value_type& v) const {
+    return this->bound(v, sml::algorithm::detail::_upper_bound_probe());
+  }
+
+  std::pair<Iterator, Iterator> equal_range(const value_type& v) const {
+    const Iterator first = this->lower_bound(v);
+    const Iterator end   = this->begin_ + this->size_;
+
+    return std::make_pair(
+      first, sml::algorithm::branchless_upper_bound(first, end, v)
+    );
+  }
+
+  // First position whose element equals v, or the end of the range.
+  Iterator find(const value_type& v) const {
+    const Iterator pos = this->lower_bound(v);
+    const Iterator end = this->begin_ + this->size_;
+
+    return pos != end && !(v < *pos) ? pos : end;
+  }
+
+private:
+  enum { INNER_EPSILON = 4 };
+
+  struct segment {
+    double slope;
+    double intercept;
+  };
+
+  struct level {
+    std::vector<value_type> key;
+    std::vector<segment>    model;
+  };
+
+  // In double, so that keys far apart cannot overflow a signed type.
+  static double distance(const value_type& from, const value_type& to) {
+    return to < from ?
+      0.0 : static_cast<double>(to) - static_cast<double>(from);
+  }
+
+  // Shrinking cone: every segment passes through its first point, and
+  // each further point narrows the range of slopes that keep it within
+  // epsilon, until the range is empty and a new segment starts.
+  template<class ForwardIterator>
+  static void fit(
+    ForwardIterator first,
+    ForwardIterator last,
+    const size_type epsilon,
+    level&          out
+  ) {
+    const double eps = static_cast<double>(epsilon);
+
+    double    lo = 0.0, hi = 0.0;
+    size_type pos = 0, origin = 0;
+
+    for (ForwardIterator prev = first; first != last; prev = first++, ++pos) {
+      if (pos > 0 && !(*prev < *first)) continue;
+
+      if (!out.key.empty()) {
+        const double dx = learned_index::distance(out.key.back(), *first);
+        const double dy = static_cast<double>(pos - origin);
+
+        const double new_lo = lo > (dy - eps) / dx ? lo : (dy - eps) / dx;
+        const double new_hi = hi < (dy + eps) / dx ? hi : (dy + eps) / dx;
+
+        if (new_lo <= new_hi) {
+          lo = new_lo, hi = new_hi;
+          continue;
+        }
+        out.model.back().slope = (lo + hi) / 2;
+      }
+
+      segment s = { 0.0, static_cast<double>(pos) };
+      out.key.push_back(*first);
+      out.model.push_back(s);
+
+      lo = 0.0, hi = 1e300, origin = pos;
+    }
+
+    if (hi < 1e300) out.model.back().slope = (lo + hi) / 2;
+  }
+
+  static size_type predict(
+    const level&      l,
+    const size_type   seg,
+    const value_type& v,
+    const size_type   n
+  ) {
+    const double p = l.model[seg].intercept +
+      l.model[seg].slope * learned_index::distance(l.key[seg], v);
+
+    if (p <= 0.0)                    return 0;
+    if (p >= static_cast<double>(n)) return n;
+    return static_cast<size_type>(p);
+  }
+
+  static std::pair<size_type, size_type> window(
+    const size_type p,
+    const size_type epsilon,
+    const size_type n
+  ) {
+    return std::make_pair(
+      p > epsilon ? p - epsilon : 0,
+      n - p > epsilon + 1 ? p + epsilon + 1 : n
+    );
+  }
+
+  template<class RightOf>
+  Iterator bound(const value_type& v, RightOf right_of) const {
+    if (this->size_ == 0) return this->begin_;
+
+    size_type seg = 0;
+    for (size_type l = this->levels_.size() - 1; l > 0; --l) {
+      const std::vector<value_type>& below = this->levels_[l - 1].key;
+
+      const size_type p =
+        learned_index::predict(this->levels_[l], seg, v, below.size());
+      const std::pair<size_type, size_type> w =
+        learned_index::window(p, INNER_EPSILON, below.size());
+
+      const size_type next = sml::algorithm::detail::_windowed_bound(
+        below.begin(), below.size(), w.first, w.second, v,
+        sml::algorithm::detail::_upper_bound_probe()
+      ) - below.begin();
+      seg = next > 0 ? next - 1 : 0;
+    }
+
+    const size_type p =
+      learned_index::predict(this->levels_[0], seg, v, this->size_);
+    const std::pair<size_type, size_type> w =
+      learned_index::window(p, this->epsilon_, this->size_);
+
+    return sml::algorithm::detail::_windowed_bound(
+      this->begin_, this->size_, w.first, w.second, v, right_of
+    );
+  }
+
+  Iterator           begin_;
+  size_type          size_;
+  size_type          epsilon_;
+  std::vector<level> levels_;
+};
+
+}} // namespace sml::algorithm
+
+#endif
@@ -1,14 +1,24 @@
 #ifndef _SML_ALGORITHM_MIN_MAX_HPP
 #define _SML_ALGORITHM_MIN_MAX_HPP
 
+#include <algorithm>
 #include <iterator>
+#include <limits>
 #include <utility>
+#include "sml/ext/cstdint.hpp"
 #include "sml/op/lesser.hpp"
+#include "sml/op/order_traits.hpp"
 
-namespace sml { namespace algorithm {
+#if defined(__AVX__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sml { namespace algorithm { namespace detail {
 
 template<class Iterator, class Lesser>
-std::pair<Iterator, Iterator> min_max(
+std::pair<Iterator, Iterator> _pairwise_min_max(
   const Iterator begin,
   const Iterator end,
   Lesser lesser
@@ -17,7 +27,7 @@ std::pair<Iterator, Iterator> min_max(
   typedef
     typename std::iterator_traits<Iterator>::difference_type
     difference_type;
-  
+
   difference_type n = end - begin;
   if (n == 0) return std::make_pair(end, end);
   if (n == 1) return std::make_pair(begin, begin);
@@ -45,6 +55,453 @@ std::pair<Iterator, Iterator> min_max(
   return std::make_pair(min, max);
 }
 
+enum { _MIN_MAX_PAIRWISE, _MIN_MAX_VECTOR, _MIN_MAX_VECTOR_REVERSE };
+
+template<int>
+struct _min_max_tag {
+};
+
+// Element types the vector kernel handles, with const stripped.
+template<class T>
+struct _min_max_kernel {
+  enum { value = false };
+  typedef T type;
+};
+
+template<class T>
+struct _min_max_kernel<const T> : _min_max_kernel<T> {
+};
+
+template<>
+struct _min_max_kernel<sml::ext::int32_t> {
+  enum { value = true };
+  typedef sml::ext::int32_t type;
+};
+
+template<>
+struct _min_max_kernel<sml::ext::uint32_t> {
+  enum { value = true };
+  typedef sml::ext::uint32_t type;
+};
+
+template<>
+struct _min_max_kernel<sml::ext::int64_t> {
+  enum { value = true };
+  typedef sml::ext::int64_t type;
+};
+
+template<>
+struct _min_max_kernel<sml::ext::uint64_t> {
+  enum { value = true };
+  typedef sml::ext::uint64_t type;
+};
+
+template<>
+struct _min_max_kernel<float> {
+  enum { value = true };
+  typedef float type;
+};
+
+template<>
+struct _min_max_kernel<double> {
+  enum { value = true };
+  typedef double type;
+};
+
+// Lanes of the kernel.  min(v, acc) and max(v, acc) keep acc wherever v
+// is NaN, like the SSE and AVX instructions do.  The portable version
+// keeps two independent chains of conditional moves.
+template<class T>
+struct _min_max_lanes {
+  enum { WIDTH = 2 };
+
+  struct vector {
+    T lane[WIDTH];
+  };
+
+  static vector set1(const T x) {
+    vector r;
+    for (int i = 0; i < WIDTH; ++i) r.lane[i] = x;
+    return r;
+  }
+
+  static vector load(const T* const p) {
+    vector r;
+    for (int i = 0; i < WIDTH; ++i) r.lane[i] = p[i];
+    return r;
+  }
+
+  static vector min(const vector v, vector acc) {
+    for (int i = 0; i < WIDTH; ++i) {
+      acc.lane[i] = v.lane[i] < acc.lane[i] ? v.lane[i] : acc.lane[i];
+    }
+    return acc;
+  }
+
+  static vector max(const vector v, vector acc) {
+    for (int i = 0; i < WIDTH; ++i) {
+      acc.lane[i] = acc.lane[i] < v.lane[i] ? v.lane[i] : acc.lane[i];
+    }
+    return acc;
+  }
+
+  static void store(T* const p, const vector v) {
+    for (int i = 0; i < WIDTH; ++i) p[i] = v.lane[i];
+  }
+};
+
+#if defined(__AVX__)
+template<>
+struct _min_max_lanes<float> {
+  enum { WIDTH = 8 };
+  typedef __m256 vector;
+
+  static vector set1(const float x)        { return _mm256_set1_ps(x); }
+  static vector load(const float* const p) { return _mm256_loadu_ps(p); }
+  static vector min(vector v, vector acc)  { return _mm256_min_ps(v, acc); }
+  static vector max(vector v, vector acc)  { return _mm256_max_ps(v, acc); }
+  static void   store(float* p, vector v)  { _mm256_storeu_ps(p, v); }
+};
+
+template<>
+struct _min_max_lanes<double> {
+  enum { WIDTH = 4 };
+  typedef __m256d vector;
+
+  static vector set1(const double x)        { return _mm256_set1_pd(x); }
+  static vector load(const double* const p) { return _mm256_loadu_pd(p); }
+  static vector min(vector v, vector acc)   { return _mm256_min_pd(v, acc); }
+  static vector max(vector v, vector acc)   { return _mm256_max_pd(v, acc); }
+  static void   store(double* p, vector v)  { _mm256_storeu_pd(p, v); }
+};
+#elif defined(__SSE2__)
+template<>
+struct _min_max_lanes<float> {
+  enum { WIDTH = 4 };
+  typedef __m128 vector;
+
+  static vector set1(const float x)        { return _mm_set1_ps(x); }
+  static vector load(const float* const p) { return _mm_loadu_ps(p); }
+  static vector min(vector v, vector acc)  { return _mm_min_ps(v, acc); }
+  static vector max(vector v, vector acc)  { return _mm_max_ps(v, acc); }
+  static void   store(float* p, vector v)  { _mm_storeu_ps(p, v); }
+};
+
+template<>
+struct _min_max_lanes<double> {
+  enum { WIDTH = 2 };
+  typedef __m128d vector;
+
+  static vector set1(const double x)        { return _mm_set1_pd(x); }
+  static vector load(const double* const p) { return _mm_loadu_pd(p); }
+  static vector min(vector v, vector acc)   { return _mm_min_pd(v, acc); }
+  static vector max(vector v, vector acc)   { return _mm_max_pd(v, acc); }
+  static void   store(double* p, vector v)  { _mm_storeu_pd(p, v); }
+};
+#endif
+
+#if defined(__AVX2__)
+template<class T>
+struct _min_max_lanes_avx2 {
+  enum { WIDTH = 32 / sizeof(T) };
+  typedef __m256i vector;
+
+  static vector load(const T* const p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+
+  static void store(T* const p, const vector v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+};
+
+template<>
+struct _min_max_lanes<sml::ext::int32_t> :
+  _min_max_lanes_avx2<sml::ext::int32_t> {
+
+  static vector set1(const sml::ext::int32_t x) { return _mm256_set1_epi32(x); }
+  static vector min(vector v, vector acc) { return _mm256_min_epi32(v, acc); }
+  static vector max(vector v, vector acc) { return _mm256_max_epi32(v, acc); }
+};
+
+template<>
+struct _min_max_lanes<sml::ext::uint32_t> :
+  _min_max_lanes_avx2<sml::ext::uint32_t> {
+
+  static vector set1(const sml::ext::uint32_t x) {
+    return _mm256_set1_epi32(static_cast<int>(x));
+  }
+  static vector min(vector v, vector acc) { return _mm256_min_epu32(v, acc); }
+  static vector max(vector v, vector acc) { return _mm256_max_epu32(v, acc); }
+};
+
+// There is no 64-bit min or max before AVX-512, so they compare and
+// blend; `BIAS` flips the sign bit so that signed compares order unsigned
+// values.
+template<class T, long long BIAS>
+struct _min_max_lanes_avx2_64 : _min_max_lanes_avx2<T> {
+  typedef __m256i vector;
+
+  static vector set1(const T x) {
+    return _mm256_set1_epi64x(static_cast<long long>(x));
+  }
+
+  static vector less(const vector a, const vector b) {
+    const __m256i bias = _mm256_set1_epi64x(BIAS);
+    return _mm256_cmpgt_epi64(
+      _mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias)
+    );
+  }
+
+  static vector min(vector v, vector acc) {
+    return _mm256_blendv_epi8(acc, v, less(v, acc));
+  }
+
+  static vector max(vector v, vector acc) {
+    return _mm256_blendv_epi8(acc, v, less(acc, v));
+  }
+};
+
+template<>
+struct _min_max_lanes<sml::ext::int64_t> :
+  _min_max_lanes_avx2_64<sml::ext::int64_t, 0> {
+};
+
+template<>
+struct _min_max_lanes<sml::ext::uint64_t> :
+  _min_max_lanes_avx2_64<sml::ext::uint64_t, (-0x7fffffffffffffffLL - 1)> {
+};
+#elif defined(__SSE2__)
+// SSE2 has no 32-bit min or max either.
+template<class T, int BIAS>
+struct _min_max_lanes_sse2 {
+  enum { WIDTH = 4 };
+  typedef __m128i vector;
+
+  static vector set1(const T x) {
+    return _mm_set1_epi32(static_cast<int>(x));
+  }
+
+  static vector load(const T* const p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+
+  static vector less(const vector a, const vector b) {
+    const __m128i bias = _mm_set1_epi32(BIAS);
+    return _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+  }
+
+  static vector select(const vector mask, const vector a, const vector b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+  }
+
+  static vector min(vector v, vector acc) { return select(less(v, acc), v, acc); }
+  static vector max(vector v, vector acc) { return select(less(acc, v), v, acc); }
+
+  static void store(T* const p, const vector v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+};
+
+template<>
+struct _min_max_lanes<sml::ext::int32_t> :
+  _min_max_lanes_sse2<sml::ext::int32_t, 0> {
+};
+
+template<>
+struct _min_max_lanes<sml::ext::uint32_t> :
+  _min_max_lanes_sse2<sml::ext::uint32_t, (-0x7fffffff - 1)> {
+};
+#endif
+
+// One pass in blocks that stay in L1: each block is reduced in vector
+// lanes, and only the block that last improved the minimum (maximum) is
+// scanned again for its first position.  NaNs are never less or greater
+// than anything and so are skipped.
+template<class T>
+std::pair<T*, T*> _vector_min_max(T* const begin, T* const end) {
+  typedef typename _min_max_kernel<T>::type value_type;
+  typedef _min_max_lanes<value_type>        lanes;
+  typedef typename lanes::vector            vector;
+  typedef std::numeric_limits<value_type>   limits;
+
+  enum { BLOCK = 512 };
+
+  T* it = begin;
+  while (it != end && !(*it == *it)) ++it;
+  if (it == end) return std::make_pair(end, end);
+
+  const value_type highest = limits::has_infinity ? limits::infinity() : limits::max();
+  const value_type lowest  = limits::has_infinity ? -limits::infinity() : limits::min();
+
+  value_type mn = *it, mx = *it;
+  T* min = it;
+  T* max = it;
+  T* min_block = 0;
+  T* max_block = 0;
+
+  for (++it; end - it >= BLOCK; it += BLOCK) {
+    vector vmin = lanes::set1(highest), vmax = lanes::set1(lowest);
+
+    for (int i = 0; i < BLOCK; i += lanes::WIDTH) {
+      const vector v = lanes::load(it + i);
+      vmin = lanes::min(v, vmin);
+      vmax = lanes::max(v, vmax);
+    }
+
+    value_type lane_min[lanes::WIDTH], lane_max[lanes::WIDTH];
+    lanes::store(lane_min, vmin);
+    lanes::store(lane_max, vmax);
+
+    for (int i = 0; i < lanes::WIDTH; ++i) {
+      if (lane_min[i] < mn) mn = lane_min[i], min_block = it;
+      if (mx < lane_max[i]) mx = lane_max[i], max_block = it;
+    }
+  }
+
+  if (min_block) min = std::find(min_block, min_block + BLOCK, mn);
+  if (max_block) max = std::find(max_block, max_block + BLOCK, mx);
+
+  for (; it != end; ++it) {
+    if (*it < mn) mn = *it, min = it;
+    if (mx < *it) mx = *it, max = it;
+  }
+
+  return std::make_pair(min, max);
+}
+
+// The vector kernel's rule for iterators it cannot scan: the first minimum
+// and the first maximum, NaNs skipped, (end, end) for only NaNs.
+template<class Iterator>
+std::pair<Iterator, Iterator> _scalar_min_max(
+  Iterator       it,
+  const Iterator end
+) {
+  while (it != end && !(*it == *it)) ++it;
+  if (it == end) return std::make_pair(end, end);
+
+  Iterator min = it, max = it;
+  for (++it; it != end; ++it) {
+    if (*it < *min) min = it;
+    if (*max < *it) max = it;
+  }
+  return std::make_pair(min, max);
+}
+
+// Picks the vector kernel for the element types it handles when `Lesser`
+// is their natural order or its reverse.
+template<class T, class Lesser>
+struct _min_max_dispatch {
+  typedef typename _min_max_kernel<T>::type value_type;
+
+  enum {
+    value =
+      !_min_max_kernel<T>::value ? _MIN_MAX_PAIRWISE :
+      sml::op::is_natural_order<Lesser, value_type>::value ? _MIN_MAX_VECTOR :
+      sml::op::is_reverse_order<Lesser, value_type>::value ?
+        _MIN_MAX_VECTOR_REVERSE :
+      _MIN_MAX_PAIRWISE
+  };
+};
+
+template<class T, class Lesser>
+std::pair<T*, T*> _min_max(
+  T* const                        begin,
+  T* const                        end,
+  Lesser                          lesser,
+  _min_max_tag<_MIN_MAX_PAIRWISE>
+) {
+  return sml::algorithm::detail::_pairwise_min_max(begin, end, lesser);
+}
+
+template<class T, class Lesser>
+std::pair<T*, T*> _min_max(
+  T* const                      begin,
+  T* const                      end,
+  Lesser,
+  _min_max_tag<_MIN_MAX_VECTOR>
+) {
+  return sml::algorithm::detail::_vector_min_max(begin, end);
+}
+
+// The first greatest element is the minimum in reverse order.
+template<class T, class Lesser>
+std::pair<T*, T*> _min_max(
+  T* const                              begin,
+  T* const                              end,
+  Lesser,
+  _min_max_tag<_MIN_MAX_VECTOR_REVERSE>
+) {
+  const std::pair<T*, T*> res =
+    sml::algorithm::detail::_vector_min_max(begin, end);
+  return std::make_pair(res.second, res.first);
+}
+
+template<class Iterator, class Lesser>
+std::pair<Iterator, Iterator> _min_max(
+  const Iterator                  begin,
+  const Iterator                  end,
+  Lesser                          lesser,
+  _min_max_tag<_MIN_MAX_PAIRWISE>
+) {
+  return sml::algorithm::detail::_pairwise_min_max(begin, end, lesser);
+}
+
+template<class Iterator, class Lesser>
+std::pair<Iterator, Iterator> _min_max(
+  const Iterator                begin,
+  const Iterator                end,
+  Lesser,
+  _min_max_tag<_MIN_MAX_VECTOR>
+) {
+  return sml::algorithm::detail::_scalar_min_max(begin, end);
+}
+
+template<class Iterator, class Lesser>
+std::pair<Iterator, Iterator> _min_max(
+  const Iterator                        begin,
+  const Iterator                        end,
+  Lesser,
+  _min_max_tag<_MIN_MAX_VECTOR_REVERSE>
+) {
+  const std::pair<Iterator, Iterator> res =
+    sml::algorithm::detail::_scalar_min_max(begin, end);
+  return std::make_pair(res.second, res.first);
+}
+
+} // namespace detail
+
+// 32- and 64-bit integers, floats and doubles in their natural order, or
+// its reverse, give the first minimum and the first maximum; NaNs are
+// ignored, and a range of only NaNs gives (end, end).  Arrays of them are
+// scanned by a vector kernel, other ranges one element at a time by the
+// same rule.
+template<class Iterator, class Lesser>
+std::pair<Iterator, Iterator> min_max(
+  const Iterator begin,
+  const Iterator end,
+  Lesser lesser
+) {
+  typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+  return sml::algorithm::detail::_min_max(
+    begin, end, lesser,
+    sml::algorithm::detail::_min_max_tag<
+      sml::algorithm::detail::_min_max_dispatch<value_type, Lesser>::value
+    >()
+  );
+}
+
+template<class T, class Lesser>
+std::pair<T*, T*> min_max(T* const begin, T* const end, Lesser lesser) {
+  return sml::algorithm::detail::_min_max(
+    begin, end, lesser,
+    sml::algorithm::detail::_min_max_tag<
+      sml::algorithm::detail::_min_max_dispatch<T, Lesser>::value
+    >()
+  );
+}
+
 template<class Iterator>
 std::pair<Iterator, Iterator> min_max(
   const Iterator begin,
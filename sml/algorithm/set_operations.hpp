@@ -0,0 +1,608 @@
+#ifndef _SML_ALGORITHM_SET_OPERATIONS_HPP
+#define _SML_ALGORITHM_SET_OPERATIONS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sml/algorithm/bounds.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/op/comparator.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sml { namespace algorithm { namespace detail {
+
+// A range this many times longer than the other is searched by galloping
+// instead of merged.
+enum { _GALLOP_RATIO = 32 };
+
+template<bool>
+struct _simd_set_tag {
+};
+
+// Pointers to 32-bit integers compared in their natural order can be
+// merged four by four; the lane number keeps signed and unsigned apart.
+template<class Iterator>
+struct _simd_set_lane {
+  enum { value = 0 };
+};
+
+#ifdef __SSE2__
+template<>
+struct _simd_set_lane<sml::ext::int32_t*> {
+  enum { value = 1 };
+};
+
+template<>
+struct _simd_set_lane<const sml::ext::int32_t*> {
+  enum { value = 1 };
+};
+
+template<>
+struct _simd_set_lane<sml::ext::uint32_t*> {
+  enum { value = 2 };
+};
+
+template<>
+struct _simd_set_lane<const sml::ext::uint32_t*> {
+  enum { value = 2 };
+};
+#endif
+
+template<class Iterator1, class Iterator2, class Comparator>
+struct _simd_set {
+  typedef _simd_set_tag<false> tag;
+};
+
+template<class Iterator1, class Iterator2>
+struct _simd_set<Iterator1, Iterator2, sml::op::comparator> {
+  typedef
+    _simd_set_tag<
+      _simd_set_lane<Iterator1>::value != 0 &&
+      _simd_set_lane<Iterator1>::value == _simd_set_lane<Iterator2>::value
+    >
+    tag;
+};
+
+// Output iterator that only counts what is written to it.
+class _counter {
+public:
+  _counter() : count_(0) {
+  }
+
+  template<class T>
+  _counter& operator=(const T&) {
+    return *this;
+  }
+
+  _counter& operator*()     { return *this; }
+  _counter& operator++()    { ++this->count_; return *this; }
+  _counter  operator++(int) { _counter old(*this); ++this->count_; return old; }
+
+  std::size_t count() const { return this->count_; }
+
+private:
+  std::size_t count_;
+};
+
+#ifdef __SSE2__
+// Bit i is set when element i of the block at a equals any element of the
+// block at b: the b block is compared in all four rotations.
+template<class T>
+int _block_matches(const T* const a, const T* const b) {
+  const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+  const __m128i eq = _mm_or_si128(
+    _mm_or_si128(
+      _mm_cmpeq_epi32(va, vb),
+      _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))
+    ),
+    _mm_or_si128(
+      _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+      _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))
+    )
+  );
+  return _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+#endif
+
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _merge_intersection(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp,
+  _simd_set_tag<false>
+) {
+  while (first1 != last1 && first2 != last2) {
+    const int c = cmp(*first1, *first2);
+
+    if (c < 0)      ++first1;
+    else if (c > 0) ++first2;
+    else            *out++ = *first1, ++first1, ++first2;
+  }
+  return out;
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _merge_difference(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp,
+  _simd_set_tag<false>
+) {
+  while (first1 != last1 && first2 != last2) {
+    const int c = cmp(*first1, *first2);
+
+    if (c < 0)      *out++ = *first1, ++first1;
+    else if (c > 0) ++first2;
+    else            ++first1, ++first2;
+  }
+  return std::copy(first1, last1, out);
+}
+
+#ifdef __SSE2__
+// Blocks of four are compared all against all; the block with the
+// smaller last element moves on, both when the last elements are equal.
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _merge_intersection(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp,
+  _simd_set_tag<true>
+) {
+  while (last1 - first1 >= 4 && last2 - first2 >= 4) {
+    const int matches = _block_matches(first1, first2);
+    for (int i = 0; i < 4; ++i) {
+      if (matches >> i & 1) *out++ = first1[i];
+    }
+
+    const bool next1 = !(first2[3] < first1[3]);
+    const bool next2 = !(first1[3] < first2[3]);
+    first1 += 4 * next1;
+    first2 += 4 * next2;
+  }
+
+  return _merge_intersection(
+    first1, last1, first2, last2, out, cmp, _simd_set_tag<false>()
+  );
+}
+
+// An element of the first range is written once its block moves on
+// without having matched any block of the second range.
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _merge_difference(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp,
+  _simd_set_tag<true>
+) {
+  int matched = 0;
+
+  while (last1 - first1 >= 4 && last2 - first2 >= 4) {
+    matched |= _block_matches(first1, first2);
+
+    const bool next1 = !(first2[3] < first1[3]);
+    const bool next2 = !(first1[3] < first2[3]);
+
+    if (next1) {
+      for (int i = 0; i < 4; ++i) {
+        if (!(matched >> i & 1)) *out++ = first1[i];
+      }
+      matched = 0;
+      first1 += 4;
+    }
+    first2 += 4 * next2;
+  }
+
+  // The current block has only been compared with the blocks before
+  // first2; what it did not match there is checked against the rest.
+  for (int i = 0; i < 4 && first1 != last1; ++i, ++first1) {
+    if (matched >> i & 1) continue;
+
+    while (first2 != last2 && *first2 < *first1) ++first2;
+    if (first2 != last2 && *first2 == *first1) ++first2;
+    else                                       *out++ = *first1;
+  }
+
+  return _merge_difference(
+    first1, last1, first2, last2, out, cmp, _simd_set_tag<false>()
+  );
+}
+#endif
+
+// Elements of the short range are looked up in the long one, each search
+// starting where the previous one ended.  Matches are written from the
+// first range.
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _gallop_intersection(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp
+) {
+  if (last1 - first1 <= last2 - first2) {
+    for (; first1 != last1 && first2 != last2; ++first1) {
+      first2 = sml::algorithm::gallop_lower_bound(
+        first2, last2, first2, *first1, cmp
+      );
+      if (first2 != last2 && cmp(*first1, *first2) == 0) *out++ = *first1;
+    }
+  }
+  else {
+    for (; first2 != last2 && first1 != last1; ++first2) {
+      first1 = sml::algorithm::gallop_lower_bound(
+        first1, last1, first1, *first2, cmp
+      );
+      if (first1 != last1 && cmp(*first2, *first1) == 0) *out++ = *first1;
+    }
+  }
+  return out;
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _gallop_difference(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp
+) {
+  if (last1 - first1 <= last2 - first2) {
+    for (; first1 != last1; ++first1) {
+      first2 = sml::algorithm::gallop_lower_bound(
+        first2, last2, first2, *first1, cmp
+      );
+      if (first2 == last2 || cmp(*first1, *first2) != 0) *out++ = *first1;
+    }
+    return out;
+  }
+
+  for (; first2 != last2 && first1 != last1; ++first2) {
+    const Iterator1 pos = sml::algorithm::gallop_lower_bound(
+      first1, last1, first1, *first2, cmp
+    );
+    out    = std::copy(first1, pos, out);
+    first1 = pos != last1 && cmp(*first2, *pos) == 0 ? pos + 1 : pos;
+  }
+  return std::copy(first1, last1, out);
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _set_union(
+  Iterator1       first1,
+  const Iterator1 last1,
+  Iterator2       first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp
+) {
+  const std::ptrdiff_t n1 = last1 - first1, n2 = last2 - first2;
+
+  if (n1 > n2 * _GALLOP_RATIO) {
+    for (; first2 != last2; ++first2) {
+      const Iterator1 pos = sml::algorithm::gallop_lower_bound(
+        first1, last1, first1, *first2, cmp
+      );
+      out    = std::copy(first1, pos, out);
+      first1 = pos;
+      if (first1 == last1 || cmp(*first2, *first1) != 0) *out++ = *first2;
+    }
+    return std::copy(first1, last1, out);
+  }
+
+  if (n2 > n1 * _GALLOP_RATIO) {
+    for (; first1 != last1; ++first1) {
+      const Iterator2 pos = sml::algorithm::gallop_lower_bound(
+        first2, last2, first2, *first1, cmp
+      );
+      out    = std::copy(first2, pos, out);
+      first2 = pos != last2 && cmp(*first1, *pos) == 0 ? pos + 1 : pos;
+      *out++ = *first1;
+    }
+    return std::copy(first2, last2, out);
+  }
+
+  while (first1 != last1 && first2 != last2) {
+    const int c = cmp(*first1, *first2);
+
+    if (c < 0)      *out++ = *first1, ++first1;
+    else if (c > 0) *out++ = *first2, ++first2;
+    else            *out++ = *first1, ++first1, ++first2;
+  }
+  return std::copy(first2, last2, std::copy(first1, last1, out));
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _set_intersection(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp
+) {
+  const std::ptrdiff_t n1 = last1 - first1, n2 = last2 - first2;
+
+  if (n1 > n2 * _GALLOP_RATIO || n2 > n1 * _GALLOP_RATIO) {
+    return _gallop_intersection(first1, last1, first2, last2, out, cmp);
+  }
+  return _merge_intersection(
+    first1, last1, first2, last2, out, cmp,
+    typename _simd_set<Iterator1, Iterator2, Comparator>::tag()
+  );
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator, class Comparator>
+OutputIterator _set_difference(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator&     cmp
+) {
+  const std::ptrdiff_t n1 = last1 - first1, n2 = last2 - first2;
+
+  if (n1 > n2 * _GALLOP_RATIO || n2 > n1 * _GALLOP_RATIO) {
+    return _gallop_difference(first1, last1, first2, last2, out, cmp);
+  }
+  return _merge_difference(
+    first1, last1, first2, last2, out, cmp,
+    typename _simd_set<Iterator1, Iterator2, Comparator>::tag()
+  );
+}
+
+template<class Iterator>
+struct _shorter_range {
+  bool operator()(
+    const std::pair<Iterator, Iterator>& a,
+    const std::pair<Iterator, Iterator>& b
+  ) const {
+    return a.second - a.first < b.second - b.first;
+  }
+};
+
+} // namespace detail
+
+// Set operations over sorted random-access ranges without duplicates,
+// such as posting lists of ids.  Ranges of similar length are merged,
+// four elements at a time with SSE2 for pointers to 32-bit integers in
+// their natural order; a much shorter range is instead looked up in the
+// longer one by galloping.
+
+template<
+  class Iterator1, class Iterator2, class OutputIterator, class Comparator
+>
+OutputIterator set_intersection(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator      cmp
+) {
+  return sml::algorithm::detail::_set_intersection(
+    first1, last1, first2, last2, out, cmp
+  );
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator>
+OutputIterator set_intersection(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out
+) {
+  return sml::algorithm::set_intersection(
+    first1, last1, first2, last2, out, sml::op::comparator()
+  );
+}
+
+template<
+  class Iterator1, class Iterator2, class OutputIterator, class Comparator
+>
+OutputIterator set_union(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator      cmp
+) {
+  return sml::algorithm::detail::_set_union(
+    first1, last1, first2, last2, out, cmp
+  );
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator>
+OutputIterator set_union(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out
+) {
+  return sml::algorithm::set_union(
+    first1, last1, first2, last2, out, sml::op::comparator()
+  );
+}
+
+template<
+  class Iterator1, class Iterator2, class OutputIterator, class Comparator
+>
+OutputIterator set_difference(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out,
+  Comparator      cmp
+) {
+  return sml::algorithm::detail::_set_difference(
+    first1, last1, first2, last2, out, cmp
+  );
+}
+
+template<class Iterator1, class Iterator2, class OutputIterator>
+OutputIterator set_difference(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  OutputIterator  out
+) {
+  return sml::algorithm::set_difference(
+    first1, last1, first2, last2, out, sml::op::comparator()
+  );
+}
+
+// Sizes of the results above, without writing them anywhere.
+
+template<class Iterator1, class Iterator2, class Comparator>
+std::size_t set_intersection_size(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  Comparator      cmp
+) {
+  return sml::algorithm::detail::_set_intersection(
+    first1, last1, first2, last2, sml::algorithm::detail::_counter(), cmp
+  ).count();
+}
+
+template<class Iterator1, class Iterator2>
+std::size_t set_intersection_size(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2
+) {
+  return sml::algorithm::set_intersection_size(
+    first1, last1, first2, last2, sml::op::comparator()
+  );
+}
+
+template<class Iterator1, class Iterator2, class Comparator>
+std::size_t set_union_size(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  Comparator      cmp
+) {
+  return
+    static_cast<std::size_t>((last1 - first1) + (last2 - first2)) -
+    sml::algorithm::set_intersection_size(first1, last1, first2, last2, cmp);
+}
+
+template<class Iterator1, class Iterator2>
+std::size_t set_union_size(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2
+) {
+  return sml::algorithm::set_union_size(
+    first1, last1, first2, last2, sml::op::comparator()
+  );
+}
+
+template<class Iterator1, class Iterator2, class Comparator>
+std::size_t set_difference_size(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2,
+  Comparator      cmp
+) {
+  return
+    static_cast<std::size_t>(last1 - first1) -
+    sml::algorithm::set_intersection_size(first1, last1, first2, last2, cmp);
+}
+
+template<class Iterator1, class Iterator2>
+std::size_t set_difference_size(
+  const Iterator1 first1,
+  const Iterator1 last1,
+  const Iterator2 first2,
+  const Iterator2 last2
+) {
+  return sml::algorithm::set_difference_size(
+    first1, last1, first2, last2, sml::op::comparator()
+  );
+}
+
+// Intersection of many ranges, given as (begin, end) pairs.  The ranges
+// are visited from the shortest up: each element of the shortest is
+// galloped for in the others and written if all of them contain it.
+template<class RangeIterator, class OutputIterator, class Comparator>
+OutputIterator kway_set_intersection(
+  const RangeIterator first,
+  const RangeIterator last,
+  OutputIterator      out,
+  Comparator          cmp
+) {
+  typedef typename std::iterator_traits<RangeIterator>::value_type range_type;
+  typedef typename range_type::first_type                          iterator;
+
+  std::vector<range_type> ranges(first, last);
+  if (ranges.empty()) return out;
+
+  std::sort(
+    ranges.begin(), ranges.end(),
+    sml::algorithm::detail::_shorter_range<iterator>()
+  );
+
+  for (iterator it = ranges[0].first; it != ranges[0].second; ++it) {
+    bool found = true;
+
+    for (std::size_t k = 1; k < ranges.size() && found; ++k) {
+      ranges[k].first = sml::algorithm::gallop_lower_bound(
+        ranges[k].first, ranges[k].second, ranges[k].first, *it, cmp
+      );
+      if (ranges[k].first == ranges[k].second) return out;
+
+      found = cmp(*it, *ranges[k].first) == 0;
+    }
+
+    if (found) *out++ = *it;
+  }
+  return out;
+}
+
+template<class RangeIterator, class OutputIterator>
+OutputIterator kway_set_intersection(
+  const RangeIterator first,
+  const RangeIterator last,
+  OutputIterator      out
+) {
+  return sml::algorithm::kway_set_intersection(
+    first, last, out, sml::op::comparator()
+  );
+}
+
+}} // namespace sml::algorithm
+
+#endif
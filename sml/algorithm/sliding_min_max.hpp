@@ -0,0 +1,196 @@
+#ifndef _SML_ALGORITHM_SLIDING_MIN_MAX_HPP
+#define _SML_ALGORITHM_SLIDING_MIN_MAX_HPP
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include "sml/op/lesser.hpp"
+
+namespace sml { namespace algorithm { namespace detail {
+
+// Candidates for the extreme of a window, oldest first.  Each new value
+// removes the candidates it beats from the back, so the front is always the
+// extreme and every value is pushed and popped at most once.
+template<class Key, class T, class Better>
+class _monotonic_window {
+public:
+  typedef std::pair<Key, T> entry_type;
+
+  explicit _monotonic_window(const Better& better) :
+    better_(better) {
+  }
+
+  void push(const Key& key, const T& v) {
+    while (
+      !this->entries_.empty() && !this->better_(this->entries_.back().second, v)
+    ) {
+      this->entries_.pop_back();
+    }
+    this->entries_.push_back(entry_type(key, v));
+  }
+
+  // Drops the candidates more than `span` older than `now`.  Keys never
+  // exceed `now`, so the difference cannot wrap for unsigned keys.
+  void expire(const Key& now, const Key& span) {
+    while (
+      !this->entries_.empty() && span < now - this->entries_.front().first
+    ) {
+      this->entries_.pop_front();
+    }
+  }
+
+  const T& front() const { return this->entries_.front().second; }
+  bool     empty() const { return this->entries_.empty(); }
+
+  void clear() { this->entries_.clear(); }
+
+private:
+  Better                 better_;
+  std::deque<entry_type> entries_;
+};
+
+// Flips a Lesser so that the maximum is kept with the same window.
+template<class Lesser>
+class _greater_of {
+public:
+  explicit _greater_of(const Lesser& lesser) :
+    lesser_(lesser) {
+  }
+
+  template<class T>
+  bool operator()(const T& a, const T& b) const {
+    return this->lesser_(b, a);
+  }
+
+private:
+  Lesser lesser_;
+};
+
+} // namespace detail
+
+// Minimum and maximum of the last `window` values pushed, in amortized O(1)
+// per value.  Ties keep the most recent value.
+template<class T, class Lesser = sml::op::lesser>
+class sliding_min_max {
+public:
+  typedef T           value_type;
+  typedef Lesser      value_compare;
+  typedef std::size_t size_type;
+
+  explicit sliding_min_max(
+    const size_type window,
+    const Lesser&   lesser = Lesser()
+  ) :
+    window_(window),
+    pushed_(0),
+    min_(lesser),
+    max_(sml::algorithm::detail::_greater_of<Lesser>(lesser)) {
+  }
+
+  void push(const T& v) {
+    if (this->window_ == 0) return;
+
+    this->min_.push(this->pushed_, v);
+    this->max_.push(this->pushed_, v);
+    ++this->pushed_;
+
+    this->min_.expire(this->pushed_, this->window_);
+    this->max_.expire(this->pushed_, this->window_);
+  }
+
+  // Undefined when empty().
+  const T& min() const { return this->min_.front(); }
+  const T& max() const { return this->max_.front(); }
+
+  size_type size() const {
+    return this->pushed_ < this->window_ ? this->pushed_ : this->window_;
+  }
+
+  bool      empty()  const { return this->size() == 0; }
+  size_type window() const { return this->window_; }
+
+  void clear() {
+    this->pushed_ = 0;
+    this->min_.clear();
+    this->max_.clear();
+  }
+
+private:
+  typedef
+    sml::algorithm::detail::_monotonic_window<size_type, T, Lesser>
+    min_window;
+  typedef
+    sml::algorithm::detail::_monotonic_window<
+      size_type, T, sml::algorithm::detail::_greater_of<Lesser>
+    >
+    max_window;
+
+  size_type  window_;
+  size_type  pushed_;
+  min_window min_;
+  max_window max_;
+};
+
+// Minimum and maximum of the values pushed within the last `span` time
+// units: a value pushed at `t` stays in the window until the latest time
+// passes t + span.  Times must not decrease.
+template<class T, class Time = double, class Lesser = sml::op::lesser>
+class timed_sliding_min_max {
+public:
+  typedef T           value_type;
+  typedef Time        time_type;
+  typedef Lesser      value_compare;
+
+  explicit timed_sliding_min_max(
+    const Time&   span,
+    const Lesser& lesser = Lesser()
+  ) :
+    span_(span),
+    now_(),
+    min_(lesser),
+    max_(sml::algorithm::detail::_greater_of<Lesser>(lesser)) {
+  }
+
+  void push(const Time& t, const T& v) {
+    this->min_.push(t, v);
+    this->max_.push(t, v);
+    this->advance(t);
+  }
+
+  // Moves the window to end at `now` without adding a value.
+  void advance(const Time& now) {
+    this->now_ = now;
+    this->min_.expire(now, this->span_);
+    this->max_.expire(now, this->span_);
+  }
+
+  // Undefined when empty().
+  const T& min() const { return this->min_.front(); }
+  const T& max() const { return this->max_.front(); }
+
+  bool        empty() const { return this->min_.empty(); }
+  const Time& now()   const { return this->now_; }
+  const Time& span()  const { return this->span_; }
+
+  void clear() {
+    this->min_.clear();
+    this->max_.clear();
+  }
+
+private:
+  typedef sml::algorithm::detail::_monotonic_window<Time, T, Lesser> min_window;
+  typedef
+    sml::algorithm::detail::_monotonic_window<
+      Time, T, sml::algorithm::detail::_greater_of<Lesser>
+    >
+    max_window;
+
+  Time       span_;
+  Time       now_;
+  min_window min_;
+  max_window max_;
+};
+
+}} // namespace sml::algorithm
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef _SML_ALGORITHM_STATIC_SEARCH_TREE_HPP
+#define _SML_ALGORITHM_STATIC_SEARCH_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "sml/ext/cstdint.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace sml { namespace algorithm { namespace detail {
+
+// A node is one cache line of keys; count_less(node, x) is the number of
+// its keys less than x, which is also the child to descend into.
+template<class T>
+struct _search_tree_node {
+  enum { SIZE = 64 / sizeof(T) };
+
+  static int count_less(const T* const node, const T x) {
+    int count = 0;
+    for (int i = 0; i < SIZE; ++i) {
+      count += node[i] < x;
+    }
+    return count;
+  }
+};
+
+#ifdef __AVX2__
+template<class T>
+struct _search_tree_node_avx2 {
+  enum { SIZE = 64 / sizeof(T) };
+
+  static __m256i load(const T* const node, const int half, const __m256i bias) {
+    return _mm256_xor_si256(
+      _mm256_load_si256(reinterpret_cast<const __m256i*>(node) + half), bias
+    );
+  }
+};
+
+template<>
+struct _search_tree_node<sml::ext::int32_t> :
+  _search_tree_node_avx2<sml::ext::int32_t> {
+
+  static int count_less(
+    const sml::ext::int32_t* const node,
+    const sml::ext::int32_t        x
+  ) {
+    return count_less(node, x, _mm256_setzero_si256());
+  }
+
+  static int count_less(
+    const sml::ext::int32_t* const node,
+    const sml::ext::int32_t        x,
+    const __m256i                  bias
+  ) {
+    const __m256i v  = _mm256_xor_si256(_mm256_set1_epi32(x), bias);
+    const __m256i lo = _mm256_cmpgt_epi32(v, load(node, 0, bias));
+    const __m256i hi = _mm256_cmpgt_epi32(v, load(node, 1, bias));
+
+    return __builtin_popcount(
+      _mm256_movemask_ps(_mm256_castsi256_ps(lo)) |
+      _mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8
+    );
+  }
+};
+
+template<>
+struct _search_tree_node<sml::ext::uint32_t> :
+  _search_tree_node_avx2<sml::ext::uint32_t> {
+
+  static int count_less(
+    const sml::ext::uint32_t* const node,
+    const sml::ext::uint32_t        x
+  ) {
+    return _search_tree_node<sml::ext::int32_t>::count_less(
+      reinterpret_cast<const sml::ext::int32_t*>(node),
+      static_cast<sml::ext::int32_t>(x),
+      _mm256_set1_epi32(static_cast<int>(0x80000000u))
+    );
+  }
+};
+
+template<>
+struct _search_tree_node<sml::ext::int64_t> :
+  _search_tree_node_avx2<sml::ext::int64_t> {
+
+  static int count_less(
+    const sml::ext::int64_t* const node,
+    const sml::ext::int64_t        x
+  ) {
+    return count_less(node, x, _mm256_setzero_si256());
+  }
+
+  static int count_less(
+    const sml::ext::int64_t* const node,
+    const sml::ext::int64_t        x,
+    const __m256i                  bias
+  ) {
+    const __m256i v  = _mm256_xor_si256(_mm256_set1_epi64x(x), bias);
+    const __m256i lo = _mm256_cmpgt_epi64(v, load(node, 0, bias));
+    const __m256i hi = _mm256_cmpgt_epi64(v, load(node, 1, bias));
+
+    return __builtin_popcount(
+      _mm256_movemask_pd(_mm256_castsi256_pd(lo)) |
+      _mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4
+    );
+  }
+};
+
+template<>
+struct _search_tree_node<sml::ext::uint64_t> :
+  _search_tree_node_avx2<sml::ext::uint64_t> {
+
+  static int count_less(
+    const sml::ext::uint64_t* const node,
+    const sml::ext::uint64_t        x
+  ) {
+    return _search_tree_node<sml::ext::int64_t>::count_less(
+      reinterpret_cast<const sml::ext::int64_t*>(node),
+      static_cast<sml::ext::int64_t>(x),
+      _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull))
+    );
+  }
+};
+#endif
+
+} // namespace detail
+
+// Read-only S+tree over a sorted range of integers.  The sorted keys,
+// padded to whole cache lines, are the leaves; every internal node holds
+// one cache line of separators, the smallest key of each child but the
+// first, so a lookup touches one line per level and compares against a
+// whole node at once (with AVX2 when the compiler targets it).  Results
+// are positions in the original range; size() means "not found".
+template<class T>
+class static_search_tree {
+public:
+  typedef T           value_type;
+  typedef std::size_t size_type;
+
+  static_search_tree() :
+    storage_(),
+    offset_(),
+    size_(0) {
+  }
+
+  template<class Iterator>
+  static_search_tree(const Iterator first, const Iterator last) :
+    storage_(),
+    offset_(),
+    size_(0) {
+    this->assign(first, last);
+  }
+
+  static_search_tree(const static_search_tree& other) :
+    storage_(other.storage_.size()),
+    offset_(other.offset_),
+    size_(other.size_) {
+    this->copy_nodes(other);
+  }
+
+  static_search_tree& operator=(const static_search_tree& other) {
+    if (this != &other) {
+      this->storage_.assign(other.storage_.size(), value_type());
+      this->offset_ = other.offset_;
+      this->size_   = other.size_;
+      this->copy_nodes(other);
+    }
+    return *this;
+  }
+
+  template<class Iterator>
+  void assign(const Iterator first, const Iterator last) {
+    const std::vector<value_type> sorted(first, last);
+    this->size_ = sorted.size();
+
+    std::vector<size_type> count(1, (this->size_ + NODE - 1) / NODE);
+    while (count.back() > 1) {
+      count.push_back((count.back() + NODE) / (NODE + 1));
+    }
+
+    this->offset_.assign(count.size(), 0);
+    size_type total = 0;
+    for (size_type h = count.size(); h-- > 0;) {
+      this->offset_[h] = total;
+      total += count[h] * NODE;
+    }
+
+    this->storage_.assign(total + NODE, MAX);
+    value_type* const nodes = this->nodes();
+
+    std::copy(sorted.begin(), sorted.end(), nodes + this->offset_[0]);
+
+    size_type span = 1;
+    for (size_type h = 1; h < count.size(); ++h, span *= NODE + 1) {
+      for (size_type i = 0; i < count[h] * NODE; ++i) {
+        const size_type leaf = (i / NODE * (NODE + 1) + i % NODE + 1) * span;
+        nodes[this->offset_[h] + i] =
+          leaf < count[0] ? sorted[leaf * NODE] : MAX;
+      }
+    }
+  }
+
+  size_type size()  const { return this->size_; }
+  bool      empty() const { return this->size_ == 0; }
+
+  // Position of the first element not less than v.
+  size_type lower_bound(const value_type v) const {
+    if (this->size_ == 0) return 0;
+
+    const value_type* const nodes = this->nodes();
+
+    size_type k = 0;
+    for (size_type h = this->offset_.size() - 1; h > 0; --h) {
+      k = k * (NODE + 1) + node_type::count_less(
+        nodes + this->offset_[h] + k * NODE, v
+      );
+    }
+
+    const size_type pos = k * NODE + node_type::count_less(
+      nodes + this->offset_[0] + k * NODE, v
+    );
+    return pos < this->size_ ? pos : this->size_;
+  }
+
+  // Position of the first element greater than v.
+  size_type upper_bound(const value_type v) const {
+    return v == MAX ? this->size_ : this->lower_bound(v + 1);
+  }
+
+  std::pair<size_type, size_type> equal_range(const value_type v) const {
+    return std::make_pair(this->lower_bound(v), this->upper_bound(v));
+  }
+
+  // Position of the first element equal to v.
+  size_type find(const value_type v) const {
+    const size_type pos = this->lower_bound(v);
+    return pos != this->size_ && this->at(pos) == v ? pos : this->size_;
+  }
+
+  // Element at position `pos` of the original sorted range.
+  const value_type& at(const size_type pos) const {
+    return this->nodes()[this->offset_[0] + pos];
+  }
+
+private:
+  typedef sml::algorithm::detail::_search_tree_node<T> node_type;
+
+  enum { NODE = node_type::SIZE };
+
+  static const value_type MAX;
+
+  // Nodes start at the first cache line boundary inside storage_, which
+  // keeps the layout valid across copies of the vector.
+  const value_type* nodes() const {
+    const std::size_t misalign =
+      reinterpret_cast<std::size_t>(&this->storage_[0]) % 64 / sizeof(T);
+    return &this->storage_[0] + (misalign ? NODE - misalign : 0);
+  }
+
+  value_type* nodes() {
+    return const_cast<value_type*>(
+      static_cast<const static_search_tree*>(this)->nodes()
+    );
+  }
+
+  void copy_nodes(const static_search_tree& other) {
+    if (other.storage_.empty()) return;
+    std::copy(
+      other.nodes(), other.nodes() + (other.storage_.size() - NODE),
+      this->nodes()
+    );
+  }
+
+  std::vector<value_type> storage_;
+  std::vector<size_type>  offset_;
+  size_type               size_;
+};
+
+template<class T>
+const T static_search_tree<T>::MAX = std::numeric_limits<T>::max();
+
+}} // namespace sml::algorithm
+
+#endif
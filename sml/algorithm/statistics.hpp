@@ -0,0 +1,231 @@
+#ifndef _SML_ALGORITHM_STATISTICS_HPP
+#define _SML_ALGORITHM_STATISTICS_HPP
+
+#include <cstddef>
+#include <limits>
+
+namespace sml { namespace algorithm {
+
+// Statistics a `statistics` accumulator keeps; the count is always kept.
+enum {
+  STAT_MIN      = 1,
+  STAT_MAX      = 2,
+  STAT_SUM      = 4,
+  STAT_MEAN     = 8,
+  STAT_VARIANCE = 16 | STAT_MEAN,
+  STAT_ALL      = STAT_MIN | STAT_MAX | STAT_SUM | STAT_VARIANCE
+};
+
+// One-pass accumulator of the statistics selected by `Stats`.  The sum is
+// compensated (Kahan), mean and variance follow Welford, and two
+// accumulators merge exactly as if one had seen both inputs (Chan et al.),
+// so chunks of a column can be summarized separately.  NaNs are skipped
+// and not counted.
+template<unsigned Stats = STAT_ALL>
+class statistics {
+public:
+  typedef std::size_t size_type;
+
+  statistics() :
+    count_(0),
+    min_(statistics::infinity()),
+    max_(-statistics::infinity()),
+    sum_(0.0),
+    carry_(0.0),
+    mean_(0.0),
+    m2_(0.0) {
+  }
+
+  void add(const double x) {
+    if (x != x) return;
+
+    ++this->count_;
+    if (Stats & STAT_MIN) this->min_ = x < this->min_ ? x : this->min_;
+    if (Stats & STAT_MAX) this->max_ = this->max_ < x ? x : this->max_;
+    if (Stats & STAT_SUM) this->add_to_sum(x);
+
+    if (Stats & STAT_MEAN) {
+      const double delta = x - this->mean_;
+      this->mean_ += delta / static_cast<double>(this->count_);
+      if (Stats & STAT_VARIANCE & ~STAT_MEAN) {
+        this->m2_ += delta * (x - this->mean_);
+      }
+    }
+  }
+
+  template<class Iterator>
+  statistics& add(Iterator first, const Iterator last) {
+    for (; first != last; ++first) this->add(static_cast<double>(*first));
+    return *this;
+  }
+
+  // Arrays are taken a block at a time: the block's compensated sum,
+  // minimum and maximum in one loop with independent accumulators, its
+  // squared deviations in a second loop while it is still in L1, and then
+  // the block is merged in.
+  template<class T>
+  statistics& add(T* first, T* const last) {
+    while (last - first >= BLOCK) {
+      this->add_block(first, first + BLOCK);
+      first += BLOCK;
+    }
+    for (; first != last; ++first) this->add(static_cast<double>(*first));
+    return *this;
+  }
+
+  statistics& merge(const statistics& other) {
+    if (other.count_ == 0) return *this;
+    if (this->count_ == 0) return *this = other;
+
+    const double n1 = static_cast<double>(this->count_);
+    const double n2 = static_cast<double>(other.count_);
+    const double n  = n1 + n2;
+
+    this->count_ += other.count_;
+    if (Stats & STAT_MIN) {
+      this->min_ = other.min_ < this->min_ ? other.min_ : this->min_;
+    }
+    if (Stats & STAT_MAX) {
+      this->max_ = this->max_ < other.max_ ? other.max_ : this->max_;
+    }
+    if (Stats & STAT_SUM) {
+      this->add_to_sum(other.sum_);
+      this->add_to_sum(-other.carry_);
+    }
+    if (Stats & STAT_MEAN) {
+      const double delta = other.mean_ - this->mean_;
+      this->mean_ += delta * n2 / n;
+      if (Stats & STAT_VARIANCE & ~STAT_MEAN) {
+        this->m2_ += other.m2_ + delta * delta * n1 * n2 / n;
+      }
+    }
+    return *this;
+  }
+
+  size_type count() const { return this->count_; }
+  double    min()   const { return this->min_; }
+  double    max()   const { return this->max_; }
+  double    sum()   const { return this->sum_ - this->carry_; }
+  double    mean()  const { return this->mean_; }
+
+  // Population variance; sample_variance() divides by count() - 1.
+  double variance() const {
+    return this->count_ > 0 ? this->m2_ / static_cast<double>(this->count_) : 0.0;
+  }
+
+  double sample_variance() const {
+    return
+      this->count_ > 1 ? this->m2_ / static_cast<double>(this->count_ - 1) : 0.0;
+  }
+
+private:
+  enum { BLOCK = 1024 };
+
+  static double infinity() {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  void add_to_sum(const double x) {
+    const double y = x - this->carry_;
+    const double t = this->sum_ + y;
+    this->carry_ = (t - this->sum_) - y;
+    this->sum_   = t;
+  }
+
+  // Accumulators for every fourth element of a block.
+  struct lane {
+    lane() :
+      count(0),
+      sum(0.0),
+      carry(0.0),
+      min(statistics::infinity()),
+      max(-statistics::infinity()) {
+    }
+
+    void add(const double x) {
+      const bool   valid = x == x;
+      const double y     = (valid ? x : 0.0) - this->carry;
+      const double t     = this->sum + y;
+
+      this->count += valid;
+      this->carry  = (t - this->sum) - y;
+      this->sum    = t;
+      if (Stats & STAT_MIN) this->min = x < this->min ? x : this->min;
+      if (Stats & STAT_MAX) this->max = this->max < x ? x : this->max;
+    }
+
+    size_type count;
+    double    sum;
+    double    carry;
+    double    min;
+    double    max;
+  };
+
+  template<class T>
+  void add_block(T* const first, T* const last) {
+    lane l0, l1, l2, l3;
+    for (T* it = first; it != last; it += 4) {
+      l0.add(static_cast<double>(it[0]));
+      l1.add(static_cast<double>(it[1]));
+      l2.add(static_cast<double>(it[2]));
+      l3.add(static_cast<double>(it[3]));
+    }
+
+    statistics block;
+    block.count_ = l0.count + l1.count + l2.count + l3.count;
+    if (block.count_ == 0) return;
+
+    const lane* const lanes[4] = {&l0, &l1, &l2, &l3};
+    for (int j = 0; j < 4; ++j) {
+      block.add_to_sum(lanes[j]->sum);
+      block.add_to_sum(-lanes[j]->carry);
+      block.min_ = lanes[j]->min < block.min_ ? lanes[j]->min : block.min_;
+      block.max_ = block.max_ < lanes[j]->max ? lanes[j]->max : block.max_;
+    }
+    block.mean_ = block.sum() / static_cast<double>(block.count_);
+
+    if (Stats & STAT_VARIANCE & ~STAT_MEAN) {
+      double m0 = 0.0, m1 = 0.0, m2 = 0.0, m3 = 0.0;
+      for (T* it = first; it != last; it += 4) {
+        m0 += this->square_deviation(it[0], block.mean_);
+        m1 += this->square_deviation(it[1], block.mean_);
+        m2 += this->square_deviation(it[2], block.mean_);
+        m3 += this->square_deviation(it[3], block.mean_);
+      }
+      block.m2_ = (m0 + m1) + (m2 + m3);
+    }
+
+    this->merge(block);
+  }
+
+  template<class T>
+  static double square_deviation(const T x, const double mean) {
+    const double d = static_cast<double>(x) - mean;
+    return d == d ? d * d : 0.0;
+  }
+
+  size_type count_;
+  double    min_;
+  double    max_;
+  double    sum_;
+  double    carry_;
+  double    mean_;
+  double    m2_;
+};
+
+template<unsigned Stats, class Iterator>
+statistics<Stats> summarize(const Iterator first, const Iterator last) {
+  statistics<Stats> stats;
+  stats.add(first, last);
+  return stats;
+}
+
+// All statistics of [first, last) in one pass.
+template<class Iterator>
+statistics<> summarize(const Iterator first, const Iterator last) {
+  return sml::algorithm::summarize<STAT_ALL>(first, last);
+}
+
+}} // namespace sml::algorithm
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef _SML_CONTAINER_BUCKET_POLICY_HPP
+#define _SML_CONTAINER_BUCKET_POLICY_HPP
+
+#include <cstddef>
+#include "sml/ext/cstdint.hpp"
+
+namespace sml { namespace container {
+
+// A bucket policy maps a hash to one of `bucket_count` buckets, and rounds
+// a requested bucket count to one it can map to.
+
+// hash % bucket_count: any bucket count, one integer division per lookup.
+struct modulo_bucket_policy {
+  static std::size_t bucket_count(std::size_t const n) {
+    return n;
+  }
+
+  static std::size_t index(
+    std::size_t const hash,
+    std::size_t const bucket_count
+  ) {
+    return hash % bucket_count;
+  }
+};
+
+// Bucket counts rounded up to powers of two, indexed by masking.  The hash
+// goes through a full 64-bit finalizer (MurmurHash3's fmix64) first, so
+// that every bit of it reaches the masked ones: hashers with weak low bits
+// (the identity on integers, pointers) or hashes differing only in their
+// high bits still spread over the buckets.  Masking keeps the index of a
+// hash in n buckets the low bits of its index in 2n, which the concurrent
+// tables rely on when they split buckets and stripes.
+struct power_of_two_bucket_policy {
+  static std::size_t bucket_count(std::size_t const n) {
+    std::size_t count = 1;
+    while (count < n) count <<= 1;
+    return count;
+  }
+
+  static std::size_t index(
+    std::size_t const hash,
+    std::size_t const bucket_count
+  ) {
+    sml::ext::uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h) & (bucket_count - 1);
+  }
+};
+
+namespace detail {
+
+template<std::size_t Bytes>
+struct _multiply_high;
+
+template<>
+struct _multiply_high<4> {
+  static std::size_t apply(std::size_t const a, std::size_t const b) {
+    return static_cast<std::size_t>(
+      (static_cast<sml::ext::uint64_t>(a) * b) >> 32
+    );
+  }
+};
+
+template<>
+struct _multiply_high<8> {
+  static std::size_t apply(std::size_t const a, std::size_t const b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    return static_cast<std::size_t>((static_cast<uint128>(a) * b) >> 64);
+#else
+    sml::ext::uint64_t const a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+    sml::ext::uint64_t const b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+
+    sml::ext::uint64_t const lo_lo = a_lo * b_lo;
+    sml::ext::uint64_t const hi_lo = a_hi * b_lo;
+    sml::ext::uint64_t const lo_hi = a_lo * b_hi;
+
+    sml::ext::uint64_t const mid =
+      (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + (lo_hi & 0xffffffffULL);
+    return static_cast<std::size_t>(
+      a_hi * b_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32)
+    );
+#endif
+  }
+};
+
+} // namespace detail
+
+// Lemire's fast range reduction: the high word of hash * bucket_count.  Any
+// bucket count, one multiplication per lookup; the bucket comes from the
+// high bits of the hash, so the hasher must spread its results over the
+// whole word.
+struct fastrange_bucket_policy {
+  static std::size_t bucket_count(std::size_t const n) {
+    return n;
+  }
+
+  static std::size_t index(
+    std::size_t const hash,
+    std::size_t const bucket_count
+  ) {
+    return detail::_multiply_high<sizeof(std::size_t)>::apply(
+      hash, bucket_count
+    );
+  }
+};
+
+}} // namespace sml::container
+
+#endif
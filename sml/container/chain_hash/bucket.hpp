@@ -11,7 +11,7 @@ private:
   typedef typename types::const_element_ptr const_element_ptr;
   typedef typename types::size_type         size_type;
 
-  typedef typename types::element_allocator_type element_allocator_type;
+  typedef typename types::element_pool_type element_pool_type;
 
 public:
   bucket() :
@@ -39,11 +39,18 @@ public:
     if (next) next->prev(prev);
   }
 
-  void clear(element_allocator_type& allocator) {
+  // Unhooks the chain, leaving the bucket empty; returns its head.
+  element_ptr release() {
+    element_ptr const head = this->head_;
+    this->head_ = element_ptr();
+    return head;
+  }
+
+  void clear(element_pool_type& pool) {
     element_ptr iter = this->head_;
     while (iter) {
       element_ptr next = iter->next();
-      allocator.destroy(1, iter);
+      pool.destroy(iter);
       iter = next;
     }
 
@@ -1,6 +1,10 @@
 #ifndef _SML_CONTAINER_CHAIN_HASH_ELEMENT_HPP
 #define _SML_CONTAINER_CHAIN_HASH_ELEMENT_HPP
 
+#if __cplusplus >= 201103L
+#include <utility>
+#endif
+
 namespace sml { namespace container { namespace chain_hash_detail {
 
 template<class Types>
@@ -19,13 +23,32 @@ public:
   typedef typename types::const_pointer   const_value_ptr;
   typedef typename types::reference       value_reference;
   typedef typename types::const_reference const_value_reference;
+  typedef typename types::size_type       hash_type;
+
+  element(const_value_reference v, hash_type const hash) :
+    value_(v),
+    hash_(hash) {
+  }
 
-  explicit element(const_value_reference v) :
-    value_(v) {
+  // The value built in place from the arguments of one of its
+  // constructors.
+#if __cplusplus >= 201103L
+  template<class... Args>
+  explicit element(hash_type const hash, Args&&... args) :
+    value_(std::forward<Args>(args)...),
+    hash_(hash) {
+  }
+#else
+  template<class A, class B>
+  element(hash_type const hash, A const& a, B const& b) :
+    value_(a, b),
+    hash_(hash) {
   }
+#endif
 
   element(element const& r) :
     value_(r.value_),
+    hash_(r.hash_),
     next_(r.next_),
     prev_(r.prev_) {
   }
@@ -36,11 +59,26 @@ public:
   value_ptr       value_address() { return &(this->value_); }
   const_value_ptr value_address() const { return &(this->value_); }
 
+  // The hasher's result for the key, kept so that a rehash need not call
+  // the hasher again and a lookup can skip keys whose hash differs.
+  hash_type hash() const { return this->hash_; }
+
+  void hash(hash_type const hash) { this->hash_ = hash; }
+
   element_ptr       next()       { return this->next_; }
   const_element_ptr next() const { return this->next_; }
 
   void next(element_ptr next) { this->next_ = next; }
 
+  // next() and next(p) for chains that readers walk without a lock while
+  // one writer links and unlinks elements.
+  const_element_ptr load_next() const {
+    return __atomic_load_n(&this->next_, __ATOMIC_ACQUIRE);
+  }
+  void store_next(element_ptr next) {
+    __atomic_store_n(&this->next_, next, __ATOMIC_RELEASE);
+  }
+
   element_ptr       prev()       { return this->prev_; }
   const_element_ptr prev() const { return this->prev_; }
 
@@ -50,6 +88,7 @@ private:
   element_reference operator=(element const& r) {}
 
   value_type  value_;
+  hash_type   hash_;
   element_ptr next_;
   element_ptr prev_;
 };
@@ -4,6 +4,7 @@
 #include <utility>
 #include <cstddef>
 #include "sml/memory/allocator.hpp"
+#include "sml/memory/object_pool.hpp"
 
 namespace sml { namespace container { namespace chain_hash_detail {
 
@@ -31,14 +32,22 @@ class table_iterator;
 template<class Types>
 class const_table_iterator;
 
-template<class Key, class T, class Hash, class Pred, class Alloc>
+template<
+  class Key,
+  class T,
+  class Hash,
+  class Pred,
+  class Alloc,
+  class BucketPolicy
+>
 struct map_types {
 
-  typedef Key   key_type;
-  typedef T     mapped_type;
-  typedef Hash  hasher;
-  typedef Pred  key_equal;
-  typedef Alloc allocator_type;
+  typedef Key          key_type;
+  typedef T            mapped_type;
+  typedef Hash         hasher;
+  typedef Pred         key_equal;
+  typedef Alloc        allocator_type;
+  typedef BucketPolicy bucket_policy;
 
   typedef std::pair<key_type const, mapped_type> value_type;
   typedef value_type const                       const_value_type;
@@ -70,10 +79,10 @@ struct map_types {
     bucket_allocator_type;
 
   typedef
-    sml::memory::allocator<
+    sml::memory::object_pool<
       typename allocator_type::template rebind<element_type>::other
     >
-    element_allocator_type;
+    element_pool_type;
 
   typedef
     typename sml::container::chain_hash_detail::bucket_iterator_base<
@@ -1,10 +1,16 @@
 #ifndef _SML_CONTAINER_CHAIN_HASH_TABLE_HPP
 #define _SML_CONTAINER_CHAIN_HASH_TABLE_HPP
 
+#include <new>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 #include <cstddef>
+#if __cplusplus >= 201103L
+#include <tuple>
+#endif
 #include "sml/iterator/next.hpp"
+#include "sml/parallel/parallel_for.hpp"
 #include "sml/utility/noncopyable.hpp"
 
 namespace sml { namespace container { namespace chain_hash_detail {
@@ -25,6 +31,7 @@ public:
   typedef typename types::hasher                 hasher;
   typedef typename types::key_equal              key_equal;
   typedef typename types::allocator_type         allocator_type;
+  typedef typename types::bucket_policy          bucket_policy;
 
   typedef typename types::bucket_type            bucket_type;
   typedef typename types::bucket_ptr             bucket_ptr;
@@ -34,7 +41,7 @@ public:
   typedef typename types::element_type           element_type;
   typedef typename types::element_ptr            element_ptr;
   typedef typename types::const_element_ptr      const_element_ptr;
-  typedef typename types::element_allocator_type element_allocator_type;
+  typedef typename types::element_pool_type      element_pool_type;
 
   typedef
     sml::container::chain_hash_detail::table_iterator<types>
@@ -84,10 +91,15 @@ public:
     array_(),
     size_(),
     bucket_count_(),
+    old_array_(),
+    old_bucket_count_(),
+    migrated_(),
+    rehash_step_(),
     max_load_factor_(max_load_factor),
     hasher_(hasher),
     key_eq_(key_eq),
-    allocator_(allocator) {
+    allocator_(allocator),
+    pool_(allocator) {
     this->reconstruct(n);
   }
 
@@ -97,10 +109,15 @@ public:
     array_(),
     size_(),
     bucket_count_(),
+    old_array_(),
+    old_bucket_count_(),
+    migrated_(),
+    rehash_step_(r.rehash_step_),
     max_load_factor_(r.max_load_factor_),
     hasher_(r.hasher_),
     key_eq_(r.key_eq_),
-    allocator_(r.allocator_) {
+    allocator_(r.allocator_),
+    pool_(r.allocator_) {
     Destroyer destroyer(*this);
     this->copy_table(r);
     destroyer.release();
@@ -112,10 +129,15 @@ public:
     array_(),
     size_(),
     bucket_count_(),
+    old_array_(),
+    old_bucket_count_(),
+    migrated_(),
+    rehash_step_(r.rehash_step_),
     max_load_factor_(r.max_load_factor_),
     hasher_(r.hasher_),
     key_eq_(r.key_eq_),
-    allocator_(allocator) {
+    allocator_(allocator),
+    pool_(allocator) {
     Destroyer destroyer(*this);
     this->copy_table(r);
     destroyer.release();
@@ -126,9 +148,25 @@ public:
   }
 
   iterator begin() {
+    if (this->old_array_) {
+      return iterator(
+        this->old_array_ + static_cast<std::ptrdiff_t>(this->migrated_),
+        this->end_old_bucket(),
+        this->array_,
+        this->end_bucket()
+      );
+    }
     return iterator(this->array_, this->end_bucket());
   }
   const_iterator begin() const {
+    if (this->old_array_) {
+      return const_iterator(
+        this->old_array_ + static_cast<std::ptrdiff_t>(this->migrated_),
+        this->end_old_bucket(),
+        this->array_,
+        this->end_bucket()
+      );
+    }
     return const_iterator(this->array_, this->end_bucket());
   }
 
@@ -182,13 +220,153 @@ public:
   allocator_type const& get_allocator() const { return this->allocator_; }
 
   std::pair<iterator, bool> insert(value_type const& v) {
-    iterator pos = this->find(v.first);
+    this->migrate(this->rehash_step_);
+
+    size_type const hash = this->hash_function()(v.first);
+    const_iterator pos = this->find_in_table(v.first, hash);
+
     return pos == this->end() ?
-      std::make_pair(this->insert_and_rehash(v), true) :
-      std::make_pair(pos, false);
+      std::make_pair(this->emplace_and_rehash(hash, v), true) :
+      std::make_pair(table_type::to_iterator(pos), false);
+  }
+
+  // Each of these hashes the key once, walks its chain once and builds
+  // the value straight in its element; try_emplace and insert_or_assign
+  // build nothing when the key is already there.  Without rvalue
+  // references the mapped value is still copied once into the pair.
+#if __cplusplus >= 201103L
+  std::pair<iterator, bool> insert(value_type&& v) {
+    this->migrate(this->rehash_step_);
+
+    size_type const hash = this->hash_function()(v.first);
+    const_iterator pos = this->find_in_table(v.first, hash);
+
+    return pos == this->end() ?
+      std::make_pair(this->emplace_and_rehash(hash, std::move(v)), true) :
+      std::make_pair(table_type::to_iterator(pos), false);
+  }
+
+  template<class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    this->migrate(this->rehash_step_);
+    return this->insert_element(
+      this->make_element(0, std::forward<Args>(args)...)
+    );
   }
 
-  size_type erase(key_type const& key) {
+  template<class K, class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    this->migrate(this->rehash_step_);
+
+    size_type const hash = this->hash_function()(key);
+    const_iterator pos = this->find_in_table(key, hash);
+    if (pos != this->end()) {
+      return std::make_pair(table_type::to_iterator(pos), false);
+    }
+
+    return std::make_pair(
+      this->emplace_and_rehash(
+        hash,
+        std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...)
+      ),
+      true
+    );
+  }
+
+  template<class K, class M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& mapped) {
+    this->migrate(this->rehash_step_);
+
+    size_type const hash = this->hash_function()(key);
+    const_iterator pos = this->find_in_table(key, hash);
+    if (pos != this->end()) {
+      pos.base_.current()->value().second = std::forward<M>(mapped);
+      return std::make_pair(table_type::to_iterator(pos), false);
+    }
+
+    return std::make_pair(
+      this->emplace_and_rehash(
+        hash, std::forward<K>(key), std::forward<M>(mapped)
+      ),
+      true
+    );
+  }
+#else
+  template<class A, class B>
+  std::pair<iterator, bool> emplace(A const& a, B const& b) {
+    this->migrate(this->rehash_step_);
+    return this->insert_element(this->make_element(0, a, b));
+  }
+
+  std::pair<iterator, bool> try_emplace(key_type const& key) {
+    return this->try_emplace(key, mapped_type());
+  }
+
+  template<class A>
+  std::pair<iterator, bool> try_emplace(key_type const& key, A const& a) {
+    this->migrate(this->rehash_step_);
+
+    size_type const hash = this->hash_function()(key);
+    const_iterator pos = this->find_in_table(key, hash);
+
+    return pos == this->end() ?
+      std::make_pair(this->emplace_and_rehash(hash, key, a), true) :
+      std::make_pair(table_type::to_iterator(pos), false);
+  }
+
+  template<class M>
+  std::pair<iterator, bool> insert_or_assign(
+    key_type const& key,
+    M        const& mapped
+  ) {
+    this->migrate(this->rehash_step_);
+
+    size_type const hash = this->hash_function()(key);
+    const_iterator pos = this->find_in_table(key, hash);
+    if (pos != this->end()) {
+      pos.base_.current()->value().second = mapped;
+      return std::make_pair(table_type::to_iterator(pos), false);
+    }
+
+    return std::make_pair(this->emplace_and_rehash(hash, key, mapped), true);
+  }
+#endif
+
+  // Inserts [first, last) on up to `threads` threads, 0 meaning one per
+  // hardware thread.  The buckets are grown once for the whole input, the
+  // input is hashed in parallel and partitioned by bucket range, and each
+  // range's chains are built by one thread.  A key met again, whether in
+  // the table or earlier in the input, is passed to combine(mapped,
+  // incoming) instead, in input order whatever the thread count.  The
+  // hasher, key_eq and combine are called concurrently; an exception they
+  // throw on a worker thread terminates the program.
+  template<class RandomAccessIterator, class Combine>
+  void bulk_insert(
+    RandomAccessIterator const first,
+    RandomAccessIterator const last,
+    unsigned                   threads,
+    Combine              const combine
+  ) {
+    size_type const n = static_cast<size_type>(last - first);
+    if (n == 0) return;
+
+    this->complete_rehash();
+    this->reserve_more(n);
+
+    if (threads == 0) threads = sml::parallel::hardware_concurrency();
+
+    bulk_build<RandomAccessIterator, Combine> build(
+      *this, first, n, threads, combine
+    );
+    build.run(threads);
+  }
+
+  // Lookups by key take any K the hasher and key_eq accept; the map only
+  // passes other types than key_type when both are transparent.
+  template<class K>
+  size_type erase_key(K const& key) {
     iterator pos(this->find(key));
 
     if (pos == this->end()) {
@@ -214,34 +392,50 @@ public:
   }
 
   void clear() {
-    element_allocator_type allocator(this->get_allocator());
+    if (this->old_array_) {
+      for (
+        size_type idx = this->migrated_;
+        idx < this->old_bucket_count_;
+        ++idx
+      ) {
+        this->old_array_[idx].clear(this->pool_);
+      }
+      this->complete_rehash();
+    }
 
     for (size_type idx = 0; idx < this->bucket_count(); ++idx) {
-      this->get(idx)->clear(allocator);
+      this->get(idx)->clear(this->pool_);
     }
 
     this->size_ = 0;
+    this->pool_.purge();
   }
 
-  mapped_type& at(key_type const& key) {
+  template<class K>
+  mapped_type& at(K const& key) {
     return table_type::at(this->find(key), this->end());
   }
 
-  mapped_type const& at(key_type const& key) const {
+  template<class K>
+  mapped_type const& at(K const& key) const {
     return table_type::at(this->find(key), this->end());
   }
 
-  iterator find(key_type const& key) {
+  template<class K>
+  iterator find(K const& key) {
+    this->migrate(this->rehash_step_);
+
     const_iterator pos = static_cast<table const&>(*this).find(key);
     return table_type::to_iterator(pos);
   }
 
-  const_iterator find(key_type const& key) const {
-    bucket_ptr const bucket = this->get(this->bucket(key));
-    return this->find_in_bucket(bucket, key);
+  template<class K>
+  const_iterator find(K const& key) const {
+    return this->find_in_table(key, this->hash_function()(key));
   }
 
-  size_type count(key_type const& key) const {
+  template<class K>
+  size_type count(K const& key) const {
     return this->find(key) == this->end() ? 0 : 1;
   }
 
@@ -254,7 +448,7 @@ public:
   }
 
   size_type bucket(key_type const& key) const {
-    return table_type::bucket(this->hash_function(), this->bucket_count(), key);
+    return this->index(this->hash_function()(key));
   }
 
   size_type bucket_size(size_type const idx) const {
@@ -276,9 +470,34 @@ public:
     );
   }
 
-  std::pair<const_iterator, const_iterator> equal_range(
-    key_type const& key
-  ) const {
+  // Grows the buckets once for `n` more elements, unless they already
+  // have room; never shrinks them.
+  void reserve_more(size_type const n) {
+    size_type const count = table_type::minimum_bucket_count(
+      this->size() + n, this->max_load_factor()
+    );
+    if (count > this->bucket_count()) this->reserve(this->size() + n);
+  }
+
+  size_type rehash_step() const {
+    return this->rehash_step_;
+  }
+
+  // With a nonzero step a growth only starts a rehash: insert, find and
+  // erase by key each move `step` buckets of the old array, and lookups
+  // search both arrays until it is empty.
+  void rehash_step(size_type const step) {
+    this->rehash_step_ = step;
+    if (step == 0) this->complete_rehash();
+  }
+
+  // Moves every element still in the old bucket array.
+  void complete_rehash() {
+    if (this->old_array_) this->migrate(this->old_bucket_count_);
+  }
+
+  template<class K>
+  std::pair<const_iterator, const_iterator> equal_range(K const& key) const {
     const_iterator pos = this->find(key);
     const_iterator next = pos == this->end() ?
       this->end() : sml::iterator::next(pos);
@@ -286,7 +505,8 @@ public:
     return std::make_pair(pos, next);
   }
 
-  std::pair<iterator, iterator> equal_range(key_type const& key) {
+  template<class K>
+  std::pair<iterator, iterator> equal_range(K const& key) {
     std::pair<const_iterator, const_iterator> range =
       static_cast<table const&>(*this).equal_range(key);
 
@@ -319,17 +539,7 @@ public:
   }
 
   mapped_type& access(key_type const& key) {
-    bucket_ptr const bucket = this->get(this->bucket(key));
-    const_iterator pos =
-      static_cast<table const&>(*this).find_in_bucket(bucket, key);
-
-    if (pos == this->end()) {
-      return this->insert_and_rehash(bucket, std::make_pair(key, mapped_type()))
-                 ->second;
-    }
-    else {
-      return pos.base_.current()->value().second;
-    }
+    return this->try_emplace(key).first->second;
   }
 
   bool equal(table const& tbl) const {
@@ -356,11 +566,178 @@ public:
   }
 
 private:
+  // The state of one bulk_insert(), run as three parallel_for passes over
+  // it: hash every input and count, per input chunk, the inputs bound for
+  // each bucket range; scatter the input indices so that each range's come
+  // together, in input order; link each range's elements.  Element slots
+  // are taken from the pool beforehand, one per input, and the unused ones
+  // given back at the end.
+  template<class RandomAccessIterator, class Combine>
+  class bulk_build : sml::utility::noncopyable {
+  public:
+    bulk_build(
+      table&                     tbl,
+      RandomAccessIterator const first,
+      size_type            const n,
+      unsigned             const threads,
+      Combine              const combine
+    ) :
+      tbl_(&tbl),
+      first_(first),
+      n_(n),
+      chunks_(n < threads * 4u ? n : threads * 4u),
+      width_(),
+      ranges_(),
+      pass_(),
+      hashes_(n),
+      order_(n),
+      counts_(),
+      begins_(),
+      slots_(n),
+      used_(n),
+      combine_(combine) {
+      size_type const buckets = tbl.bucket_count();
+      this->width_  = (buckets + this->chunks_ - 1) / this->chunks_;
+      this->ranges_ = (buckets + this->width_ - 1) / this->width_;
+      this->counts_.resize(this->chunks_ * this->ranges_);
+      this->begins_.resize(this->ranges_ + 1);
+
+      size_type taken = 0;
+      try {
+        for (; taken < n; ++taken) {
+          this->slots_[taken] = tbl.pool_.allocate_slot();
+        }
+      }
+      catch (...) {
+        while (taken) tbl.pool_.deallocate_slot(this->slots_[--taken]);
+        throw;
+      }
+    }
+
+    // Counts the linked elements even if the last pass threw.
+    ~bulk_build() {
+      for (size_type i = 0; i < this->n_; ++i) {
+        if (this->used_[i]) ++this->tbl_->size_;
+        else this->tbl_->pool_.deallocate_slot(this->slots_[i]);
+      }
+    }
+
+    void run(unsigned const threads) {
+      this->pass_ = HASH;
+      sml::parallel::parallel_for(this->chunks_, threads, *this);
+
+      // counts_ become each chunk's first position in order_ for a range.
+      size_type position = 0;
+      for (size_type r = 0; r < this->ranges_; ++r) {
+        this->begins_[r] = position;
+        for (size_type c = 0; c < this->chunks_; ++c) {
+          size_type const count = this->counts_[c * this->ranges_ + r];
+          this->counts_[c * this->ranges_ + r] = position;
+          position += count;
+        }
+      }
+      this->begins_[this->ranges_] = position;
+
+      this->pass_ = SCATTER;
+      sml::parallel::parallel_for(this->chunks_, threads, *this);
+
+      this->pass_ = LINK;
+      sml::parallel::parallel_for(this->ranges_, threads, *this);
+    }
+
+    void operator()(std::size_t const task) {
+      switch (this->pass_) {
+      case HASH:    this->hash(task);    break;
+      case SCATTER: this->scatter(task); break;
+      case LINK:    this->link(task);    break;
+      }
+    }
+
+  private:
+    enum pass { HASH, SCATTER, LINK };
+
+    void hash(size_type const chunk) {
+      size_type* const counts = &this->counts_[chunk * this->ranges_];
+      for (
+        size_type i = this->chunk_begin(chunk);
+        i != this->chunk_begin(chunk + 1);
+        ++i
+      ) {
+        size_type const hash =
+          this->tbl_->hash_function()(this->first_[i].first);
+        this->hashes_[i] = hash;
+        ++counts[this->range_of(hash)];
+      }
+    }
+
+    void scatter(size_type const chunk) {
+      size_type* const positions = &this->counts_[chunk * this->ranges_];
+      for (
+        size_type i = this->chunk_begin(chunk);
+        i != this->chunk_begin(chunk + 1);
+        ++i
+      ) {
+        this->order_[positions[this->range_of(this->hashes_[i])]++] = i;
+      }
+    }
+
+    // Only this task touches the buckets of the range, and the slots of
+    // the inputs bound for it.
+    void link(size_type const range) {
+      for (
+        size_type k = this->begins_[range];
+        k != this->begins_[range + 1];
+        ++k
+      ) {
+        size_type const i    = this->order_[k];
+        size_type const hash = this->hashes_[i];
+
+        bucket_ptr  const bucket = this->tbl_->get(this->tbl_->index(hash));
+        element_ptr const elem   =
+          this->tbl_->find_in_bucket(bucket, this->first_[i].first, hash);
+        if (elem) {
+          this->combine_(elem->value().second, this->first_[i].second);
+          continue;
+        }
+
+        ::new (static_cast<void*>(this->slots_[i]))
+          element_type(hash, this->first_[i].first, this->first_[i].second);
+        bucket->push_front(this->slots_[i]);
+        this->used_[i] = 1;
+      }
+    }
+
+    size_type chunk_begin(size_type const chunk) const {
+      size_type const base  = this->n_ / this->chunks_;
+      size_type const extra = this->n_ % this->chunks_;
+      return base * chunk + (chunk < extra ? chunk : extra);
+    }
+
+    size_type range_of(size_type const hash) const {
+      return this->tbl_->index(hash) / this->width_;
+    }
+
+    table*                   tbl_;
+    RandomAccessIterator     first_;
+    size_type                n_;
+    size_type                chunks_;
+    size_type                width_;
+    size_type                ranges_;
+    pass                     pass_;
+    std::vector<size_type>   hashes_;
+    std::vector<size_type>   order_;
+    std::vector<size_type>   counts_;
+    std::vector<size_type>   begins_;
+    std::vector<element_ptr> slots_;
+    std::vector<char>        used_;
+    Combine                  combine_;
+  };
+
   void copy_table(table const& tbl) {
     this->reserve(tbl.size());
 
     for (const_iterator iter = tbl.begin(); iter != tbl.end(); ++iter) {
-      this->naive_insert(*iter);
+      this->naive_insert(*iter, iter.base_.current()->hash());
     }
   }
 
@@ -372,7 +749,16 @@ private:
     return this->array_ + static_cast<std::ptrdiff_t>(this->bucket_count());
   }
 
-  void reconstruct(size_type const bucket_count) {
+  const_bucket_ptr end_old_bucket() const {
+    return
+      this->old_array_ + static_cast<std::ptrdiff_t>(this->old_bucket_count_);
+  }
+
+  void reconstruct(size_type const n) {
+    this->complete_rehash();
+
+    size_type const bucket_count = bucket_policy::bucket_count(n);
+
     bucket_allocator_type allocator(this->get_allocator());
     allocator.construct(bucket_count, bucket_type());
 
@@ -382,17 +768,7 @@ private:
       bucket_iter != this->end_bucket();
       ++bucket_iter
     ) {
-      for (element_ptr elem_iter = bucket_iter->head(); elem_iter; ) {
-        element_ptr const next = elem_iter->next();
-        size_type   const idx  = table_type::bucket(
-          this->hash_function(),
-          bucket_count,
-          elem_iter->value().first
-        );
-
-        new_array[idx].push_front(elem_iter);
-        elem_iter = next;
-      }
+      table_type::relink(bucket_iter->head(), new_array, bucket_count);
     }
 
     allocator.destroy(this->bucket_count_, this->array_);
@@ -402,70 +778,242 @@ private:
     this->bucket_count_ = bucket_count;
   }
 
-  const_iterator find_in_bucket(
-    bucket_ptr const  bucket,
-    key_type   const& key
-  ) const  {
-    const_local_iterator const end;
+  // Swaps in an empty bucket array and keeps the current one aside, to be
+  // emptied by migrate().
+  void start_rehash(size_type const n) {
+    this->complete_rehash();
 
-    for (const_local_iterator iter(bucket); iter != end; ++iter) {
-      if (this->key_eq()(iter->first, key)) {
+    size_type const bucket_count = bucket_policy::bucket_count(n);
 
-        return const_iterator(
-          bucket + static_cast<std::ptrdiff_t>(1),
-          this->end_bucket(),
-          iter.base_.current()
-        );
+    bucket_allocator_type allocator(this->get_allocator());
+    allocator.construct(bucket_count, bucket_type());
 
-      }
+    this->old_array_        = this->array_;
+    this->old_bucket_count_ = this->bucket_count_;
+    this->migrated_         = 0;
+
+    this->array_        = allocator.release();
+    this->bucket_count_ = bucket_count;
+  }
+
+  // Moves the next `buckets` old buckets into the current array, and frees
+  // the old array once it is empty.
+  void migrate(size_type buckets) {
+    if (!this->old_array_) return;
+
+    for (
+      ;
+      buckets != 0 && this->migrated_ != this->old_bucket_count_;
+      --buckets, ++this->migrated_
+    ) {
+      table_type::relink(
+        this->old_array_[this->migrated_].release(),
+        this->array_,
+        this->bucket_count_
+      );
+    }
+
+    if (this->migrated_ == this->old_bucket_count_) {
+      bucket_allocator_type(this->get_allocator())
+        .destroy(this->old_bucket_count_, this->old_array_);
+
+      this->old_array_        = bucket_ptr();
+      this->old_bucket_count_ = 0;
+      this->migrated_         = 0;
     }
+  }
+
+  static void relink(
+    element_ptr       elem,
+    bucket_ptr  const array,
+    size_type   const bucket_count
+  ) {
+    while (elem) {
+      element_ptr const next = elem->next();
+      size_type   const idx  = table_type::index(elem->hash(), bucket_count);
 
-    return this->end();
+      array[idx].push_front(elem);
+      elem = next;
+    }
   }
 
-  iterator insert_and_rehash(value_type const& v) {
-    bucket_ptr const bucket = this->get(this->bucket(v.first));
-    return this->insert_and_rehash(bucket, v);
+  // Searches the old bucket array, while a rehash is in progress, and then
+  // the current one.
+  template<class K>
+  const_iterator find_in_table(K const& key, size_type const hash) const {
+    if (this->old_array_) {
+      size_type const idx = table_type::index(hash, this->old_bucket_count_);
+
+      if (idx >= this->migrated_) {
+        bucket_ptr  const bucket = this->old_array_ + idx;
+        element_ptr const elem   = this->find_in_bucket(bucket, key, hash);
+
+        if (elem) {
+          return const_iterator(
+            bucket + static_cast<std::ptrdiff_t>(1),
+            this->end_old_bucket(),
+            elem,
+            this->array_,
+            this->end_bucket()
+          );
+        }
+      }
+    }
+
+    bucket_ptr  const bucket = this->get(this->index(hash));
+    element_ptr const elem   = this->find_in_bucket(bucket, key, hash);
+
+    return elem ?
+      const_iterator(
+        bucket + static_cast<std::ptrdiff_t>(1),
+        this->end_bucket(),
+        elem
+      ) :
+      this->end();
   }
 
-  iterator insert_and_rehash(bucket_ptr bucket, value_type const& v) {
-    element_allocator_type allocator(this->get_allocator());
-    allocator.construct(1, element_type(v));
+  template<class K>
+  element_ptr find_in_bucket(
+    bucket_ptr const  bucket,
+    K          const& key,
+    size_type  const  hash
+  ) const  {
+    for (element_ptr elem = bucket->head(); elem; elem = elem->next()) {
+      if (elem->hash() == hash && this->key_eq()(elem->value().first, key)) {
+        return elem;
+      }
+    }
+
+    return element_ptr();
+  }
 
+  // Grows the table, if one more element would exceed the load factor,
+  // before the element is built, so that a failed growth leaks nothing.
+  void reserve_one_more() {
     float const future_load_factor =
       table_type::load_factor(this->size()+1, this->bucket_count());
 
     if (future_load_factor > this->max_load_factor()) {
       double const new_size =
         static_cast<double>(this->size()) * INCREMENT_RATE;
-      this->reconstruct(static_cast<size_type>(new_size));
 
-      bucket = this->get(this->bucket(v.first));
+      if (this->rehash_step_) {
+        this->start_rehash(static_cast<size_type>(new_size));
+      }
+      else {
+        this->reconstruct(static_cast<size_type>(new_size));
+      }
     }
+  }
+
+#if __cplusplus >= 201103L
+  template<class... Args>
+  iterator emplace_and_rehash(size_type const hash, Args&&... args) {
+    this->reserve_one_more();
+    return this->insert_into_bucket(
+      this->get(this->index(hash)),
+      this->make_element(hash, std::forward<Args>(args)...)
+    );
+  }
+
+  template<class... Args>
+  element_ptr make_element(size_type const hash, Args&&... args) {
+    element_ptr const elem = this->pool_.allocate_slot();
+    try {
+      ::new (static_cast<void*>(elem))
+        element_type(hash, std::forward<Args>(args)...);
+    }
+    catch (...) {
+      this->pool_.deallocate_slot(elem);
+      throw;
+    }
+    return elem;
+  }
+#else
+  iterator emplace_and_rehash(size_type const hash, value_type const& v) {
+    this->reserve_one_more();
+    return this->insert_into_bucket(
+      this->get(this->index(hash)), this->make_element(hash, v)
+    );
+  }
 
-    element_ptr const elem = allocator.release();
-    return this->insert_into_bucket(bucket, elem);
+  template<class A, class B>
+  iterator emplace_and_rehash(size_type const hash, A const& a, B const& b) {
+    this->reserve_one_more();
+    return this->insert_into_bucket(
+      this->get(this->index(hash)), this->make_element(hash, a, b)
+    );
   }
 
-  iterator naive_insert(value_type const& v) {
-    bucket_ptr const bucket = this->get(this->bucket(v.first));
-    return this->insert_into_bucket(bucket, v);
+  element_ptr make_element(size_type const hash, value_type const& v) {
+    element_ptr const elem = this->pool_.allocate_slot();
+    try {
+      ::new (static_cast<void*>(elem)) element_type(v, hash);
+    }
+    catch (...) {
+      this->pool_.deallocate_slot(elem);
+      throw;
+    }
+    return elem;
   }
 
-  iterator insert_into_bucket(bucket_ptr const bucket, value_type const& v) {
-    element_allocator_type allocator(this->get_allocator());
-    allocator.construct(1, element_type(v));
+  template<class A, class B>
+  element_ptr make_element(size_type const hash, A const& a, B const& b) {
+    element_ptr const elem = this->pool_.allocate_slot();
+    try {
+      ::new (static_cast<void*>(elem)) element_type(hash, a, b);
+    }
+    catch (...) {
+      this->pool_.deallocate_slot(elem);
+      throw;
+    }
+    return elem;
+  }
+#endif
 
-    element_ptr const elem = allocator.release();
+  // Links an element built before its key was hashed, unless the key is
+  // already there, when the element is destroyed instead.
+  std::pair<iterator, bool> insert_element(element_ptr const elem) {
+    try {
+      size_type const hash = this->hash_function()(elem->value().first);
+      const_iterator pos = this->find_in_table(elem->value().first, hash);
+      if (pos != this->end()) {
+        this->pool_.destroy(elem);
+        return std::make_pair(table_type::to_iterator(pos), false);
+      }
 
-    return this->insert_into_bucket(bucket, elem);
+      elem->hash(hash);
+      this->reserve_one_more();
+      return std::make_pair(
+        this->insert_into_bucket(this->get(this->index(hash)), elem), true
+      );
+    }
+    catch (...) {
+      this->pool_.destroy(elem);
+      throw;
+    }
+  }
+
+  iterator naive_insert(value_type const& v, size_type const hash) {
+    bucket_ptr const bucket = this->get(this->index(hash));
+    return this->insert_into_bucket(bucket, v, hash);
+  }
+
+  iterator insert_into_bucket(
+    bucket_ptr const  bucket,
+    value_type const& v,
+    size_type  const  hash
+  ) {
+    return this->insert_into_bucket(bucket, this->make_element(hash, v));
   }
 
   iterator insert_into_bucket(bucket_ptr const bucket, element_ptr const elem) {
     bucket->push_front(elem);
     ++this->size_;
 
-    return iterator(bucket, this->end_bucket(), elem);
+    return iterator(
+      bucket + static_cast<std::ptrdiff_t>(1), this->end_bucket(), elem
+    );
   }
 
   void naive_erase(const_iterator pos) {
@@ -476,26 +1024,31 @@ private:
     (bucket)->erase(target);
 
     --this->size_;
-    element_allocator_type(this->get_allocator()).destroy(1, target);
+    this->pool_.destroy(target);
   }
 
   void naive_swap(table& tbl) {
     using std::swap;
 
-    swap(this->array_,           tbl.array_);
-    swap(this->size_,            tbl.size_);
-    swap(this->bucket_count_,    tbl.bucket_count_);
-    swap(this->max_load_factor_, tbl.max_load_factor_);
-    swap(this->hasher_,          tbl.hasher_);
-    swap(this->key_eq_,          tbl.key_eq_);
+    swap(this->array_,            tbl.array_);
+    swap(this->size_,             tbl.size_);
+    swap(this->bucket_count_,     tbl.bucket_count_);
+    swap(this->old_array_,        tbl.old_array_);
+    swap(this->old_bucket_count_, tbl.old_bucket_count_);
+    swap(this->migrated_,         tbl.migrated_);
+    swap(this->rehash_step_,      tbl.rehash_step_);
+    swap(this->max_load_factor_,  tbl.max_load_factor_);
+    swap(this->hasher_,           tbl.hasher_);
+    swap(this->key_eq_,           tbl.key_eq_);
+    this->pool_.swap(tbl.pool_);
   }
 
-  static size_type bucket(
-    hasher    const& hasher,
-    size_type const  bucket_count,
-    key_type  const& key
-  ) {
-    return hasher(key) % bucket_count;
+  size_type index(size_type const hash) const {
+    return table_type::index(hash, this->bucket_count());
+  }
+
+  static size_type index(size_type const hash, size_type const bucket_count) {
+    return bucket_policy::index(hash, bucket_count);
   }
 
   static mapped_type& at(const_iterator pos, const_iterator end) {
@@ -517,20 +1070,27 @@ private:
     return iterator(
       from.base_.next_bucket(),
       from.base_.end_bucket(),
-      from.base_.current()
+      from.base_.current(),
+      from.base_.then_bucket(),
+      from.base_.then_end()
     );
   }
 
   double    const INCREMENT_RATE;
   size_type const INITIAL_BUCKET_COUNT;
 
-  bucket_ptr      array_;
-  size_type       size_;
-  size_type       bucket_count_;
-  float           max_load_factor_;
-  hasher          hasher_;
-  key_equal       key_eq_;
-  allocator_type  allocator_;
+  bucket_ptr        array_;
+  size_type         size_;
+  size_type         bucket_count_;
+  bucket_ptr        old_array_;
+  size_type         old_bucket_count_;
+  size_type         migrated_;
+  size_type         rehash_step_;
+  float             max_load_factor_;
+  hasher            hasher_;
+  key_equal         key_eq_;
+  allocator_type    allocator_;
+  element_pool_type pool_;
 };
 
 }}} // namespace sml::container::chain_hash_detail
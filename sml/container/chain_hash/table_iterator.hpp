@@ -14,6 +14,8 @@ class table_iterator;
 template<class Types>
 class const_table_iterator;
 
+// Walks the buckets in [first, last) and then, while the table is being
+// rehashed incrementally, those in [then_first, then_last).
 template<class Types>
 class table_iterator_base {
 private:
@@ -29,21 +31,29 @@ public:
   table_iterator_base() :
     next_bucket_(),
     end_bucket_(),
+    then_bucket_(),
+    then_end_(),
     current_() {
   }
 
   table_iterator_base(table_iterator_base const& r) :
     next_bucket_(r.next_bucket_),
     end_bucket_(r.end_bucket_),
+    then_bucket_(r.then_bucket_),
+    then_end_(r.then_end_),
     current_(r.current_) {
   }
 
   table_iterator_base(
     bucket_ptr       const first,
-    const_bucket_ptr const last
+    const_bucket_ptr const last,
+    bucket_ptr       const then_first = bucket_ptr(),
+    const_bucket_ptr const then_last  = const_bucket_ptr()
   ) :
     next_bucket_(first),
     end_bucket_(last),
+    then_bucket_(then_first),
+    then_end_(then_last),
     current_() {
     this->point_next();
   }
@@ -51,16 +61,22 @@ public:
   table_iterator_base(
     bucket_ptr       const first,
     const_bucket_ptr const last,
-    element_ptr      const current
+    element_ptr      const current,
+    bucket_ptr       const then_first = bucket_ptr(),
+    const_bucket_ptr const then_last  = const_bucket_ptr()
   ) :
     next_bucket_(first),
     end_bucket_(last),
+    then_bucket_(then_first),
+    then_end_(then_last),
     current_(current) {
   }
 
   void assign(table_iterator_base const& r) {
     this->next_bucket_ = r.next_bucket_;
     this->end_bucket_  = r.end_bucket_;
+    this->then_bucket_ = r.then_bucket_;
+    this->then_end_    = r.then_end_;
     this->current_     = r.current_;
   }
 
@@ -88,21 +104,34 @@ public:
 
   bucket_ptr       next_bucket()    { return this->next_bucket_; }
   const_bucket_ptr end_bucket()     { return this->end_bucket_; }
+  bucket_ptr       then_bucket()    { return this->then_bucket_; }
+  const_bucket_ptr then_end()       { return this->then_end_; }
   element_ptr      current()        { return this->current_; }
 
 private:
   void point_next() {
     this->current_ = element_ptr();
-    for (
-      ; !this->current_ && (this->next_bucket_ != this->end_bucket_);
-      ++this->next_bucket_
-    ) {
-      current_ = this->next_bucket_->head();
+    for (;;) {
+      for (
+        ; !this->current_ && (this->next_bucket_ != this->end_bucket_);
+        ++this->next_bucket_
+      ) {
+        current_ = this->next_bucket_->head();
+      }
+
+      if (this->current_ || !this->then_bucket_) return;
+
+      this->next_bucket_ = this->then_bucket_;
+      this->end_bucket_  = this->then_end_;
+      this->then_bucket_ = bucket_ptr();
+      this->then_end_    = const_bucket_ptr();
     }
   }
 
   bucket_ptr       next_bucket_;
   const_bucket_ptr end_bucket_;
+  bucket_ptr       then_bucket_;
+  const_bucket_ptr then_end_;
   element_ptr      current_;
 };
 
@@ -144,17 +173,21 @@ public:
 private:
   table_iterator(
     bucket_ptr       const first,
-    const_bucket_ptr const last
+    const_bucket_ptr const last,
+    bucket_ptr       const then_first = bucket_ptr(),
+    const_bucket_ptr const then_last  = const_bucket_ptr()
   ) :
-    base_(first, last) {
+    base_(first, last, then_first, then_last) {
   }
 
   table_iterator(
     bucket_ptr       const first,
     const_bucket_ptr const last,
-    element_ptr      const current
+    element_ptr      const current,
+    bucket_ptr       const then_first = bucket_ptr(),
+    const_bucket_ptr const then_last  = const_bucket_ptr()
   ) :
-    base_(first, last, current) {
+    base_(first, last, current, then_first, then_last) {
   }
 
 public:
@@ -245,17 +278,21 @@ public:
 private:
   const_table_iterator(
     bucket_ptr       const first,
-    const_bucket_ptr const last
+    const_bucket_ptr const last,
+    bucket_ptr       const then_first = bucket_ptr(),
+    const_bucket_ptr const then_last  = const_bucket_ptr()
   ) :
-    base_(first, last) {
+    base_(first, last, then_first, then_last) {
   }
 
   const_table_iterator(
     bucket_ptr       const first,
     const_bucket_ptr const last,
-    element_ptr      const current
+    element_ptr      const current,
+    bucket_ptr       const then_first = bucket_ptr(),
+    const_bucket_ptr const then_last  = const_bucket_ptr()
   ) :
-    base_(first, last, current) {
+    base_(first, last, current, then_first, then_last) {
   }
 
 public:
@@ -5,12 +5,16 @@
 #include <iterator>
 #include <cmath>
 #include <cstddef>
+#include <utility>
+#include "sml/container/bucket_policy.hpp"
+#include "sml/container/duplicate_policy.hpp"
 #include "sml/container/chain_hash/map_types.hpp"
 #include "sml/container/chain_hash/element.hpp"
 #include "sml/container/chain_hash/bucket.hpp"
 #include "sml/container/chain_hash/bucket_iterator.hpp"
 #include "sml/container/chain_hash/table_iterator.hpp"
 #include "sml/container/chain_hash/table.hpp"
+#include "sml/container/transparent.hpp"
 
 namespace sml { namespace container {
 
@@ -18,15 +22,16 @@ template<
   class Key,
   class T,
   class Hash,
-  class Pred  = std::equal_to<Key>,
-  class Alloc = std::allocator< std::pair<Key const, T> >
+  class Pred         = std::equal_to<Key>,
+  class Alloc        = std::allocator< std::pair<Key const, T> >,
+  class BucketPolicy = sml::container::modulo_bucket_policy
 >
 class chain_hash_map {
 
 private:
   typedef
     sml::container::chain_hash_detail::map_types<
-      Key, T, Hash, Pred, Alloc
+      Key, T, Hash, Pred, Alloc, BucketPolicy
     >
     types;
     
@@ -57,6 +62,14 @@ private:
   static float     const MAX_LOAD_FACTOR = 1.0f;
   static double    const INCREMENT_RATE  = 1.5;
 
+  // R, for lookups by a K other than key_type.
+  template<class K, class R>
+  struct transparent :
+    sml::container::enable_transparent_lookup<
+      Hash, Pred, K, const_iterator, R
+    > {
+  };
+
 public:
   explicit chain_hash_map(
     size_type      const  n         = BUCKETS_COUNT,
@@ -105,9 +118,7 @@ public:
       key_eq,
       allocator
     ) {
-    for (; first != last; ++first) {
-      this->tbl_.insert(*first);
-    }
+    this->insert(first, last);
   }
 
   chain_hash_map(chain_hash_map const& r) :
@@ -155,14 +166,97 @@ public:
     return this->insert(v);
   }
 
+  // Grows the buckets once up front when the range can be measured.
   template<class InputIterator>
   void insert(InputIterator first, InputIterator last) {
+    this->reserve_for(
+      first, last,
+      typename std::iterator_traits<InputIterator>::iterator_category()
+    );
     for (; first != last; ++first) {
       this->insert(*first);
     }
   }
 
-  size_type erase(key_type const& key)     { return this->tbl_.erase(key); }
+  // Inserts a range of pairs on up to `threads` threads, 0 meaning one per
+  // hardware thread; see table::bulk_insert.  `combine` decides what a
+  // duplicate key does to the mapped value (keep_first_duplicate,
+  // keep_last_duplicate, or any functor called as combine(mapped,
+  // incoming)), consistently with a sequential build in input order.
+  template<class RandomAccessIterator>
+  void bulk_insert(
+    RandomAccessIterator const first,
+    RandomAccessIterator const last,
+    unsigned             const threads = 0
+  ) {
+    this->tbl_.bulk_insert(
+      first, last, threads, sml::container::keep_first_duplicate()
+    );
+  }
+
+  template<class RandomAccessIterator, class Combine>
+  void bulk_insert(
+    RandomAccessIterator const first,
+    RandomAccessIterator const last,
+    unsigned             const threads,
+    Combine              const combine
+  ) {
+    this->tbl_.bulk_insert(first, last, threads, combine);
+  }
+
+  // emplace builds the element before it can hash the key, and destroys it
+  // again if the key is already there; try_emplace and insert_or_assign
+  // build one only for a new key.
+#if __cplusplus >= 201103L
+  std::pair<iterator, bool> insert(value_type&& v) {
+    return this->tbl_.insert(std::move(v));
+  }
+
+  template<class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return this->tbl_.emplace(std::forward<Args>(args)...);
+  }
+
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(key_type const& key, Args&&... args) {
+    return this->tbl_.try_emplace(key, std::forward<Args>(args)...);
+  }
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return this->tbl_.try_emplace(
+      std::move(key), std::forward<Args>(args)...
+    );
+  }
+
+  template<class M>
+  std::pair<iterator, bool> insert_or_assign(key_type const& key, M&& m) {
+    return this->tbl_.insert_or_assign(key, std::forward<M>(m));
+  }
+  template<class M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& m) {
+    return this->tbl_.insert_or_assign(std::move(key), std::forward<M>(m));
+  }
+#else
+  template<class A, class B>
+  std::pair<iterator, bool> emplace(A const& a, B const& b) {
+    return this->tbl_.emplace(a, b);
+  }
+
+  std::pair<iterator, bool> try_emplace(key_type const& key) {
+    return this->tbl_.try_emplace(key);
+  }
+  template<class A>
+  std::pair<iterator, bool> try_emplace(key_type const& key, A const& a) {
+    return this->tbl_.try_emplace(key, a);
+  }
+
+  template<class M>
+  std::pair<iterator, bool> insert_or_assign(key_type const& key, M const& m) {
+    return this->tbl_.insert_or_assign(key, m);
+  }
+#endif
+
+  size_type erase(key_type const& key)     { return this->tbl_.erase_key(key); }
   iterator erase(const_iterator const pos) { return this->tbl_.erase(pos); }
   iterator erase(const_iterator first, const_iterator last) {
     return this->tbl_.erase(first, last);
@@ -187,6 +281,48 @@ public:
   size_type count(key_type const& key) const {
     return this->tbl_.count(key);
   }
+
+  // Lookups by any K that Hash and Pred accept, when both declare
+  // is_transparent: a string map can then be searched with a slice of a
+  // buffer without building a string.
+  template<class K>
+  typename transparent<K, mapped_type&>::type at(K const& key) {
+    return this->tbl_.at(key);
+  }
+  template<class K>
+  typename transparent<K, mapped_type const&>::type at(K const& key) const {
+    return this->tbl_.at(key);
+  }
+
+  template<class K>
+  typename transparent<K, iterator>::type find(K const& key) {
+    return this->tbl_.find(key);
+  }
+  template<class K>
+  typename transparent<K, const_iterator>::type find(K const& key) const {
+    return this->tbl_.find(key);
+  }
+
+  template<class K>
+  typename transparent<K, size_type>::type count(K const& key) const {
+    return this->tbl_.count(key);
+  }
+
+  template<class K>
+  typename transparent<K, size_type>::type erase(K const& key) {
+    return this->tbl_.erase_key(key);
+  }
+
+  template<class K>
+  typename transparent<K, std::pair<iterator, iterator> >::type
+  equal_range(K const& key) {
+    return this->tbl_.equal_range(key);
+  }
+  template<class K>
+  typename transparent<K, std::pair<const_iterator, const_iterator> >::type
+  equal_range(K const& key) const {
+    return this->tbl_.equal_range(key);
+  }
   size_type bucket_count() const {
     return this->tbl_.bucket_count();
   }
@@ -203,6 +339,17 @@ public:
   void rehash(size_type n)  { return this->tbl_.rehash(n); }
   void reserve(size_type n) { return this->tbl_.reserve(n); }
 
+  // Buckets moved per insert, find or erase by key once a growth has
+  // started an incremental rehash; zero moves all elements in the growing
+  // insert.  With the default load factor a step of 2 or more finishes one
+  // rehash before the next growth, which would otherwise finish it at
+  // once.  While a rehash is in progress those calls invalidate iterators,
+  // and bucket_size() and the local iterators see only the elements
+  // already moved.
+  size_type rehash_step() const  { return this->tbl_.rehash_step(); }
+  void rehash_step(size_type n)  { this->tbl_.rehash_step(n); }
+  void complete_rehash()         { this->tbl_.complete_rehash(); }
+
   std::pair<iterator, iterator> equal_range(key_type const& key) {
     return this->tbl_.equal_range(key);
   }
@@ -224,6 +371,11 @@ public:
   mapped_type& operator[](key_type const& key) {
     return this->tbl_.access(key);
   };
+#if __cplusplus >= 201103L
+  mapped_type& operator[](key_type&& key) {
+    return this->tbl_.try_emplace(std::move(key)).first->second;
+  }
+#endif
 
   bool operator==(chain_hash_map const& r) const {
     return this->tbl_.equal(r.tbl_);
@@ -249,14 +401,35 @@ public:
   }
 
 private:
+  template<class InputIterator>
+  void reserve_for(InputIterator, InputIterator, std::input_iterator_tag) {
+  }
+
+  template<class ForwardIterator>
+  void reserve_for(
+    ForwardIterator const first,
+    ForwardIterator const last,
+    std::forward_iterator_tag
+  ) {
+    this->tbl_.reserve_more(
+      static_cast<size_type>(std::distance(first, last))
+    );
+  }
 
   table_type tbl_;
 };
 
-template<class Key, class T, class Hash, class Pred, class Alloc>
+template<
+  class Key,
+  class T,
+  class Hash,
+  class Pred,
+  class Alloc,
+  class BucketPolicy
+>
 void swap(
-  chain_hash_map<Key, T, Hash, Pred, Alloc>& x,
-  chain_hash_map<Key, T, Hash, Pred, Alloc>& y
+  chain_hash_map<Key, T, Hash, Pred, Alloc, BucketPolicy>& x,
+  chain_hash_map<Key, T, Hash, Pred, Alloc, BucketPolicy>& y
 ) {
   x.swap(y);
 }
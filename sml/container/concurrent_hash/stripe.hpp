@@ -0,0 +1,97 @@
+#ifndef _SML_CONTAINER_CONCURRENT_HASH_STRIPE_HPP
+#define _SML_CONTAINER_CONCURRENT_HASH_STRIPE_HPP
+
+#include <pthread.h>
+#include "sml/container/epoch_hash/chains.hpp"
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace container { namespace concurrent_hash_detail {
+
+// An acquire read of a field the __sync writes update; a plain load, so
+// that readers never take the cache line from each other.
+template<class T>
+T atomic_load(T const volatile& x) {
+  return __atomic_load_n(&x, __ATOMIC_ACQUIRE);
+}
+
+// The lock, element pool and retired elements shared by every bucket whose
+// index has the same low bits, and the bucket array those buckets live in.
+// A key keeps its stripe across resizes, so its element always returns to
+// the pool it came from.  Readers take no lock: they load the array with
+// load_buckets() and walk its chains.  Each stripe counts its own elements
+// and is padded apart from the next, so that writers of different stripes
+// share no cache line.
+template<class Types>
+class stripe : sml::utility::noncopyable {
+public:
+  typedef typename Types::size_type         size_type;
+  typedef typename Types::element_ptr       element_ptr;
+  typedef typename Types::element_pool_type element_pool_type;
+
+  typedef sml::container::epoch_hash_detail::bucket_array<Types>
+    bucket_array_type;
+  typedef sml::container::epoch_hash_detail::retire_list<element_ptr>
+    retire_list_type;
+
+  stripe() :
+    pool_(),
+    retired_(),
+    buckets_(),
+    size_(0) {
+    pthread_mutex_init(&this->lock_, 0);
+  }
+
+  ~stripe() {
+    pthread_mutex_destroy(&this->lock_);
+  }
+
+  void lock()   { pthread_mutex_lock(&this->lock_); }
+  void unlock() { pthread_mutex_unlock(&this->lock_); }
+
+  element_pool_type& pool() { return this->pool_; }
+
+  // Unlinked elements with the epoch they were retired in, oldest first.
+  retire_list_type& retired() { return this->retired_; }
+
+  bucket_array_type const* load_buckets() const {
+    return __atomic_load_n(&this->buckets_, __ATOMIC_ACQUIRE);
+  }
+
+  // The stripe must be locked.
+  bucket_array_type* buckets() const { return this->buckets_; }
+
+  void buckets(bucket_array_type* const buckets) {
+    __atomic_store_n(&this->buckets_, buckets, __ATOMIC_RELEASE);
+  }
+
+  // Written under the lock, read by anyone.
+  size_type size() const {
+    return __atomic_load_n(&this->size_, __ATOMIC_RELAXED);
+  }
+
+  void size(size_type const n) {
+    __atomic_store_n(&this->size_, n, __ATOMIC_RELAXED);
+  }
+
+private:
+  pthread_mutex_t              lock_;
+  element_pool_type            pool_;
+  retire_list_type             retired_;
+  bucket_array_type*           buckets_;
+  size_type                    size_;
+  char                         padding_[64];
+};
+
+template<class Stripe>
+class write_lock : sml::utility::noncopyable {
+public:
+  explicit write_lock(Stripe& s) : stripe_(&s) { s.lock(); }
+  ~write_lock() { this->stripe_->unlock(); }
+
+private:
+  Stripe* stripe_;
+};
+
+}}} // namespace sml::container::concurrent_hash_detail
+
+#endif
@@ -0,0 +1,476 @@
+#ifndef _SML_CONTAINER_CONCURRENT_HASH_TABLE_HPP
+#define _SML_CONTAINER_CONCURRENT_HASH_TABLE_HPP
+
+#include <cstddef>
+#include <pthread.h>
+#include "sml/container/bucket_policy.hpp"
+#include "sml/container/concurrent_hash/stripe.hpp"
+#include "sml/container/epoch_hash/chains.hpp"
+#include "sml/container/epoch_hash/epoch.hpp"
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace container { namespace concurrent_hash_detail {
+
+using sml::container::epoch_hash_detail::deleter;
+using sml::container::epoch_hash_detail::domain;
+using sml::container::epoch_hash_detail::mutex_lock;
+using sml::container::epoch_hash_detail::pool_destroyer;
+using sml::container::epoch_hash_detail::read_section;
+using sml::container::epoch_hash_detail::retire_list;
+
+// Buckets are guarded by a power-of-two number of striped locks, bucket i
+// by stripe i % stripe_count.  Bucket counts are powers of two no smaller
+// than the stripe count, so doubling the buckets splits bucket i into i
+// and i + old_count, both under the same stripe.
+//
+// Lookups take no lock: inside a read section of the table's epoch domain
+// they load the bucket array of the key's stripe and walk its chain.
+// Writers lock the stripe, build an element in full and publish it with
+// one release store; what they unlink is retired with the current epoch
+// and returned to the stripe's pool once no reader can still hold it.
+// Values are never written in place: an assignment publishes a new element
+// in the old one's stead.
+//
+// Each stripe counts its own elements, and one holding more than its share
+// of the buckets starts a growth.  A growth swaps in an empty bucket array
+// under every stripe lock and returns; the elements are copied a stripe at
+// a time by inserting threads, each moving the stripe of its key and one
+// more it claims, and the stripe then points its readers at the new array.
+// Copying instead of relinking keeps the old chains whole for readers
+// still walking them.  Whoever moves the last stripe retires the old
+// array.
+template<class Types>
+class table : sml::utility::noncopyable {
+public:
+  typedef Types types;
+  typedef typename types::key_type          key_type;
+  typedef typename types::mapped_type       mapped_type;
+  typedef typename types::value_type        value_type;
+  typedef typename types::size_type         size_type;
+  typedef typename types::hasher            hasher;
+  typedef typename types::key_equal         key_equal;
+  typedef typename types::allocator_type    allocator_type;
+
+  typedef typename types::element_type      element_type;
+  typedef typename types::element_ptr       element_ptr;
+  typedef typename types::const_element_ptr const_element_ptr;
+
+  typedef sml::container::concurrent_hash_detail::stripe<types> stripe_type;
+  typedef sml::container::power_of_two_bucket_policy             policy;
+
+private:
+  typedef typename stripe_type::bucket_array_type bucket_array_type;
+
+public:
+  table(
+    size_type const  n,
+    size_type const  concurrency,
+    hasher    const& hasher,
+    key_equal const& key_eq
+  ) :
+    domain_(),
+    stripes_(),
+    stripe_count_(policy::bucket_count(concurrency)),
+    buckets_(),
+    old_buckets_(),
+    retired_arrays_(),
+    resizing_(0),
+    next_stripe_(0),
+    migrated_count_(0),
+    grow_at_(0),
+    hasher_(hasher),
+    key_eq_(key_eq) {
+    pthread_mutex_init(&this->resize_mutex_, 0);
+
+    this->stripes_ = new stripe_type[this->stripe_count_];
+
+    size_type const count =
+      policy::bucket_count(n < this->stripe_count_ ? this->stripe_count_ : n);
+    try {
+      this->buckets_ = new bucket_array_type(count);
+    }
+    catch (...) {
+      delete[] this->stripes_;
+      pthread_mutex_destroy(&this->resize_mutex_);
+      throw;
+    }
+    for (size_type i = 0; i < this->stripe_count_; ++i) {
+      this->stripes_[i].buckets(this->buckets_);
+    }
+    this->grow_at_ = count / this->stripe_count_;
+  }
+
+  ~table() {
+    for (size_type i = 0; i < this->stripe_count_; ++i) {
+      stripe_type& s = this->stripes_[i];
+      this->destroy_chains(s, s.buckets());
+      table::reclaim_before(s, static_cast<size_type>(-1));
+    }
+    this->reclaim_arrays_before(static_cast<size_type>(-1));
+    delete this->old_buckets_;
+    delete this->buckets_;
+    delete[] this->stripes_;
+    pthread_mutex_destroy(&this->resize_mutex_);
+  }
+
+  size_type size() const {
+    size_type size = 0;
+    for (size_type i = 0; i < this->stripe_count_; ++i) {
+      size += this->stripes_[i].size();
+    }
+    return size;
+  }
+
+  bool empty() const {
+    return this->size() == 0;
+  }
+
+  size_type bucket_count() const {
+    mutex_lock const guard(this->resize_mutex_);
+    return this->buckets_->count;
+  }
+
+  size_type stripe_count() const {
+    return this->stripe_count_;
+  }
+
+  hasher    const& hash_function() const { return this->hasher_; }
+  key_equal const& key_eq()        const { return this->key_eq_; }
+
+  bool insert(value_type const& v) {
+    return this->put(v, false);
+  }
+
+  bool insert_or_assign(key_type const& key, mapped_type const& mapped) {
+    return this->put(value_type(key, mapped), true);
+  }
+
+  bool find(key_type const& key, mapped_type& mapped) const {
+    size_type const hash = this->hash_function()(key);
+    read_section const guard(this->domain_);
+
+    const_element_ptr const elem = this->find_element(key, hash);
+    if (!elem) return false;
+
+    mapped = elem->value().second;
+    return true;
+  }
+
+  size_type count(key_type const& key) const {
+    size_type const hash = this->hash_function()(key);
+    read_section const guard(this->domain_);
+
+    return this->find_element(key, hash) ? 1 : 0;
+  }
+
+  size_type erase(key_type const& key) {
+    size_type   const hash = this->hash_function()(key);
+    stripe_type&      s    = this->stripe_of(hash);
+    write_lock<stripe_type> const guard(s);
+
+    element_ptr* const head = table::head_of(s, hash);
+    element_ptr        prev = element_ptr();
+    element_ptr        elem = *head;
+    for (; elem; prev = elem, elem = elem->next()) {
+      if (elem->hash() == hash && this->key_eq()(elem->value().first, key)) {
+        break;
+      }
+    }
+    if (!elem) return 0;
+
+    epoch_hash_detail::publish(head, prev, elem->next());
+    s.size(s.size() - 1);
+
+    this->retire(s, elem);
+    this->reclaim(s);
+    return 1;
+  }
+
+  // Points every stripe at a new empty array and retires the old chains;
+  // pools left without elements return their memory.
+  void clear() {
+    mutex_lock const guard(this->resize_mutex_);
+    bucket_array_type* const empty =
+      new bucket_array_type(this->buckets_->count);
+
+    this->lock_all();
+    for (size_type i = 0; i < this->stripe_count_; ++i) {
+      stripe_type&             s   = this->stripes_[i];
+      bucket_array_type* const old = s.buckets();
+
+      s.buckets(empty);
+      this->retire_chains(s, old, this->domain_.advance());
+      this->reclaim(s);
+      if (s.pool().size() == 0) s.pool().purge();
+      s.size(0);
+    }
+
+    this->retire(this->buckets_);
+    if (this->old_buckets_) this->retire(this->old_buckets_);
+    this->buckets_     = empty;
+    this->old_buckets_ = 0;
+    __sync_lock_test_and_set(&this->resizing_, 0);
+    this->reclaim_arrays();
+
+    this->unlock_all();
+  }
+
+private:
+  stripe_type& stripe_of(size_type const hash) const {
+    return this->stripes_[policy::index(hash, this->stripe_count_)];
+  }
+
+  // Inside a read section.
+  const_element_ptr find_element(
+    key_type  const& key,
+    size_type const  hash
+  ) const {
+    return epoch_hash_detail::find_in_chain(
+      this->stripe_of(hash).load_buckets(), key, hash, this->key_eq()
+    );
+  }
+
+  bool put(value_type const& v, bool const assign) {
+    size_type   const hash = this->hash_function()(v.first);
+    stripe_type&      s    = this->stripe_of(hash);
+
+    if (atomic_load(this->resizing_)) {
+      this->help_resize(&s);
+      this->help_resize(this->claim_stripe());
+    }
+
+    bool full;
+    {
+      write_lock<stripe_type> const guard(s);
+
+      element_ptr* const head = table::head_of(s, hash);
+      element_ptr        prev = element_ptr();
+      for (element_ptr elem = *head; elem; prev = elem, elem = elem->next()) {
+        if (
+          elem->hash() != hash ||
+          !this->key_eq()(elem->value().first, v.first)
+        ) {
+          continue;
+        }
+        if (!assign) return false;
+
+        element_ptr const replacement = s.pool().construct(
+          element_type(value_type(elem->value().first, v.second), hash)
+        );
+        replacement->next(elem->next());
+        epoch_hash_detail::publish(head, prev, replacement);
+
+        this->retire(s, elem);
+        this->reclaim(s);
+        return false;
+      }
+
+      element_ptr const elem = s.pool().construct(element_type(v, hash));
+      elem->next(*head);
+      __atomic_store_n(head, elem, __ATOMIC_RELEASE);
+      s.size(s.size() + 1);
+      full = s.size() > atomic_load(this->grow_at_);
+    }
+
+    if (full) this->grow(s);
+    return true;
+  }
+
+  // The stripe must be locked.
+  static element_ptr* head_of(stripe_type const& s, size_type const hash) {
+    bucket_array_type* const buckets = s.buckets();
+    return buckets->heads + policy::index(hash, buckets->count);
+  }
+
+  // Copies an unmoved stripe, which must be locked, into the current bucket
+  // array and points it there; true if that was the last one, when the
+  // caller must call finish_resize() once it has unlocked the stripe.
+  bool migrate(stripe_type& s) {
+    bucket_array_type* const old = s.buckets();
+    if (old == this->buckets_) return false;
+
+    try {
+      for (
+        size_type i = &s - this->stripes_;
+        i < old->count;
+        i += this->stripe_count_
+      ) {
+        for (element_ptr elem = old->heads[i]; elem; elem = elem->next()) {
+          element_ptr const copy =
+            s.pool().construct(element_type(elem->value(), elem->hash()));
+          element_ptr& head = this->buckets_->heads[
+            policy::index(elem->hash(), this->buckets_->count)
+          ];
+          copy->next(head);
+          head = copy;
+        }
+      }
+    }
+    catch (...) {
+      this->destroy_chains(s, this->buckets_);
+      throw;
+    }
+
+    s.buckets(this->buckets_);
+    this->retire_chains(s, old, this->domain_.advance());
+    this->reclaim(s);
+
+    return
+      __sync_add_and_fetch(&this->migrated_count_, 1) == this->stripe_count_;
+  }
+
+  stripe_type* claim_stripe() {
+    size_type const idx = __sync_fetch_and_add(&this->next_stripe_, 1);
+    return idx < this->stripe_count_ ? this->stripes_ + idx : 0;
+  }
+
+  void help_resize(stripe_type* const s) {
+    if (!s) return;
+
+    bool last;
+    {
+      write_lock<stripe_type> const guard(*s);
+      last = this->migrate(*s);
+    }
+    if (last) this->finish_resize();
+  }
+
+  // Doubles the buckets once `s` holds more than its share of them,
+  // unless a growth is still under way.
+  void grow(stripe_type const& s) {
+    mutex_lock const guard(this->resize_mutex_);
+    if (
+      atomic_load(this->resizing_) ||
+      s.size() <= atomic_load(this->grow_at_)
+    ) {
+      return;
+    }
+
+    size_type          const count   = this->buckets_->count * 2;
+    bucket_array_type* const buckets = new bucket_array_type(count);
+
+    this->lock_all();
+    this->old_buckets_    = this->buckets_;
+    this->buckets_        = buckets;
+    this->migrated_count_ = 0;
+    __sync_lock_test_and_set(&this->next_stripe_, 0);
+    __sync_lock_test_and_set(&this->resizing_, 1);
+    __sync_lock_test_and_set(&this->grow_at_, count / this->stripe_count_);
+    this->unlock_all();
+
+    this->reclaim_arrays();
+  }
+
+  // A clear() and another growth may have come between the last migration
+  // and this call; the old array is only retired if every stripe has left
+  // it.
+  void finish_resize() {
+    mutex_lock const guard(this->resize_mutex_);
+    if (
+      this->old_buckets_ &&
+      atomic_load(this->migrated_count_) == this->stripe_count_
+    ) {
+      this->retire(this->old_buckets_);
+      this->old_buckets_ = 0;
+      __sync_lock_test_and_set(&this->resizing_, 0);
+    }
+    this->reclaim_arrays();
+  }
+
+  // In index order, so that two threads locking all stripes cannot
+  // deadlock; nobody else holds more than one.
+  void lock_all() {
+    for (size_type i = 0; i < this->stripe_count_; ++i) {
+      this->stripes_[i].lock();
+    }
+  }
+
+  void unlock_all() {
+    for (size_type i = 0; i < this->stripe_count_; ++i) {
+      this->stripes_[i].unlock();
+    }
+  }
+
+  // The stripe must be locked: only its holder retires into its list.
+  void retire(stripe_type& s, element_ptr const elem) {
+    s.retired().push(this->domain_.advance(), elem);
+  }
+
+  // Retires the chains of the stripe's buckets in `buckets`, which readers
+  // can no longer reach through the stripe.
+  void retire_chains(
+    stripe_type&             s,
+    bucket_array_type* const buckets,
+    size_type          const epoch
+  ) {
+    for (
+      size_type i = &s - this->stripes_;
+      i < buckets->count;
+      i += this->stripe_count_
+    ) {
+      for (element_ptr elem = buckets->heads[i]; elem; elem = elem->next()) {
+        s.retired().push(epoch, elem);
+      }
+    }
+  }
+
+  void reclaim(stripe_type& s) {
+    table::reclaim_before(s, this->domain_.safe_epoch());
+  }
+
+  static void reclaim_before(stripe_type& s, size_type const epoch) {
+    s.retired().reclaim_before(
+      epoch,
+      pool_destroyer<typename stripe_type::element_pool_type>(s.pool())
+    );
+  }
+
+  // The resize mutex must be held for these.
+  void retire(bucket_array_type* const buckets) {
+    this->retired_arrays_.push(this->domain_.advance(), buckets);
+  }
+
+  void reclaim_arrays() {
+    this->reclaim_arrays_before(this->domain_.safe_epoch());
+  }
+
+  void reclaim_arrays_before(size_type const epoch) {
+    this->retired_arrays_.reclaim_before(epoch, deleter());
+  }
+
+  // Destroys the chains of the stripe's buckets in `buckets`, which no
+  // reader can reach.
+  void destroy_chains(stripe_type& s, bucket_array_type* const buckets) {
+    for (
+      size_type i = &s - this->stripes_;
+      i < buckets->count;
+      i += this->stripe_count_
+    ) {
+      element_ptr elem = buckets->heads[i];
+      while (elem) {
+        element_ptr const next = elem->next();
+        s.pool().destroy(elem);
+        elem = next;
+      }
+      buckets->heads[i] = element_ptr();
+    }
+  }
+
+  domain                          domain_;
+  stripe_type*                    stripes_;
+  size_type const                 stripe_count_;
+  bucket_array_type*              buckets_;
+  bucket_array_type*              old_buckets_;
+  retire_list<bucket_array_type*> retired_arrays_;
+  int volatile                    resizing_;
+  size_type volatile              next_stripe_;
+  size_type volatile              migrated_count_;
+  size_type volatile              grow_at_;
+  mutable pthread_mutex_t         resize_mutex_;
+  hasher                          hasher_;
+  key_equal                       key_eq_;
+};
+
+}}} // namespace sml::container::concurrent_hash_detail
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef _SML_CONTAINER_DUPLICATE_POLICY_HPP
+#define _SML_CONTAINER_DUPLICATE_POLICY_HPP
+
+namespace sml { namespace container {
+
+// What a bulk insert does with a key it meets again: it calls
+// policy(mapped, incoming) with the mapped value already in the map, from
+// the map itself or earlier in the input, and the incoming one.  Any
+// functor of that shape works, e.g. one that adds counts.
+
+// The first value wins, as with insert().
+struct keep_first_duplicate {
+  template<class T, class U>
+  void operator()(T&, U const&) const {
+  }
+};
+
+// The last value wins, as with insert_or_assign().
+struct keep_last_duplicate {
+  template<class T, class U>
+  void operator()(T& mapped, U const& incoming) const {
+    mapped = incoming;
+  }
+};
+
+}} // namespace sml::container
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef _SML_CONTAINER_EPOCH_HASH_CHAINS_HPP
+#define _SML_CONTAINER_EPOCH_HASH_CHAINS_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <pthread.h>
+#include "sml/container/bucket_policy.hpp"
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace container { namespace epoch_hash_detail {
+
+// The pieces of a table whose readers walk chain_hash elements without a
+// lock while writers publish and retire them through an epoch domain.
+
+class mutex_lock : sml::utility::noncopyable {
+public:
+  explicit mutex_lock(pthread_mutex_t& m) : mutex_(&m) {
+    pthread_mutex_lock(this->mutex_);
+  }
+  ~mutex_lock() { pthread_mutex_unlock(this->mutex_); }
+
+private:
+  pthread_mutex_t* mutex_;
+};
+
+// A bucket count and that many chain heads, published to readers through
+// one pointer so that they never pair a count with the wrong heads.
+template<class Types>
+struct bucket_array : sml::utility::noncopyable {
+  typedef typename Types::size_type   size_type;
+  typedef typename Types::element_ptr element_ptr;
+
+  explicit bucket_array(size_type const n) :
+    count(n),
+    heads(new element_ptr[n]()) {
+  }
+
+  ~bucket_array() {
+    delete[] this->heads;
+  }
+
+  size_type    count;
+  element_ptr* heads;
+};
+
+// Inside a read section: the element of `key` in its chain of `buckets`,
+// walked with acquire loads, or none.
+template<class Types, class KeyEqual>
+typename Types::const_element_ptr find_in_chain(
+  bucket_array<Types> const* const   buckets,
+  typename Types::key_type  const&   key,
+  typename Types::size_type const    hash,
+  KeyEqual                  const&   key_eq
+) {
+  typedef typename Types::const_element_ptr const_element_ptr;
+
+  for (
+    const_element_ptr elem = __atomic_load_n(
+      buckets->heads +
+        sml::container::power_of_two_bucket_policy::index(
+          hash, buckets->count
+        ),
+      __ATOMIC_ACQUIRE
+    );
+    elem;
+    elem = elem->load_next()
+  ) {
+    if (elem->hash() == hash && key_eq(elem->value().first, key)) {
+      return elem;
+    }
+  }
+  return const_element_ptr();
+}
+
+// Makes `elem` follow `prev`, or head the bucket if there is none.
+template<class ElementPtr>
+void publish(
+  ElementPtr* const head,
+  ElementPtr  const prev,
+  ElementPtr  const elem
+) {
+  if (prev) prev->store_next(elem);
+  else __atomic_store_n(head, elem, __ATOMIC_RELEASE);
+}
+
+// What one writer at a time unlinked, each with the epoch it was retired
+// in.  Tags are the epoch before an advance, so the list is in tag order.
+template<class Pointer>
+class retire_list {
+public:
+  typedef std::pair<std::size_t, Pointer> entry_type;
+
+  void push(std::size_t const epoch, Pointer const p) {
+    this->entries_.push_back(entry_type(epoch, p));
+  }
+
+  std::size_t size() const {
+    return this->entries_.size();
+  }
+
+  // Hands everything retired before `epoch` to `dispose`, oldest first.
+  template<class Dispose>
+  void reclaim_before(std::size_t const epoch, Dispose dispose) {
+    typename std::vector<entry_type>::iterator entry = this->entries_.begin();
+    for (; entry != this->entries_.end() && entry->first < epoch; ++entry) {
+      dispose(entry->second);
+    }
+    this->entries_.erase(this->entries_.begin(), entry);
+  }
+
+private:
+  std::vector<entry_type> entries_;
+};
+
+// Disposers for retire_list::reclaim_before().
+template<class Pool>
+class pool_destroyer {
+public:
+  explicit pool_destroyer(Pool& pool) : pool_(&pool) {}
+
+  void operator()(typename Pool::pointer const p) const {
+    this->pool_->destroy(p);
+  }
+
+private:
+  Pool* pool_;
+};
+
+struct deleter {
+  template<class T>
+  void operator()(T* const p) const {
+    delete p;
+  }
+};
+
+}}} // namespace sml::container::epoch_hash_detail
+
+#endif
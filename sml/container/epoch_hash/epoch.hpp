@@ -0,0 +1,163 @@
+#ifndef _SML_CONTAINER_EPOCH_HASH_EPOCH_HPP
+#define _SML_CONTAINER_EPOCH_HASH_EPOCH_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace container { namespace epoch_hash_detail {
+
+// A reading thread's record of the epoch it is reading in, 0 outside a
+// read section.  Only its owner writes it; slots are padded apart so that
+// readers never share a cache line.
+struct reader_slot {
+  reader_slot() :
+    epoch(0),
+    depth(0),
+    in_use(1),
+    next(0) {
+  }
+
+  std::size_t  epoch;
+  std::size_t  depth;
+  int          in_use;
+  reader_slot* next;
+  char         padding[64];
+};
+
+// Epoch-based reclamation.  A reader publishes the global epoch in its slot
+// on entering a read section and clears it on leaving; a writer that
+// unlinks memory tags it with the current epoch and advances the epoch,
+// and frees it once every reader in a read section entered at a later
+// epoch.  Writers may advance concurrently, each keeping its own list of
+// what it retired.
+//
+// Each thread takes a slot on its first read and gives it back when it
+// exits, through a pthread key; slots are reused but only freed with the
+// domain.  Constructing a domain throws std::runtime_error once the
+// process has no pthread key left.
+class domain : sml::utility::noncopyable {
+public:
+  domain() :
+    epoch_(1),
+    slots_(0) {
+    if (pthread_key_create(&this->key_, &domain::release) != 0) {
+      throw std::runtime_error("no pthread key left at epoch domain");
+    }
+  }
+
+  ~domain() {
+    pthread_key_delete(this->key_);
+
+    reader_slot* slot = this->slots_;
+    while (slot) {
+      reader_slot* const next = slot->next;
+      delete slot;
+      slot = next;
+    }
+  }
+
+  // A store and a fence on the reader's own slot; no read-modify-write.
+  reader_slot* enter() const {
+    reader_slot* const slot = this->slot();
+    if (slot->depth++) return slot;
+
+    __atomic_store_n(
+      &slot->epoch,
+      __atomic_load_n(&this->epoch_, __ATOMIC_ACQUIRE),
+      __ATOMIC_RELAXED
+    );
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return slot;
+  }
+
+  void leave(reader_slot* const slot) const {
+    if (--slot->depth) return;
+    __atomic_store_n(&slot->epoch, 0, __ATOMIC_RELEASE);
+  }
+
+  // Called by the writer after unlinking; returns the epoch to tag the
+  // unlinked memory with.
+  std::size_t advance() {
+    return __atomic_fetch_add(&this->epoch_, 1, __ATOMIC_SEQ_CST);
+  }
+
+  // Memory tagged with an epoch below this is no longer reachable by any
+  // reader.
+  std::size_t safe_epoch() const {
+    std::size_t min = __atomic_load_n(&this->epoch_, __ATOMIC_SEQ_CST);
+    reader_slot const* slot = __atomic_load_n(&this->slots_, __ATOMIC_ACQUIRE);
+    for (; slot; slot = slot->next) {
+      std::size_t const epoch =
+        __atomic_load_n(&slot->epoch, __ATOMIC_SEQ_CST);
+      if (epoch && epoch < min) min = epoch;
+    }
+    return min;
+  }
+
+  // Waits until memory tagged with `epoch` may be freed.  Must not be
+  // called inside a read section.
+  void wait_past(std::size_t const epoch) const {
+    while (this->safe_epoch() <= epoch) sched_yield();
+  }
+
+private:
+  reader_slot* slot() const {
+    void* const slot = pthread_getspecific(this->key_);
+    return slot ? static_cast<reader_slot*>(slot) : this->register_reader();
+  }
+
+  reader_slot* register_reader() const {
+    reader_slot* slot = __atomic_load_n(&this->slots_, __ATOMIC_ACQUIRE);
+    for (; slot; slot = slot->next) {
+      if (
+        !__atomic_load_n(&slot->in_use, __ATOMIC_RELAXED) &&
+        __sync_bool_compare_and_swap(&slot->in_use, 0, 1)
+      ) {
+        break;
+      }
+    }
+
+    if (!slot) {
+      slot = new reader_slot;
+      do {
+        slot->next = __atomic_load_n(&this->slots_, __ATOMIC_ACQUIRE);
+      } while (!__sync_bool_compare_and_swap(&this->slots_, slot->next, slot));
+    }
+
+    pthread_setspecific(this->key_, slot);
+    return slot;
+  }
+
+  static void release(void* const slot) {
+    __atomic_store_n(
+      &static_cast<reader_slot*>(slot)->in_use, 0, __ATOMIC_RELEASE
+    );
+  }
+
+  std::size_t          epoch_;
+  mutable reader_slot* slots_;
+  pthread_key_t        key_;
+};
+
+class read_section : sml::utility::noncopyable {
+public:
+  explicit read_section(domain const& d) :
+    domain_(&d),
+    slot_(d.enter()) {
+  }
+
+  ~read_section() {
+    this->domain_->leave(this->slot_);
+  }
+
+private:
+  domain const* domain_;
+  reader_slot*  slot_;
+};
+
+}}} // namespace sml::container::epoch_hash_detail
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef _SML_CONTAINER_EPOCH_HASH_TABLE_HPP
+#define _SML_CONTAINER_EPOCH_HASH_TABLE_HPP
+
+#include <pthread.h>
+#include "sml/container/bucket_policy.hpp"
+#include "sml/container/epoch_hash/chains.hpp"
+#include "sml/container/epoch_hash/epoch.hpp"
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace container { namespace epoch_hash_detail {
+
+// Singly linked chains of chain_hash elements, read without locks and
+// written by one thread at a time.  A writer builds an element or bucket
+// array in full and publishes it with one release store; what it unlinks
+// is retired with the current epoch and returned to the pool once the
+// domain says no reader can still hold it.  Values are never written in
+// place: an assignment publishes a new element in the old one's stead.
+//
+// A growth copies every element into a new bucket array instead of
+// relinking them, so that a reader still walking the old array keeps
+// seeing whole, correct chains.
+template<class Types>
+class table : sml::utility::noncopyable {
+public:
+  typedef Types types;
+  typedef typename types::key_type          key_type;
+  typedef typename types::mapped_type       mapped_type;
+  typedef typename types::value_type        value_type;
+  typedef typename types::size_type         size_type;
+  typedef typename types::hasher            hasher;
+  typedef typename types::key_equal         key_equal;
+  typedef typename types::allocator_type    allocator_type;
+
+  typedef typename types::element_type      element_type;
+  typedef typename types::element_ptr       element_ptr;
+  typedef typename types::const_element_ptr const_element_ptr;
+  typedef typename types::element_pool_type element_pool_type;
+
+  typedef sml::container::power_of_two_bucket_policy policy;
+
+private:
+  typedef epoch_hash_detail::bucket_array<types> bucket_array;
+
+public:
+  table(
+    size_type const  n,
+    hasher    const& hasher,
+    key_equal const& key_eq
+  ) :
+    domain_(),
+    buckets_(new bucket_array(policy::bucket_count(n ? n : 1))),
+    size_(0),
+    pool_(),
+    retired_elements_(),
+    retired_arrays_(),
+    hasher_(hasher),
+    key_eq_(key_eq) {
+    pthread_mutex_init(&this->write_mutex_, 0);
+  }
+
+  ~table() {
+    this->destroy_elements(this->buckets_);
+    delete this->buckets_;
+    this->reclaim_before(static_cast<size_type>(-1));
+    pthread_mutex_destroy(&this->write_mutex_);
+  }
+
+  size_type size() const {
+    return __atomic_load_n(&this->size_, __ATOMIC_RELAXED);
+  }
+
+  bool empty() const {
+    return this->size() == 0;
+  }
+
+  size_type bucket_count() const {
+    return __atomic_load_n(&this->buckets_, __ATOMIC_ACQUIRE)->count;
+  }
+
+  hasher    const& hash_function() const { return this->hasher_; }
+  key_equal const& key_eq()        const { return this->key_eq_; }
+
+  bool find(key_type const& key, mapped_type& mapped) const {
+    size_type const hash = this->hash_function()(key);
+    read_section const guard(this->domain_);
+
+    const_element_ptr const elem = this->find_element(key, hash);
+    if (!elem) return false;
+
+    mapped = elem->value().second;
+    return true;
+  }
+
+  size_type count(key_type const& key) const {
+    size_type const hash = this->hash_function()(key);
+    read_section const guard(this->domain_);
+
+    return this->find_element(key, hash) ? 1 : 0;
+  }
+
+  bool insert(value_type const& v) {
+    return this->put(v, false);
+  }
+
+  bool insert_or_assign(key_type const& key, mapped_type const& mapped) {
+    return this->put(value_type(key, mapped), true);
+  }
+
+  size_type erase(key_type const& key) {
+    size_type const hash = this->hash_function()(key);
+    mutex_lock const guard(this->write_mutex_);
+
+    element_ptr* const head = this->head_of(hash);
+    element_ptr        prev = element_ptr();
+    element_ptr        elem = *head;
+    for (; elem; prev = elem, elem = elem->next()) {
+      if (elem->hash() == hash && this->key_eq()(elem->value().first, key)) {
+        break;
+      }
+    }
+    if (!elem) return 0;
+
+    epoch_hash_detail::publish(head, prev, elem->next());
+    __atomic_store_n(&this->size_, this->size_ - 1, __ATOMIC_RELAXED);
+
+    this->retire(elem);
+    this->reclaim();
+    return 1;
+  }
+
+  void clear() {
+    mutex_lock const guard(this->write_mutex_);
+
+    bucket_array* const old = this->buckets_;
+    bucket_array* const empty = new bucket_array(old->count);
+    __atomic_store_n(&this->buckets_, empty, __ATOMIC_RELEASE);
+    __atomic_store_n(&this->size_, 0, __ATOMIC_RELAXED);
+
+    this->retire(old);
+    this->reclaim();
+  }
+
+  // Waits for every read section that could see retired memory to end,
+  // and frees it all.  Must not be called inside a read section, i.e.
+  // from the hasher, key_eq or a copy of a mapped value.
+  void synchronize() {
+    mutex_lock const guard(this->write_mutex_);
+
+    size_type const epoch = this->domain_.advance();
+    this->domain_.wait_past(epoch);
+    this->reclaim_before(epoch + 1);
+  }
+
+  size_type retired() const {
+    mutex_lock const guard(this->write_mutex_);
+    return this->retired_elements_.size();
+  }
+
+private:
+  // Inside a read section.
+  const_element_ptr find_element(
+    key_type  const& key,
+    size_type const  hash
+  ) const {
+    return epoch_hash_detail::find_in_chain(
+      __atomic_load_n(&this->buckets_, __ATOMIC_ACQUIRE),
+      key, hash, this->key_eq()
+    );
+  }
+
+  bool put(value_type const& v, bool const assign) {
+    size_type const hash = this->hash_function()(v.first);
+    mutex_lock const guard(this->write_mutex_);
+
+    element_ptr* const head = this->head_of(hash);
+    element_ptr        prev = element_ptr();
+    for (element_ptr elem = *head; elem; prev = elem, elem = elem->next()) {
+      if (
+        elem->hash() != hash ||
+        !this->key_eq()(elem->value().first, v.first)
+      ) {
+        continue;
+      }
+      if (!assign) return false;
+
+      element_ptr const replacement = this->pool_.construct(
+        element_type(value_type(elem->value().first, v.second), hash)
+      );
+      replacement->next(elem->next());
+      epoch_hash_detail::publish(head, prev, replacement);
+
+      this->retire(elem);
+      this->reclaim();
+      return false;
+    }
+
+    element_ptr const elem = this->pool_.construct(element_type(v, hash));
+    elem->next(*head);
+    __atomic_store_n(head, elem, __ATOMIC_RELEASE);
+    __atomic_store_n(&this->size_, this->size_ + 1, __ATOMIC_RELAXED);
+
+    if (this->size_ > this->buckets_->count) this->grow();
+    return true;
+  }
+
+  void grow() {
+    bucket_array* const old     = this->buckets_;
+    bucket_array* const buckets = new bucket_array(old->count * 2);
+
+    try {
+      for (size_type i = 0; i < old->count; ++i) {
+        for (element_ptr elem = old->heads[i]; elem; elem = elem->next()) {
+          element_ptr const copy =
+            this->pool_.construct(element_type(elem->value(), elem->hash()));
+          element_ptr& head =
+            buckets->heads[policy::index(elem->hash(), buckets->count)];
+          copy->next(head);
+          head = copy;
+        }
+      }
+    }
+    catch (...) {
+      this->destroy_elements(buckets);
+      delete buckets;
+      throw;
+    }
+
+    __atomic_store_n(&this->buckets_, buckets, __ATOMIC_RELEASE);
+    this->retire(old);
+    this->reclaim();
+  }
+
+  element_ptr* head_of(size_type const hash) const {
+    return
+      this->buckets_->heads + policy::index(hash, this->buckets_->count);
+  }
+
+  void retire(element_ptr const elem) {
+    this->retired_elements_.push(this->domain_.advance(), elem);
+  }
+
+  void retire(bucket_array* const buckets) {
+    size_type const epoch = this->domain_.advance();
+    for (size_type i = 0; i < buckets->count; ++i) {
+      for (element_ptr elem = buckets->heads[i]; elem; elem = elem->next()) {
+        this->retired_elements_.push(epoch, elem);
+      }
+    }
+    this->retired_arrays_.push(epoch, buckets);
+  }
+
+  void reclaim() {
+    this->reclaim_before(this->domain_.safe_epoch());
+  }
+
+  void reclaim_before(size_type const epoch) {
+    this->retired_elements_.reclaim_before(
+      epoch, pool_destroyer<element_pool_type>(this->pool_)
+    );
+    this->retired_arrays_.reclaim_before(epoch, deleter());
+  }
+
+  void destroy_elements(bucket_array* const buckets) {
+    for (size_type i = 0; i < buckets->count; ++i) {
+      element_ptr elem = buckets->heads[i];
+      while (elem) {
+        element_ptr const next = elem->next();
+        this->pool_.destroy(elem);
+        elem = next;
+      }
+      buckets->heads[i] = element_ptr();
+    }
+  }
+
+  domain                        domain_;
+  bucket_array*                 buckets_;
+  size_type                     size_;
+  element_pool_type             pool_;
+  retire_list<element_ptr>      retired_elements_;
+  retire_list<bucket_array*>    retired_arrays_;
+  mutable pthread_mutex_t       write_mutex_;
+  hasher                        hasher_;
+  key_equal                     key_eq_;
+};
+
+}}} // namespace sml::container::epoch_hash_detail
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef _SML_CONTAINER_EPOCH_HASH_MAP_HPP
+#define _SML_CONTAINER_EPOCH_HASH_MAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include "sml/container/bucket_policy.hpp"
+#include "sml/container/chain_hash/map_types.hpp"
+#include "sml/container/chain_hash/element.hpp"
+#include "sml/container/epoch_hash/epoch.hpp"
+#include "sml/container/epoch_hash/table.hpp"
+
+namespace sml { namespace container {
+
+// Hash map for many readers and rare writers, on chain_hash_map's elements.
+// Every member may be called concurrently with any other but the
+// destructor.  find() and count() take no lock and write nothing shared:
+// a reader only stores to its own epoch slot.  Writers are serialized by a
+// mutex, copy the whole table on a growth, and free what they unlink only
+// after every reader that could have seen it has finished.
+//
+// Each thread that reads takes a reader slot from the map until it exits,
+// and each map holds a pthread key: constructing one throws
+// std::runtime_error once the process has none left.
+template<
+  class Key,
+  class T,
+  class Hash,
+  class Pred  = std::equal_to<Key>,
+  class Alloc = std::allocator< std::pair<Key const, T> >
+>
+class epoch_hash_map {
+
+private:
+  typedef
+    sml::container::chain_hash_detail::map_types<
+      Key, T, Hash, Pred, Alloc, sml::container::power_of_two_bucket_policy
+    >
+    types;
+
+  typedef
+    sml::container::epoch_hash_detail::template table<types>
+    table_type;
+
+public:
+  typedef typename table_type::key_type       key_type;
+  typedef typename table_type::mapped_type    mapped_type;
+  typedef typename table_type::value_type     value_type;
+  typedef typename table_type::size_type      size_type;
+  typedef typename table_type::hasher         hasher;
+  typedef typename table_type::key_equal      key_equal;
+  typedef typename table_type::allocator_type allocator_type;
+
+private:
+  static size_type const BUCKETS_COUNT = 64;
+
+public:
+  explicit epoch_hash_map(
+    size_type const  n      = BUCKETS_COUNT,
+    hasher    const& hasher = Hash(),
+    key_equal const& key_eq = key_equal()
+  ) :
+    tbl_(n, hasher, key_eq) {
+  }
+
+  bool      empty()        const { return this->tbl_.empty(); }
+  size_type size()         const { return this->tbl_.size(); }
+  size_type bucket_count() const { return this->tbl_.bucket_count(); }
+
+  hasher    hash_function() const { return this->tbl_.hash_function(); }
+  key_equal key_eq()        const { return this->tbl_.key_eq(); }
+
+  // True if inserted, false if the key was already there.
+  bool insert(value_type const& v) {
+    return this->tbl_.insert(v);
+  }
+
+  // True if inserted, false if an existing value was replaced.
+  bool insert_or_assign(key_type const& key, mapped_type const& mapped) {
+    return this->tbl_.insert_or_assign(key, mapped);
+  }
+
+  // Copies the value mapped to `key` into `mapped`; false if not found.
+  bool find(key_type const& key, mapped_type& mapped) const {
+    return this->tbl_.find(key, mapped);
+  }
+
+  size_type count(key_type const& key) const {
+    return this->tbl_.count(key);
+  }
+
+  size_type erase(key_type const& key) {
+    return this->tbl_.erase(key);
+  }
+
+  void clear() {
+    this->tbl_.clear();
+  }
+
+  // Elements unlinked but not yet freed, because a reader may hold them.
+  size_type retired() const {
+    return this->tbl_.retired();
+  }
+
+  // Waits for the readers that may hold retired elements, then frees them.
+  // Must not be called from the hasher, key_eq or mapped_type's copy.
+  void synchronize() {
+    this->tbl_.synchronize();
+  }
+
+private:
+  table_type tbl_;
+};
+
+}} // namespace sml::container
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef _SML_CONTAINER_FLAT_HASH_GROUP_HPP
+#define _SML_CONTAINER_FLAT_HASH_GROUP_HPP
+
+#include <cstddef>
+#include "sml/ext/cstdint.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sml { namespace container { namespace flat_hash_detail {
+
+// One control byte per slot: EMPTY and DELETED have the high bit set, a
+// full slot holds the low 7 bits of its key's hash.
+typedef signed char ctrl_type;
+
+ctrl_type const EMPTY   = -128;
+ctrl_type const DELETED = -2;
+
+std::size_t const GROUP_WIDTH = 16;
+
+inline bool is_full(ctrl_type const c) {
+  return c >= 0;
+}
+
+// Spreads the bits of a user hash, which may be the identity for integers,
+// over the whole word: the low 7 bits go into the control byte and the
+// rest pick the group.
+inline sml::ext::uint64_t mix(sml::ext::uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline ctrl_type h2(sml::ext::uint64_t const h) {
+  return static_cast<ctrl_type>(h & 0x7f);
+}
+
+inline std::size_t h1(sml::ext::uint64_t const h) {
+  return static_cast<std::size_t>(h >> 7);
+}
+
+// Set of slots in a group, one bit per slot, visited lowest first.
+class bitmask {
+public:
+  explicit bitmask(unsigned int const bits) :
+    bits_(bits) {
+  }
+
+  bool any() const { return this->bits_ != 0; }
+
+  std::size_t lowest() const {
+#ifdef __GNUC__
+    return static_cast<std::size_t>(__builtin_ctz(this->bits_));
+#else
+    std::size_t i = 0;
+    while (!(this->bits_ & (1u << i))) ++i;
+    return i;
+#endif
+  }
+
+  void clear_lowest() { this->bits_ &= this->bits_ - 1; }
+
+private:
+  unsigned int bits_;
+};
+
+// Sixteen control bytes matched at once.
+class group {
+public:
+#ifdef __SSE2__
+  explicit group(ctrl_type const* const ctrl) :
+    ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))) {
+  }
+
+  bitmask match(ctrl_type const h) const {
+    return bitmask(static_cast<unsigned int>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), this->ctrl_))
+    ));
+  }
+
+  bitmask match_empty() const {
+    return this->match(EMPTY);
+  }
+
+  bitmask match_empty_or_deleted() const {
+    return bitmask(static_cast<unsigned int>(_mm_movemask_epi8(this->ctrl_)));
+  }
+
+private:
+  __m128i ctrl_;
+#else
+  explicit group(ctrl_type const* const ctrl) :
+    ctrl_(ctrl) {
+  }
+
+  bitmask match(ctrl_type const h) const {
+    unsigned int bits = 0;
+    for (std::size_t i = 0; i < GROUP_WIDTH; ++i) {
+      bits |= static_cast<unsigned int>(this->ctrl_[i] == h) << i;
+    }
+    return bitmask(bits);
+  }
+
+  bitmask match_empty() const {
+    return this->match(EMPTY);
+  }
+
+  bitmask match_empty_or_deleted() const {
+    unsigned int bits = 0;
+    for (std::size_t i = 0; i < GROUP_WIDTH; ++i) {
+      bits |= static_cast<unsigned int>(this->ctrl_[i] < 0) << i;
+    }
+    return bitmask(bits);
+  }
+
+private:
+  ctrl_type const* ctrl_;
+#endif
+};
+
+}}} // namespace sml::container::flat_hash_detail
+
+#endif
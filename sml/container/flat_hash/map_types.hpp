@@ -0,0 +1,61 @@
+#ifndef _SML_CONTAINER_FLAT_HASH_MAP_TYPES_HPP
+#define _SML_CONTAINER_FLAT_HASH_MAP_TYPES_HPP
+
+#include <utility>
+#include <cstddef>
+#include "sml/container/flat_hash/group.hpp"
+
+namespace sml { namespace container { namespace flat_hash_detail {
+
+template<class Types>
+class table_iterator;
+
+template<class Types>
+class const_table_iterator;
+
+template<class Key, class T, class Hash, class Pred, class Alloc>
+struct map_types {
+
+  typedef Key   key_type;
+  typedef T     mapped_type;
+  typedef Hash  hasher;
+  typedef Pred  key_equal;
+  typedef Alloc allocator_type;
+
+  typedef std::pair<key_type const, mapped_type> value_type;
+  typedef value_type const                       const_value_type;
+
+  typedef value_type*       pointer;
+  typedef value_type const* const_pointer;
+  typedef value_type&       reference;
+  typedef value_type const& const_reference;
+
+  typedef std::ptrdiff_t    difference_type;
+  typedef std::size_t       size_type;
+
+  typedef value_type*       slot_ptr;
+  typedef ctrl_type*        ctrl_ptr;
+  typedef ctrl_type const*  const_ctrl_ptr;
+
+  typedef
+    typename allocator_type::template rebind<value_type>::other
+    slot_allocator_type;
+
+  typedef
+    typename allocator_type::template rebind<ctrl_type>::other
+    ctrl_allocator_type;
+
+  typedef
+    typename sml::container::flat_hash_detail::table_iterator<map_types>
+    table_iterator;
+
+  typedef
+    typename sml::container::flat_hash_detail::const_table_iterator<
+      map_types
+    >
+    const_table_iterator;
+};
+
+}}} // namespace sml::container::flat_hash_detail
+
+#endif
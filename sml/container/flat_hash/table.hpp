@@ -0,0 +1,553 @@
+#ifndef _SML_CONTAINER_FLAT_HASH_TABLE_HPP
+#define _SML_CONTAINER_FLAT_HASH_TABLE_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+#include "sml/container/flat_hash/group.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace container { namespace flat_hash_detail {
+
+// Open addressing over groups of GROUP_WIDTH slots.  A lookup hashes once,
+// takes the group picked by h1 and compares h2 against all of its control
+// bytes at a time; only slots whose byte matches touch the slot array.
+// The probe moves on to further groups, in triangular steps, only while
+// the current group has no EMPTY slot.
+template<class Types>
+class table {
+public:
+  typedef Types types;
+  typedef typename types::key_type             key_type;
+  typedef typename types::mapped_type          mapped_type;
+  typedef typename types::value_type           value_type;
+  typedef typename types::pointer              pointer;
+  typedef typename types::const_pointer        const_pointer;
+  typedef typename types::reference            reference;
+  typedef typename types::const_reference      const_reference;
+  typedef typename types::difference_type      difference_type;
+  typedef typename types::size_type            size_type;
+  typedef typename types::hasher               hasher;
+  typedef typename types::key_equal            key_equal;
+  typedef typename types::allocator_type       allocator_type;
+
+  typedef typename types::slot_ptr             slot_ptr;
+  typedef typename types::ctrl_ptr             ctrl_ptr;
+  typedef typename types::slot_allocator_type  slot_allocator_type;
+  typedef typename types::ctrl_allocator_type  ctrl_allocator_type;
+
+  typedef
+    sml::container::flat_hash_detail::table_iterator<types>
+    iterator;
+  typedef
+    sml::container::flat_hash_detail::const_table_iterator<types>
+    const_iterator;
+
+  typedef sml::ext::uint64_t hash_type;
+
+  typedef typename sml::container::flat_hash_detail::table<types> table_type;
+  typedef table_type* table_ptr;
+
+  class Destroyer : sml::utility::noncopyable {
+  public:
+    Destroyer(table_type& tbl) : tbl_(&tbl) {
+    }
+
+    ~Destroyer() {
+      if (this->tbl_) this->tbl_->destroy();
+    }
+
+    void release() {
+      this->tbl_ = table_ptr();
+    }
+
+  private:
+    table_ptr tbl_;
+  };
+
+  table(
+    size_type      const  n,
+    float          const  max_load_factor,
+    hasher         const& hasher,
+    key_equal      const& key_eq,
+    allocator_type const& allocator
+  ) :
+    ctrl_(),
+    slots_(),
+    capacity_(),
+    size_(),
+    deleted_(),
+    max_load_factor_(table::clamp_load_factor(max_load_factor)),
+    hasher_(hasher),
+    key_eq_(key_eq),
+    allocator_(allocator) {
+    this->allocate(table::round_up_capacity(n));
+  }
+
+  table(table const& r) :
+    ctrl_(),
+    slots_(),
+    capacity_(),
+    size_(),
+    deleted_(),
+    max_load_factor_(r.max_load_factor_),
+    hasher_(r.hasher_),
+    key_eq_(r.key_eq_),
+    allocator_(r.allocator_) {
+    Destroyer destroyer(*this);
+    this->copy_table(r);
+    destroyer.release();
+  }
+
+  table(table const& r, allocator_type const& allocator) :
+    ctrl_(),
+    slots_(),
+    capacity_(),
+    size_(),
+    deleted_(),
+    max_load_factor_(r.max_load_factor_),
+    hasher_(r.hasher_),
+    key_eq_(r.key_eq_),
+    allocator_(allocator) {
+    Destroyer destroyer(*this);
+    this->copy_table(r);
+    destroyer.release();
+  }
+
+  ~table() {
+    this->destroy();
+  }
+
+  iterator begin() {
+    iterator iter(this->iterator_at(0));
+    iter.base_.skip_empty();
+    return iter;
+  }
+  const_iterator begin() const {
+    const_iterator iter(this->iterator_at(0));
+    iter.base_.skip_empty();
+    return iter;
+  }
+
+  iterator end() {
+    return this->iterator_at(this->capacity_);
+  }
+  const_iterator end() const {
+    return this->iterator_at(this->capacity_);
+  }
+
+  bool empty() const {
+    return this->size() == 0;
+  }
+
+  size_type size() const {
+    return this->size_;
+  }
+
+  size_type max_size() const {
+    return slot_allocator_type(this->allocator_).max_size();
+  }
+
+  float load_factor() const {
+    return static_cast<float>(this->size()) /
+           static_cast<float>(this->bucket_count());
+  }
+
+  float max_load_factor() const {
+    return this->max_load_factor_;
+  }
+
+  // Open addressing needs free slots to end probes, so the factor is kept
+  // within [1/16, 7/8].
+  void max_load_factor(float const mlf) {
+    this->max_load_factor_ = table::clamp_load_factor(mlf);
+    if (this->size_ > this->max_fill(this->capacity_)) {
+      this->resize(this->minimum_capacity(this->size_));
+    }
+  }
+
+  hasher         const& hash_function() const { return this->hasher_; }
+  key_equal      const& key_eq()        const { return this->key_eq_; }
+  allocator_type const& get_allocator() const { return this->allocator_; }
+
+  std::pair<iterator, bool> insert(value_type const& v) {
+    hash_type const hash = this->hash(v.first);
+    size_type const idx  = this->find_index(v.first, hash);
+
+    if (idx != this->capacity_) {
+      return std::make_pair(this->iterator_at(idx), false);
+    }
+    return std::make_pair(this->iterator_at(this->insert_new(v, hash)), true);
+  }
+
+  size_type erase(key_type const& key) {
+    size_type const idx = this->find_index(key, this->hash(key));
+    if (idx == this->capacity_) return 0;
+
+    this->erase_at(idx);
+    return 1;
+  }
+
+  iterator erase(const_iterator const pos) {
+    size_type const idx = this->index_of(pos);
+    this->erase_at(idx);
+
+    iterator next(this->iterator_at(idx));
+    ++next;
+    return next;
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = this->erase(first);
+    }
+    return this->to_iterator(last);
+  }
+
+  void clear() {
+    slot_allocator_type allocator(this->allocator_);
+    for (size_type idx = 0; idx < this->capacity_; ++idx) {
+      if (is_full(this->ctrl_[idx])) allocator.destroy(this->slots_ + idx);
+    }
+
+    std::fill(this->ctrl_, this->ctrl_ + this->capacity_, EMPTY);
+    this->size_    = 0;
+    this->deleted_ = 0;
+  }
+
+  mapped_type& at(key_type const& key) {
+    return table::at(this->find(key), this->end());
+  }
+
+  mapped_type const& at(key_type const& key) const {
+    return table::at(this->find(key), this->end());
+  }
+
+  iterator find(key_type const& key) {
+    return this->iterator_at(this->find_index(key, this->hash(key)));
+  }
+
+  const_iterator find(key_type const& key) const {
+    return this->iterator_at(this->find_index(key, this->hash(key)));
+  }
+
+  size_type count(key_type const& key) const {
+    return this->find_index(key, this->hash(key)) == this->capacity_ ? 0 : 1;
+  }
+
+  size_type bucket_count() const {
+    return this->capacity_;
+  }
+
+  size_type max_bucket_count() const {
+    return this->max_size();
+  }
+
+  void rehash(size_type const n) {
+    this->resize(
+      std::max(table::round_up_capacity(n), this->minimum_capacity(this->size_))
+    );
+  }
+
+  void reserve(size_type const n) {
+    size_type const capacity = this->minimum_capacity(n);
+    if (capacity > this->capacity_) this->resize(capacity);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+    key_type const& key
+  ) const {
+    const_iterator pos = this->find(key);
+    const_iterator next = pos;
+    if (pos != this->end()) ++next;
+
+    return std::make_pair(pos, next);
+  }
+
+  std::pair<iterator, iterator> equal_range(key_type const& key) {
+    iterator pos = this->find(key);
+    iterator next = pos;
+    if (pos != this->end()) ++next;
+
+    return std::make_pair(pos, next);
+  }
+
+  void swap(table& tbl) {
+    if (this == &tbl) return;
+
+    if (this->get_allocator() == tbl.get_allocator()) {
+      this->naive_swap(tbl);
+    }
+    else {
+      table this_src(tbl,   this->get_allocator());
+      this->swap(this_src);
+
+      table tbl_src(*this,  tbl.get_allocator());
+      tbl.swap(tbl_src);
+    }
+  }
+
+  void assign(table const& r) {
+    if (this != &r) {
+      table tmp(r);
+      this->swap(tmp);
+    }
+  }
+
+  mapped_type& access(key_type const& key) {
+    hash_type const hash = this->hash(key);
+    size_type idx = this->find_index(key, hash);
+
+    if (idx == this->capacity_) {
+      idx = this->insert_new(std::make_pair(key, mapped_type()), hash);
+    }
+    return this->slots_[idx].second;
+  }
+
+  bool equal(table const& tbl) const {
+    if (this->size() != tbl.size()) return false;
+
+    for (const_iterator iter = this->begin(); iter != this->end(); ++iter) {
+      const_iterator pos = tbl.find(iter->first);
+      if (
+        pos == tbl.end() ||
+        !(iter->second == pos->second)
+      ) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void destroy() {
+    if (!this->ctrl_) return;
+
+    this->clear();
+    slot_allocator_type(this->allocator_).deallocate(
+      this->slots_, this->capacity_
+    );
+    ctrl_allocator_type(this->allocator_).deallocate(
+      this->ctrl_, this->capacity_
+    );
+
+    this->ctrl_     = ctrl_ptr();
+    this->slots_    = slot_ptr();
+    this->capacity_ = 0;
+  }
+
+private:
+  hash_type hash(key_type const& key) const {
+    return mix(static_cast<hash_type>(this->hasher_(key)));
+  }
+
+  size_type group_count() const {
+    return this->capacity_ / GROUP_WIDTH;
+  }
+
+  size_type find_index(key_type const& key, hash_type const hash) const {
+    ctrl_type const tag  = h2(hash);
+    size_type const mask = this->group_count() - 1;
+    size_type       g    = h1(hash) & mask;
+
+    for (size_type step = 1; step <= this->group_count(); ++step) {
+      group const grp(this->ctrl_ + g * GROUP_WIDTH);
+
+      for (bitmask match = grp.match(tag); match.any(); match.clear_lowest()) {
+        size_type const idx = g * GROUP_WIDTH + match.lowest();
+        if (this->key_eq_(this->slots_[idx].first, key)) return idx;
+      }
+
+      if (grp.match_empty().any()) break;
+      g = (g + step) & mask;
+    }
+
+    return this->capacity_;
+  }
+
+  // First EMPTY or DELETED slot on the probe sequence of `hash`.
+  size_type find_insert_index(hash_type const hash) const {
+    size_type const mask = this->group_count() - 1;
+    size_type       g    = h1(hash) & mask;
+
+    for (size_type step = 1; ; ++step) {
+      group const grp(this->ctrl_ + g * GROUP_WIDTH);
+      bitmask const free = grp.match_empty_or_deleted();
+      if (free.any()) return g * GROUP_WIDTH + free.lowest();
+
+      g = (g + step) & mask;
+    }
+  }
+
+  size_type insert_new(value_type const& v, hash_type const hash) {
+    if (this->size_ + this->deleted_ >= this->max_fill(this->capacity_)) {
+      this->grow();
+    }
+
+    size_type const idx = this->find_insert_index(hash);
+    slot_allocator_type(this->allocator_).construct(this->slots_ + idx, v);
+
+    if (this->ctrl_[idx] == DELETED) --this->deleted_;
+    this->ctrl_[idx] = h2(hash);
+    ++this->size_;
+
+    return idx;
+  }
+
+  // A slot can become EMPTY again when its group still has an EMPTY slot:
+  // such a group has never been full, so no probe has passed through it.
+  // Otherwise it is marked DELETED, which probes step over.
+  void erase_at(size_type const idx) {
+    slot_allocator_type(this->allocator_).destroy(this->slots_ + idx);
+    --this->size_;
+
+    group const grp(this->ctrl_ + (idx & ~(GROUP_WIDTH - 1)));
+    if (grp.match_empty().any()) {
+      this->ctrl_[idx] = EMPTY;
+    }
+    else {
+      this->ctrl_[idx] = DELETED;
+      ++this->deleted_;
+    }
+  }
+
+  // Mostly tombstones are cleared in place; otherwise the table doubles.
+  void grow() {
+    if (this->size_ < this->max_fill(this->capacity_) / 2) {
+      this->resize(this->capacity_);
+    }
+    else {
+      this->resize(this->capacity_ * 2);
+    }
+  }
+
+  void allocate(size_type const capacity) {
+    ctrl_ptr const ctrl =
+      ctrl_allocator_type(this->allocator_).allocate(capacity);
+    try {
+      this->slots_ = slot_allocator_type(this->allocator_).allocate(capacity);
+    }
+    catch (...) {
+      ctrl_allocator_type(this->allocator_).deallocate(ctrl, capacity);
+      throw;
+    }
+
+    std::fill(ctrl, ctrl + capacity, EMPTY);
+    this->ctrl_     = ctrl;
+    this->capacity_ = capacity;
+  }
+
+  // Copies every element into fresh arrays before the old ones are let
+  // go, so a throwing copy leaves the table as it was.
+  void resize(size_type const capacity) {
+    table tmp(capacity, this->max_load_factor_, this->hasher_, this->key_eq_,
+              this->allocator_);
+
+    for (size_type idx = 0; idx < this->capacity_; ++idx) {
+      if (is_full(this->ctrl_[idx])) {
+        tmp.naive_insert(this->slots_[idx]);
+      }
+    }
+
+    this->naive_swap(tmp);
+  }
+
+  void copy_table(table const& r) {
+    this->allocate(this->minimum_capacity(r.size()));
+
+    for (size_type idx = 0; idx < r.capacity_; ++idx) {
+      if (is_full(r.ctrl_[idx])) {
+        this->naive_insert(r.slots_[idx]);
+      }
+    }
+  }
+
+  // Inserts a value known to be absent, with enough room guaranteed.
+  void naive_insert(value_type const& v) {
+    hash_type const hash = this->hash(v.first);
+    size_type const idx  = this->find_insert_index(hash);
+
+    slot_allocator_type(this->allocator_).construct(this->slots_ + idx, v);
+    this->ctrl_[idx] = h2(hash);
+    ++this->size_;
+  }
+
+  void naive_swap(table& tbl) {
+    using std::swap;
+
+    swap(this->ctrl_,            tbl.ctrl_);
+    swap(this->slots_,           tbl.slots_);
+    swap(this->capacity_,        tbl.capacity_);
+    swap(this->size_,            tbl.size_);
+    swap(this->deleted_,         tbl.deleted_);
+    swap(this->max_load_factor_, tbl.max_load_factor_);
+    swap(this->hasher_,          tbl.hasher_);
+    swap(this->key_eq_,          tbl.key_eq_);
+  }
+
+  iterator iterator_at(size_type const idx) {
+    return iterator(
+      this->ctrl_ + idx, this->ctrl_ + this->capacity_, this->slots_ + idx
+    );
+  }
+
+  const_iterator iterator_at(size_type const idx) const {
+    return const_iterator(
+      this->ctrl_ + idx, this->ctrl_ + this->capacity_, this->slots_ + idx
+    );
+  }
+
+  size_type index_of(const_iterator const pos) const {
+    return static_cast<size_type>(pos.base_.current() - this->slots_);
+  }
+
+  iterator to_iterator(const_iterator const pos) {
+    return this->iterator_at(this->index_of(pos));
+  }
+
+  size_type max_fill(size_type const capacity) const {
+    size_type const fill = static_cast<size_type>(
+      static_cast<float>(capacity) * this->max_load_factor_
+    );
+    return std::max(std::min(fill, capacity - 1), size_type(1));
+  }
+
+  size_type minimum_capacity(size_type const size) const {
+    size_type capacity = GROUP_WIDTH;
+    while (this->max_fill(capacity) < size) capacity *= 2;
+    return capacity;
+  }
+
+  static size_type round_up_capacity(size_type const n) {
+    size_type capacity = GROUP_WIDTH;
+    while (capacity < n) capacity *= 2;
+    return capacity;
+  }
+
+  static float clamp_load_factor(float const mlf) {
+    return mlf > 0.875f ? 0.875f : mlf < 0.0625f ? 0.0625f : mlf;
+  }
+
+  static mapped_type& at(const_iterator pos, const_iterator end) {
+    if (pos == end) {
+      throw std::out_of_range("out of range at flat_hash_table#at");
+    }
+    return pos.base_.current()->second;
+  }
+
+  ctrl_ptr       ctrl_;
+  slot_ptr       slots_;
+  size_type      capacity_;
+  size_type      size_;
+  size_type      deleted_;
+  float          max_load_factor_;
+  hasher         hasher_;
+  key_equal      key_eq_;
+  allocator_type allocator_;
+};
+
+}}} // namespace sml::container::flat_hash_detail
+
+#endif
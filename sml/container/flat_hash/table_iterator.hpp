@@ -0,0 +1,278 @@
+#ifndef _SML_CONTAINER_FLAT_HASH_TABLE_ITERATOR_HPP
+#define _SML_CONTAINER_FLAT_HASH_TABLE_ITERATOR_HPP
+
+#include <iterator>
+#include "sml/container/flat_hash/group.hpp"
+
+namespace sml { namespace container { namespace flat_hash_detail {
+
+template<class Types>
+class table;
+
+template<class Types>
+class table_iterator;
+
+template<class Types>
+class const_table_iterator;
+
+// Walks the full slots in table order; the end is one past the last slot.
+template<class Types>
+class table_iterator_base {
+private:
+  typedef Types types;
+
+  typedef typename types::slot_ptr       slot_ptr;
+  typedef typename types::const_ctrl_ptr const_ctrl_ptr;
+  typedef typename types::pointer        pointer;
+  typedef typename types::reference      reference;
+
+public:
+  table_iterator_base() :
+    ctrl_(),
+    ctrl_end_(),
+    slot_() {
+  }
+
+  table_iterator_base(
+    const_ctrl_ptr const ctrl,
+    const_ctrl_ptr const ctrl_end,
+    slot_ptr       const slot
+  ) :
+    ctrl_(ctrl),
+    ctrl_end_(ctrl_end),
+    slot_(slot) {
+  }
+
+  void assign(table_iterator_base const& r) {
+    this->ctrl_     = r.ctrl_;
+    this->ctrl_end_ = r.ctrl_end_;
+    this->slot_     = r.slot_;
+  }
+
+  void skip_empty() {
+    while (this->ctrl_ != this->ctrl_end_ && !is_full(*this->ctrl_)) {
+      ++this->ctrl_;
+      ++this->slot_;
+    }
+  }
+
+  void increment() {
+    ++this->ctrl_;
+    ++this->slot_;
+    this->skip_empty();
+  }
+
+  reference dereference() const {
+    return *this->slot_;
+  }
+
+  pointer base() const {
+    return this->slot_;
+  }
+
+  bool equal(table_iterator_base const& r) const {
+    return this->slot_ == r.slot_;
+  }
+
+  slot_ptr current() const { return this->slot_; }
+
+private:
+  const_ctrl_ptr ctrl_;
+  const_ctrl_ptr ctrl_end_;
+  slot_ptr       slot_;
+};
+
+template<class Types>
+class table_iterator :
+  public std::iterator<
+    std::forward_iterator_tag,
+    typename Types::value_type,
+    typename Types::difference_type,
+    typename Types::pointer,
+    typename Types::reference
+  > {
+
+  template<class _Types>
+  friend class sml::container::flat_hash_detail::table;
+
+  template<class _T>
+  friend class sml::container::flat_hash_detail::const_table_iterator;
+
+private:
+  typedef Types types;
+  typedef table_iterator_base<types>     base_iterator;
+  typedef typename types::slot_ptr       slot_ptr;
+  typedef typename types::const_ctrl_ptr const_ctrl_ptr;
+
+public:
+  typedef typename types::pointer   pointer;
+  typedef typename types::reference reference;
+
+  table_iterator() :
+    base_() {
+  }
+
+  table_iterator(table_iterator const& r) :
+    base_(r.base_) {
+  }
+
+private:
+  table_iterator(
+    const_ctrl_ptr const ctrl,
+    const_ctrl_ptr const ctrl_end,
+    slot_ptr       const slot
+  ) :
+    base_(ctrl, ctrl_end, slot) {
+  }
+
+  explicit table_iterator(base_iterator const& base) :
+    base_(base) {
+  }
+
+public:
+  table_iterator& operator=(table_iterator const& r) {
+    this->base_.assign(r.base_);
+    return *this;
+  }
+
+  table_iterator& operator++() {
+    this->base_.increment();
+    return *this;
+  }
+
+  table_iterator const operator++(int) {
+    table_iterator tmp(*this);
+    this->base_.increment();
+    return tmp;
+  }
+
+  reference operator*() const {
+    return this->base_.dereference();
+  }
+
+  pointer operator->() const {
+    return this->base_.base();
+  }
+
+  bool operator==(table_iterator const& r) const {
+    return this->base_.equal(r.base_);
+  }
+
+  bool operator==(const_table_iterator<types> const& r) const {
+    return this->base_.equal(r.base_);
+  }
+
+  bool operator!=(table_iterator const& r) const {
+    return !(*this == r);
+  }
+
+  bool operator!=(const_table_iterator<types> const& r) const {
+    return !(*this == r);
+  }
+
+private:
+  base_iterator base_;
+
+};
+
+template<class Types>
+class const_table_iterator :
+  public std::iterator<
+    std::forward_iterator_tag,
+    typename Types::const_value_type,
+    typename Types::difference_type,
+    typename Types::const_pointer,
+    typename Types::const_reference
+  > {
+
+  template<class _Types>
+  friend class sml::container::flat_hash_detail::table;
+
+  template<class _T>
+  friend class sml::container::flat_hash_detail::table_iterator;
+
+private:
+  typedef Types types;
+  typedef table_iterator_base<types>     base_iterator;
+  typedef typename types::slot_ptr       slot_ptr;
+  typedef typename types::const_ctrl_ptr const_ctrl_ptr;
+
+public:
+  typedef typename types::const_pointer   pointer;
+  typedef typename types::const_reference reference;
+
+  const_table_iterator() :
+    base_() {
+  }
+
+  const_table_iterator(const_table_iterator const& r) :
+    base_(r.base_) {
+  }
+
+  const_table_iterator(table_iterator<types> const& r) :
+    base_(r.base_) {
+  }
+
+private:
+  const_table_iterator(
+    const_ctrl_ptr const ctrl,
+    const_ctrl_ptr const ctrl_end,
+    slot_ptr       const slot
+  ) :
+    base_(ctrl, ctrl_end, slot) {
+  }
+
+public:
+  const_table_iterator& operator=(const_table_iterator const& r) {
+    this->base_.assign(r.base_);
+    return *this;
+  }
+
+  const_table_iterator& operator=(table_iterator<types> const& r) {
+    this->base_.assign(r.base_);
+    return *this;
+  }
+
+  const_table_iterator& operator++() {
+    this->base_.increment();
+    return *this;
+  }
+
+  const_table_iterator const operator++(int) {
+    const_table_iterator tmp(*this);
+    this->base_.increment();
+    return tmp;
+  }
+
+  reference operator*() const {
+    return this->base_.dereference();
+  }
+
+  pointer operator->() const {
+    return this->base_.base();
+  }
+
+  bool operator==(const_table_iterator const& r) const {
+    return this->base_.equal(r.base_);
+  }
+
+  bool operator==(table_iterator<types> const& r) const {
+    return this->base_.equal(r.base_);
+  }
+
+  bool operator!=(const_table_iterator const& r) const {
+    return !(*this == r);
+  }
+
+  bool operator!=(table_iterator<types> const& r) const {
+    return !(*this == r);
+  }
+
+private:
+  base_iterator base_;
+
+};
+
+}}} // namespace sml::container::flat_hash_detail
+
+#endif
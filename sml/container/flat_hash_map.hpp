@@ -0,0 +1,247 @@
+#ifndef _SML_CONTAINER_FLAT_HASH_MAP_HPP
+#define _SML_CONTAINER_FLAT_HASH_MAP_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <cstddef>
+#include "sml/container/flat_hash/map_types.hpp"
+#include "sml/container/flat_hash/group.hpp"
+#include "sml/container/flat_hash/table_iterator.hpp"
+#include "sml/container/flat_hash/table.hpp"
+
+namespace sml { namespace container {
+
+// Drop-in for chain_hash_map that keeps its elements inline in one
+// open-addressed array, found through a parallel array of control bytes
+// matched sixteen at a time (with SSE2 when available).  There are no
+// per-element allocations; in exchange, an insert that grows the table
+// moves the elements and so invalidates iterators and references, and
+// there is no bucket interface beyond bucket_count().
+template<
+  class Key,
+  class T,
+  class Hash,
+  class Pred  = std::equal_to<Key>,
+  class Alloc = std::allocator< std::pair<Key const, T> >
+>
+class flat_hash_map {
+
+private:
+  typedef
+    sml::container::flat_hash_detail::map_types<
+      Key, T, Hash, Pred, Alloc
+    >
+    types;
+    
+  typedef
+    sml::container::flat_hash_detail::template table<types>
+    table_type;
+
+public:
+  typedef typename table_type::key_type             key_type;
+  typedef typename table_type::mapped_type          mapped_type;
+  typedef typename table_type::value_type           value_type;
+  typedef typename table_type::pointer              pointer;
+  typedef typename table_type::const_pointer        const_pointer;
+  typedef typename table_type::reference            reference;
+  typedef typename table_type::const_reference      const_reference;
+  typedef typename table_type::difference_type      difference_type;
+  typedef typename table_type::size_type            size_type;
+  typedef typename table_type::hasher               hasher;
+  typedef typename table_type::key_equal            key_equal;
+  typedef typename table_type::allocator_type       allocator_type;
+  typedef typename table_type::iterator             iterator;
+  typedef typename table_type::const_iterator       const_iterator;
+
+private:
+  static size_type const BUCKETS_COUNT   = 16;
+  static float     const MAX_LOAD_FACTOR = 0.875f;
+
+public:
+  explicit flat_hash_map(
+    size_type      const  n         = BUCKETS_COUNT,
+    hasher         const& hasher    = Hash(),
+    key_equal      const& key_eq    = key_equal(),
+    allocator_type const& allocator = allocator_type()
+  ) :
+    tbl_(
+      n,
+      MAX_LOAD_FACTOR,
+      hasher,
+      key_eq,
+      allocator
+    ) {
+  }
+
+  explicit flat_hash_map(allocator_type const& allocator) :
+    tbl_(
+      BUCKETS_COUNT,
+      MAX_LOAD_FACTOR,
+      hasher(),
+      key_equal(),
+      allocator
+    ) {
+  }
+
+  template<class InputIterator>
+  flat_hash_map(
+    InputIterator         first,
+    InputIterator  const  last,
+    size_type      const  n         = BUCKETS_COUNT,
+    hasher         const& hasher    = Hash(),
+    key_equal      const& key_eq    = key_equal(),
+    allocator_type const& allocator = allocator_type()
+  ) :
+    tbl_(
+      n,
+      MAX_LOAD_FACTOR,
+      hasher,
+      key_eq,
+      allocator
+    ) {
+    for (; first != last; ++first) {
+      this->tbl_.insert(*first);
+    }
+  }
+
+  flat_hash_map(flat_hash_map const& r) :
+    tbl_(r.tbl_) {
+  }
+
+  flat_hash_map(flat_hash_map const& r, allocator_type const& allocator) :
+    tbl_(r.tbl_, allocator) {
+  }
+
+  iterator       begin()        { return this->tbl_.begin(); }
+  const_iterator begin()  const { return this->tbl_.begin(); }
+  iterator       end()          { return this->tbl_.end(); }
+  const_iterator end()    const { return this->tbl_.end(); }
+
+  const_iterator cbegin() const { return this->begin(); }
+  const_iterator cend()   const { return this->end(); }
+
+  bool      empty()    const { return this->tbl_.empty(); }
+  size_type size()     const { return this->tbl_.size(); }
+  size_type max_size() const { return this->tbl_.max_size(); }
+
+  float load_factor()     const  { return this->tbl_.load_factor(); }
+  float max_load_factor() const  { return this->tbl_.max_load_factor(); }
+  void  max_load_factor(float z) { this->tbl_.max_load_factor(z); }
+
+  hasher hash_function()         const { return this->tbl_.hash_function(); }
+  key_equal key_eq()             const { return this->tbl_.key_eq(); }
+  allocator_type get_allocator() const { return this->tbl_.get_allocator(); }
+
+  std::pair<iterator, bool> insert(value_type const& v) {
+    return this->tbl_.insert(v);
+  }
+
+  std::pair<iterator, bool> insert(const_iterator, value_type const& v) {
+    return this->insert(v);
+  }
+
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) {
+      this->insert(*first);
+    }
+  }
+
+  size_type erase(key_type const& key)     { return this->tbl_.erase(key); }
+  iterator erase(const_iterator const pos) { return this->tbl_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return this->tbl_.erase(first, last);
+  }
+
+  void clear() { return this->tbl_.clear(); }
+
+  mapped_type& at (key_type const& key) {
+    return this->tbl_.at(key);
+  }
+  mapped_type const& at (key_type const& key) const {
+    return this->tbl_.at(key);
+  }
+
+  iterator find(key_type const& key) {
+    return this->tbl_.find(key);
+  }
+  const_iterator find(key_type const& key) const {
+    return this->tbl_.find(key);
+  }
+
+  size_type count(key_type const& key) const {
+    return this->tbl_.count(key);
+  }
+  size_type bucket_count() const {
+    return this->tbl_.bucket_count();
+  }
+  size_type max_bucket_count() const {
+    return this->tbl_.max_bucket_count();
+  }
+
+  void rehash(size_type n)  { return this->tbl_.rehash(n); }
+  void reserve(size_type n) { return this->tbl_.reserve(n); }
+
+  std::pair<iterator, iterator> equal_range(key_type const& key) {
+    return this->tbl_.equal_range(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+    key_type const& key
+  ) const {
+    return this->tbl_.equal_range(key);
+  }
+
+  void swap(flat_hash_map& x) {
+    this->tbl_.swap(x.tbl_);
+  }
+
+  flat_hash_map& operator=(flat_hash_map const& r) {
+    this->tbl_.assign(r.tbl_);
+    return *this;
+  }
+
+  mapped_type& operator[](key_type const& key) {
+    return this->tbl_.access(key);
+  }
+
+  bool operator==(flat_hash_map const& r) const {
+    return this->tbl_.equal(r.tbl_);
+  }
+  bool operator!=(flat_hash_map const& r) const {
+    return !(*this == r);
+  }
+
+  bool operator<(flat_hash_map const& r) const {
+    return std::lexicographical_compare(
+      this->tbl_.begin(), this->tbl_.end(),
+      r.tbl_.begin(),     r.tbl_.end()
+    );
+  }
+  bool operator>(flat_hash_map const& r) const {
+    return r < *this;
+  }
+  bool operator<=(flat_hash_map const& r) const {
+    return !(r < *this);
+  }
+  bool operator>=(flat_hash_map const& r) const {
+    return !(*this < r);
+  }
+
+private:
+
+  table_type tbl_;
+};
+
+template<class Key, class T, class Hash, class Pred, class Alloc>
+void swap(
+  flat_hash_map<Key, T, Hash, Pred, Alloc>& x,
+  flat_hash_map<Key, T, Hash, Pred, Alloc>& y
+) {
+  x.swap(y);
+}
+
+}} // namespace sml::container
+
+#endif
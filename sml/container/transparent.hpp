@@ -0,0 +1,69 @@
+#ifndef _SML_CONTAINER_TRANSPARENT_HPP
+#define _SML_CONTAINER_TRANSPARENT_HPP
+
+namespace sml { namespace container {
+
+namespace detail {
+
+typedef char  _yes;
+typedef char (&_no)[2];
+
+template<class T>
+struct _has_is_transparent {
+  template<class U>
+  static _yes test(typename U::is_transparent*);
+
+  template<class U>
+  static _no test(...);
+
+  static bool const value = sizeof(test<T>(0)) == sizeof(_yes);
+};
+
+template<class From, class To>
+struct _is_convertible {
+  static _yes test(To);
+  static _no  test(...);
+  static From& make();
+
+  static bool const value = sizeof(test(make())) == sizeof(_yes);
+};
+
+template<bool Enable, class T>
+struct _enable_if {
+  typedef T type;
+};
+
+template<class T>
+struct _enable_if<false, T> {
+};
+
+} // namespace detail
+
+// True when both the hasher and the key equality declare a nested
+// is_transparent type, promising to hash and compare any type they accept
+// consistently with key_type; lookups then take such a type as it is
+// instead of converting it to key_type.
+template<class Hash, class Pred>
+struct is_transparent_lookup {
+  static bool const value =
+    detail::_has_is_transparent<Hash>::value &&
+    detail::_has_is_transparent<Pred>::value;
+};
+
+template<class Hash, class Pred>
+bool const is_transparent_lookup<Hash, Pred>::value;
+
+// The result type R of a lookup by a K, when the lookup is transparent and
+// K is no iterator of the map, so that erase(iterator) keeps its meaning.
+template<class Hash, class Pred, class K, class Iterator, class R>
+struct enable_transparent_lookup :
+  detail::_enable_if<
+    is_transparent_lookup<Hash, Pred>::value &&
+    !detail::_is_convertible<K, Iterator>::value,
+    R
+  > {
+};
+
+}} // namespace sml::container
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef _SML_EXT_CSTDINT_HPP
+#define _SML_EXT_CSTDINT_HPP
+
+#ifdef __GNUC__
+#if __GNUC__ == 4 && __GNUC_MINOR__ <= 6
+#include <tr1/cstdint>
+namespace sml { namespace ext {
+
+using std::tr1::int8_t;
+using std::tr1::int16_t;
+using std::tr1::int32_t;
+using std::tr1::int64_t;
+using std::tr1::uint8_t;
+using std::tr1::uint16_t;
+using std::tr1::uint32_t;
+using std::tr1::uint64_t;
+
+}} // namespace sml::ext
+#endif
+#endif
+
+#endif
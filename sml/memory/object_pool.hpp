@@ -0,0 +1,222 @@
+#ifndef _SML_MEMORY_OBJECT_POOL_HPP
+#define _SML_MEMORY_OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "sml/utility/noncopyable.hpp"
+
+namespace sml { namespace memory {
+
+// Hands out one object at a time from chunks obtained through `Alloc`.
+// Destroyed objects go onto a free list and are reused before the current
+// chunk is carved further; memory goes back to `Alloc` only a whole chunk
+// at a time, by purge() or the destructor.  Chunks start at 16 objects and
+// double up to `max_chunk_size`.  Objects still alive at purge() or
+// destruction are not destroyed.  The value type must be at least as large
+// as a pointer, which a free slot holds.
+template<class Alloc>
+class object_pool : Alloc, sml::utility::noncopyable {
+public:
+
+  typedef Alloc base_allocator_type;
+  typedef typename base_allocator_type::value_type      value_type;
+  typedef typename base_allocator_type::pointer         pointer;
+  typedef typename base_allocator_type::const_pointer   const_pointer;
+  typedef typename base_allocator_type::size_type       size_type;
+  typedef typename base_allocator_type::difference_type difference_type;
+
+  enum { MAX_CHUNK_SIZE = 256 };
+
+private:
+  enum { FIRST_CHUNK_SIZE = 16 };
+
+  typedef char _pointer_sized[
+    sizeof(value_type) >= sizeof(pointer) &&
+    sizeof(value_type) >= sizeof(size_type) ? 1 : -1
+  ];
+
+public:
+  template<class _Alloc>
+  explicit object_pool(
+    const _Alloc&   allocator,
+    const size_type max_chunk_size = MAX_CHUNK_SIZE
+  ) :
+    base_allocator_type(allocator),
+    chunks_(),
+    free_(),
+    next_(),
+    end_(),
+    chunk_size_(FIRST_CHUNK_SIZE),
+    max_chunk_size_(max_chunk_size),
+    size_(),
+    capacity_() {
+  }
+
+  object_pool() :
+    base_allocator_type(),
+    chunks_(),
+    free_(),
+    next_(),
+    end_(),
+    chunk_size_(FIRST_CHUNK_SIZE),
+    max_chunk_size_(MAX_CHUNK_SIZE),
+    size_(),
+    capacity_() {
+  }
+
+  ~object_pool() {
+    this->purge();
+  }
+
+  pointer construct(const value_type& v) {
+    const pointer p = this->take();
+
+    try {
+      this->base_allocator_type::construct(p, v);
+    }
+    catch (...) {
+      this->give_back(p);
+      throw;
+    }
+
+    ++this->size_;
+    return p;
+  }
+
+  void destroy(const pointer p) {
+    this->base_allocator_type::destroy(p);
+    this->give_back(p);
+    --this->size_;
+  }
+
+  // An unconstructed slot, for the caller to build an object in with
+  // placement new and later hand to destroy(); if that construction
+  // throws, the slot goes back through deallocate_slot().
+  pointer allocate_slot() {
+    const pointer p = this->take();
+    ++this->size_;
+    return p;
+  }
+
+  void deallocate_slot(const pointer p) {
+    this->give_back(p);
+    --this->size_;
+  }
+
+  // Returns every chunk to the allocator.
+  void purge() {
+    pointer chunk = this->chunks_;
+    while (chunk) {
+      const pointer   prev = object_pool::link(chunk);
+      const size_type size = object_pool::chunk_size(chunk + 1);
+      this->deallocate(chunk, size);
+      chunk = prev;
+    }
+
+    this->chunks_     = pointer();
+    this->free_       = pointer();
+    this->next_       = pointer();
+    this->end_        = pointer();
+    this->chunk_size_ = FIRST_CHUNK_SIZE;
+    this->size_       = 0;
+    this->capacity_   = 0;
+  }
+
+  void swap(object_pool& r) {
+    using std::swap;
+
+    swap(this->chunks_,         r.chunks_);
+    swap(this->free_,           r.free_);
+    swap(this->next_,           r.next_);
+    swap(this->end_,            r.end_);
+    swap(this->chunk_size_,     r.chunk_size_);
+    swap(this->max_chunk_size_, r.max_chunk_size_);
+    swap(this->size_,           r.size_);
+    swap(this->capacity_,       r.capacity_);
+  }
+
+  // Objects alive.
+  size_type size() const {
+    return this->size_;
+  }
+
+  // Objects the chunks allocated so far can hold.
+  size_type capacity() const {
+    return this->capacity_;
+  }
+
+private:
+  // The first two slots of a chunk hold the previous chunk and the size of
+  // this one.
+  pointer take() {
+    if (this->free_) {
+      const pointer p = this->free_;
+      this->free_ = object_pool::link(p);
+      return p;
+    }
+
+    if (this->next_ == this->end_) {
+      const size_type size  = this->chunk_size_ + 2;
+      const pointer   chunk = this->allocate(size);
+
+      object_pool::link(chunk, this->chunks_);
+      object_pool::chunk_size(chunk + 1, size);
+
+      this->chunks_    = chunk;
+      this->next_      = chunk + 2;
+      this->end_       = chunk + static_cast<difference_type>(size);
+      this->capacity_ += this->chunk_size_;
+
+      if (this->chunk_size_ < this->max_chunk_size_) {
+        this->chunk_size_ *= 2;
+        if (this->chunk_size_ > this->max_chunk_size_) {
+          this->chunk_size_ = this->max_chunk_size_;
+        }
+      }
+    }
+
+    return this->next_++;
+  }
+
+  void give_back(const pointer p) {
+    object_pool::link(p, this->free_);
+    this->free_ = p;
+  }
+
+  // A free slot holds no object, so its bytes are copied rather than read
+  // through a pointer of another type.
+  static pointer link(const const_pointer slot) {
+    pointer p;
+    std::memcpy(&p, static_cast<const void*>(slot), sizeof(p));
+    return p;
+  }
+
+  static void link(const pointer slot, const pointer p) {
+    std::memcpy(static_cast<void*>(slot), &p, sizeof(p));
+  }
+
+  static size_type chunk_size(const const_pointer slot) {
+    size_type size;
+    std::memcpy(&size, static_cast<const void*>(slot), sizeof(size));
+    return size;
+  }
+
+  static void chunk_size(const pointer slot, const size_type size) {
+    std::memcpy(static_cast<void*>(slot), &size, sizeof(size));
+  }
+
+  pointer   chunks_;
+  pointer   free_;
+  pointer   next_;
+  pointer   end_;
+  size_type chunk_size_;
+  size_type max_chunk_size_;
+  size_type size_;
+  size_type capacity_;
+
+};
+
+}} // namespace
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _SML_OP_GREATER_HPP
+#define _SML_OP_GREATER_HPP
+
+namespace sml { namespace op {
+
+class greater {
+public:
+
+  typedef bool result_type;
+
+  template<class T>
+  bool operator()(T& a, T& b) const {
+    return b < a;
+  }
+
+  template<class T>
+  bool operator()(const T& a, const T& b) const {
+    return b < a;
+  }
+
+}; // class greater
+
+}} // namespace sml::op
+
+#endif
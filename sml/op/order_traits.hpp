@@ -0,0 +1,60 @@
+#ifndef _SML_OP_ORDER_TRAITS_HPP
+#define _SML_OP_ORDER_TRAITS_HPP
+
+#include <functional>
+#include "sml/op/comparator.hpp"
+#include "sml/op/greater.hpp"
+#include "sml/op/lesser.hpp"
+
+namespace sml { namespace op {
+
+// Whether `Order` orders values of type T exactly as operator< does, so
+// that algorithms may pick kernels which compare T directly.  Specialize
+// for other orderings that are known to be plain ascending ones.
+template<class Order, class T>
+struct is_natural_order {
+  enum { value = false };
+};
+
+template<class T>
+struct is_natural_order<sml::op::lesser, T> {
+  enum { value = true };
+};
+
+template<class T>
+struct is_natural_order<sml::op::comparator, T> {
+  enum { value = true };
+};
+
+template<class T>
+struct is_natural_order<std::less<T>, T> {
+  enum { value = true };
+};
+
+// Whether `Order` is the exact reverse of operator< on T.
+template<class Order, class T>
+struct is_reverse_order {
+  enum { value = false };
+};
+
+template<class T>
+struct is_reverse_order<sml::op::greater, T> {
+  enum { value = true };
+};
+
+template<class T>
+struct is_reverse_order<std::greater<T>, T> {
+  enum { value = true };
+};
+
+template<class Order, class T>
+struct is_natural_order<const Order, T> : is_natural_order<Order, T> {
+};
+
+template<class Order, class T>
+struct is_reverse_order<const Order, T> : is_reverse_order<Order, T> {
+};
+
+}} // namespace sml::op
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef _SML_PARALLEL_PARALLEL_FOR_HPP
+#define _SML_PARALLEL_PARALLEL_FOR_HPP
+
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace sml { namespace parallel {
+
+inline unsigned hardware_concurrency() {
+  long const n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? static_cast<unsigned>(n) : 1u;
+}
+
+namespace detail {
+
+template<class Function>
+struct _parallel_for_context {
+  Function*            fn;
+  std::size_t          tasks;
+  std::size_t volatile next;
+};
+
+template<class Function>
+void _parallel_for_run(_parallel_for_context<Function>& ctx) {
+  for (;;) {
+    std::size_t const task = __sync_fetch_and_add(&ctx.next, 1);
+    if (task >= ctx.tasks) break;
+    (*ctx.fn)(task);
+  }
+}
+
+template<class Function>
+void* _parallel_for_worker(void* const arg) {
+  sml::parallel::detail::_parallel_for_run(
+    *static_cast<_parallel_for_context<Function>*>(arg)
+  );
+  return 0;
+}
+
+} // namespace detail
+
+// Calls fn(task) for every task in [0, tasks) on up to `threads` threads,
+// the calling thread included; 0 means hardware_concurrency().  Tasks are
+// handed out dynamically, so results must not depend on which thread runs
+// a task.  An exception thrown on a worker thread terminates the program.
+template<class Function>
+void parallel_for(std::size_t const tasks, unsigned threads, Function& fn) {
+  typedef sml::parallel::detail::_parallel_for_context<Function> context_type;
+
+  if (threads == 0) threads = sml::parallel::hardware_concurrency();
+  if (threads > tasks) threads = static_cast<unsigned>(tasks);
+
+  context_type ctx;
+  ctx.fn    = &fn;
+  ctx.tasks = tasks;
+  ctx.next  = 0;
+
+  std::vector<pthread_t> workers(threads > 1 ? threads - 1 : 0);
+  std::size_t started = 0;
+  for (; started < workers.size(); ++started) {
+    int const error = pthread_create(
+      &workers[started],
+      0,
+      &sml::parallel::detail::_parallel_for_worker<Function>,
+      &ctx
+    );
+    if (error != 0) break;
+  }
+
+  try {
+    sml::parallel::detail::_parallel_for_run(ctx);
+  }
+  catch (...) {
+    __sync_lock_test_and_set(&ctx.next, tasks);
+    for (std::size_t i = 0; i < started; ++i) pthread_join(workers[i], 0);
+    throw;
+  }
+
+  for (std::size_t i = 0; i < started; ++i) pthread_join(workers[i], 0);
+}
+
+}} // namespace sml::parallel
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef _SML_PARALLEL_RANDOMIZE_HPP
+#define _SML_PARALLEL_RANDOMIZE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sml/ext/cstdint.hpp"
+#include "sml/parallel/parallel_for.hpp"
+#include "sml/random/philox4x32.hpp"
+#include "sml/random/uniform_int.hpp"
+
+namespace sml { namespace parallel { namespace detail {
+
+// Shuffle by random scatter: every element draws a bucket from its own
+// counter, buckets are filled stably in index order, and each bucket is
+// Fisher-Yates shuffled with its own stream.  The bucket and chunk counts
+// depend on n only, so the permutation is fixed by (seed, n) whatever the
+// number of threads.
+template<class Iterator>
+class _randomizer {
+public:
+  typedef typename std::iterator_traits<Iterator>::value_type value_type;
+  typedef
+    typename std::iterator_traits<Iterator>::difference_type
+    difference_type;
+  typedef std::size_t              size_type;
+  typedef sml::random::philox4x32  random_type;
+
+  static size_type const BUCKET_SIZE = 1 << 16;
+  static size_type const CHUNK_SIZE  = 1 << 14;
+  static size_type const MAX_BUCKETS = 1024;
+  static size_type const MAX_CHUNKS  = 256;
+
+  _randomizer(
+    Iterator                  const begin,
+    size_type                 const n,
+    random_type::seed_type    const seed
+  ) :
+    begin_(begin),
+    n_(n),
+    rand_(seed),
+    buckets_(std::min(n / BUCKET_SIZE + 1, MAX_BUCKETS)),
+    chunks_(std::min(n / CHUNK_SIZE + 1, MAX_CHUNKS)),
+    phase_() {
+  }
+
+  void run(unsigned const threads) {
+    if (this->buckets_ == 1) {
+      this->shuffle(this->begin_, this->n_, 1);
+      return;
+    }
+
+    this->offsets_.assign(this->chunks_ * this->buckets_, 0);
+    this->phase_ = COUNT;
+    sml::parallel::parallel_for(this->chunks_, threads, *this);
+
+    this->bucket_begin_.assign(this->buckets_ + 1, 0);
+    size_type pos = 0;
+    for (size_type b = 0; b < this->buckets_; ++b) {
+      this->bucket_begin_[b] = pos;
+      for (size_type c = 0; c < this->chunks_; ++c) {
+        size_type& slot = this->offsets_[c * this->buckets_ + b];
+        size_type const count = slot;
+        slot = pos;
+        pos += count;
+      }
+    }
+    this->bucket_begin_[this->buckets_] = pos;
+
+    this->buffer_.resize(this->n_);
+    this->phase_ = SCATTER;
+    sml::parallel::parallel_for(this->chunks_, threads, *this);
+
+    this->phase_ = SHUFFLE;
+    sml::parallel::parallel_for(this->buckets_, threads, *this);
+  }
+
+  void operator()(size_type const task) {
+    switch (this->phase_) {
+    case COUNT:   this->count(task);           break;
+    case SCATTER: this->scatter(task);         break;
+    case SHUFFLE: this->shuffle_bucket(task);  break;
+    }
+  }
+
+private:
+  enum phase_type { COUNT, SCATTER, SHUFFLE };
+
+  size_type bucket_of(size_type const i) const {
+    sml::ext::uint64_t high, low;
+    sml::random::detail::multiply(this->rand_.at(i), this->buckets_, high, low);
+    return static_cast<size_type>(high);
+  }
+
+  size_type chunk_begin(size_type const c) const {
+    return this->n_ / this->chunks_ * c + std::min(c, this->n_ % this->chunks_);
+  }
+
+  void count(size_type const c) {
+    size_type* const counts = &this->offsets_[c * this->buckets_];
+    size_type const last = this->chunk_begin(c + 1);
+
+    for (size_type i = this->chunk_begin(c); i < last; ++i) {
+      ++counts[this->bucket_of(i)];
+    }
+  }
+
+  void scatter(size_type const c) {
+    size_type* const offsets = &this->offsets_[c * this->buckets_];
+    size_type const last = this->chunk_begin(c + 1);
+
+    for (size_type i = this->chunk_begin(c); i < last; ++i) {
+      this->buffer_[offsets[this->bucket_of(i)]++] =
+        *(this->begin_ + static_cast<difference_type>(i));
+    }
+  }
+
+  void shuffle_bucket(size_type const b) {
+    size_type const first = this->bucket_begin_[b];
+    size_type const last  = this->bucket_begin_[b + 1];
+
+    typename std::vector<value_type>::iterator const bucket =
+      this->buffer_.begin() + static_cast<difference_type>(first);
+    this->shuffle(bucket, last - first, b + 1);
+
+    std::copy(
+      bucket,
+      bucket + static_cast<difference_type>(last - first),
+      this->begin_ + static_cast<difference_type>(first)
+    );
+  }
+
+  template<class _Iterator>
+  void shuffle(
+    _Iterator                 const first,
+    size_type                 const n,
+    random_type::seed_type    const stream
+  ) const {
+    using std::swap;
+    random_type rand = this->rand_.split(stream);
+
+    for (size_type i = n; i > 1; --i) {
+      size_type const j = static_cast<size_type>(
+        sml::random::bounded_rand(rand, i)
+      );
+      swap(
+        *(first + static_cast<difference_type>(i - 1)),
+        *(first + static_cast<difference_type>(j))
+      );
+    }
+  }
+
+  Iterator          const begin_;
+  size_type         const n_;
+  random_type       const rand_;
+  size_type         const buckets_;
+  size_type         const chunks_;
+  phase_type              phase_;
+  std::vector<size_type>  offsets_;
+  std::vector<size_type>  bucket_begin_;
+  std::vector<value_type> buffer_;
+};
+
+template<class Iterator>
+typename _randomizer<Iterator>::size_type const
+_randomizer<Iterator>::BUCKET_SIZE;
+
+template<class Iterator>
+typename _randomizer<Iterator>::size_type const
+_randomizer<Iterator>::CHUNK_SIZE;
+
+template<class Iterator>
+typename _randomizer<Iterator>::size_type const
+_randomizer<Iterator>::MAX_BUCKETS;
+
+template<class Iterator>
+typename _randomizer<Iterator>::size_type const
+_randomizer<Iterator>::MAX_CHUNKS;
+
+} // namespace detail
+
+// Reproducible parallel shuffle: the result depends on `seed` and the
+// length of the range only, never on `threads` (0 means all cores).
+// Needs a temporary copy of the range.
+template<class Iterator>
+Iterator randomize(
+  const Iterator                          begin,
+  const Iterator                          end,
+  const sml::random::philox4x32::seed_type seed,
+  const unsigned                          threads = 0
+) {
+  sml::parallel::detail::_randomizer<Iterator> randomizer(
+    begin, static_cast<std::size_t>(end - begin), seed
+  );
+  randomizer.run(threads);
+  return begin;
+}
+
+}} // namespace sml::parallel
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef _SML_PARALLEL_SAMPLE_HPP
+#define _SML_PARALLEL_SAMPLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sml/ext/cstdint.hpp"
+#include "sml/parallel/parallel_for.hpp"
+#include "sml/random/philox4x32.hpp"
+
+namespace sml { namespace parallel { namespace detail {
+
+// Every element gets the key philox(seed, index); the sample is the k
+// smallest (key, index) pairs, which no partitioning of the work can
+// change.
+class _sampler {
+public:
+  typedef std::size_t                                  size_type;
+  typedef std::pair<sml::ext::uint64_t, size_type>     entry_type;
+  typedef std::vector<entry_type>                      heap_type;
+
+  enum { CHUNK_SIZE = 1 << 16 };
+
+  _sampler(
+    size_type                              const n,
+    size_type                              const k,
+    sml::random::philox4x32::seed_type     const seed
+  ) :
+    n_(n),
+    k_(k),
+    rand_(seed),
+    chunks_(n / CHUNK_SIZE + 1),
+    heaps_(chunks_) {
+  }
+
+  void run(unsigned const threads) {
+    sml::parallel::parallel_for(this->chunks_, threads, *this);
+  }
+
+  void operator()(size_type const c) {
+    heap_type& heap = this->heaps_[c];
+    size_type const first = this->chunk_begin(c);
+    size_type const last  = this->chunk_begin(c + 1);
+
+    heap.reserve(std::min(this->k_, last - first));
+    for (size_type i = first; i < last; ++i) {
+      entry_type const entry(this->rand_.at(i), i);
+
+      if (heap.size() < this->k_) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end());
+      }
+      else if (entry < heap.front()) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = entry;
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+  }
+
+  // Sampled indices in their (random) key order.
+  template<class OutputIterator>
+  OutputIterator indices(OutputIterator out) const {
+    heap_type all;
+    for (size_type c = 0; c < this->chunks_; ++c) {
+      all.insert(all.end(), this->heaps_[c].begin(), this->heaps_[c].end());
+    }
+
+    size_type const k = std::min(this->k_, all.size());
+    std::partial_sort(
+      all.begin(),
+      all.begin() + static_cast<std::ptrdiff_t>(k),
+      all.end()
+    );
+
+    for (size_type i = 0; i < k; ++i, ++out) {
+      *out = all[i].second;
+    }
+    return out;
+  }
+
+private:
+  size_type chunk_begin(size_type const c) const {
+    return this->n_ / this->chunks_ * c + std::min(c, this->n_ % this->chunks_);
+  }
+
+  size_type                          const n_;
+  size_type                          const k_;
+  sml::random::philox4x32            const rand_;
+  size_type                          const chunks_;
+  std::vector<heap_type>                   heaps_;
+};
+
+} // namespace detail
+
+// Reproducible parallel sample of k elements without replacement, written
+// in random order.  The result depends on `seed` and the length of the
+// range only, never on `threads` (0 means all cores).
+template<class RandomAccessIterator, class OutputIterator>
+OutputIterator sample(
+  const RandomAccessIterator               first,
+  const RandomAccessIterator               last,
+  OutputIterator                           out,
+  const std::size_t                        k,
+  const sml::random::philox4x32::seed_type seed,
+  const unsigned                           threads = 0
+) {
+  typedef
+    typename std::iterator_traits<RandomAccessIterator>::difference_type
+    difference_type;
+
+  sml::parallel::detail::_sampler sampler(
+    static_cast<std::size_t>(last - first), k, seed
+  );
+  sampler.run(threads);
+
+  std::vector<std::size_t> indices;
+  sampler.indices(std::back_inserter(indices));
+
+  for (std::size_t i = 0; i < indices.size(); ++i, ++out) {
+    *out = *(first + static_cast<difference_type>(indices[i]));
+  }
+  return out;
+}
+
+}} // namespace sml::parallel
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _SML_PARALLEL_STATISTICS_HPP
+#define _SML_PARALLEL_STATISTICS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "sml/algorithm/statistics.hpp"
+#include "sml/parallel/parallel_for.hpp"
+
+namespace sml { namespace parallel { namespace detail {
+
+// Chunks are summarized independently and merged in order, so the result
+// does not depend on the number of threads.
+template<unsigned Stats, class RandomAccessIterator>
+class _summarizer {
+public:
+  typedef std::size_t                              size_type;
+  typedef sml::algorithm::statistics<Stats>        statistics_type;
+
+  enum { CHUNK_SIZE = 1 << 16 };
+
+  _summarizer(const RandomAccessIterator first, const size_type n) :
+    first_(first),
+    n_(n),
+    chunks_((n + CHUNK_SIZE - 1) / CHUNK_SIZE),
+    partial_(chunks_) {
+  }
+
+  void run(const unsigned threads) {
+    sml::parallel::parallel_for(this->chunks_, threads, *this);
+  }
+
+  void operator()(const size_type c) {
+    const size_type begin = c * CHUNK_SIZE;
+    const size_type end   = std::min(begin + CHUNK_SIZE, this->n_);
+
+    this->partial_[c].add(this->first_ + begin, this->first_ + end);
+  }
+
+  statistics_type result() const {
+    statistics_type stats;
+    for (size_type c = 0; c < this->chunks_; ++c) stats.merge(this->partial_[c]);
+    return stats;
+  }
+
+private:
+  const RandomAccessIterator   first_;
+  const size_type              n_;
+  const size_type              chunks_;
+  std::vector<statistics_type> partial_;
+};
+
+} // namespace detail
+
+// sml::algorithm::summarize over chunks of the range on up to `threads`
+// threads (0 means all cores).
+template<unsigned Stats, class RandomAccessIterator>
+sml::algorithm::statistics<Stats> summarize(
+  const RandomAccessIterator first,
+  const RandomAccessIterator last,
+  const unsigned             threads = 0
+) {
+  sml::parallel::detail::_summarizer<Stats, RandomAccessIterator> summarizer(
+    first, static_cast<std::size_t>(last - first)
+  );
+  summarizer.run(threads);
+  return summarizer.result();
+}
+
+template<class RandomAccessIterator>
+sml::algorithm::statistics<> summarize(
+  const RandomAccessIterator first,
+  const RandomAccessIterator last,
+  const unsigned             threads = 0
+) {
+  return sml::parallel::summarize<sml::algorithm::STAT_ALL>(first, last, threads);
+}
+
+}} // namespace sml::parallel
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _SML_RANDOM_PCG64_HPP
+#define _SML_RANDOM_PCG64_HPP
+
+#include "sml/ext/cstdint.hpp"
+
+#ifdef __SIZEOF_INT128__
+
+namespace sml { namespace random {
+
+// PCG XSL-RR 128/64 by O'Neill: a 128-bit LCG with a permuted 64-bit
+// output.  Each odd increment selects an independent stream.
+class pcg64 {
+public:
+  typedef sml::ext::uint64_t result_type;
+  typedef unsigned __int128  state_type;
+
+  static result_type const default_seed   = 0xcafef00dd15ea5e5ULL;
+  static result_type const default_stream = 0xda3e39cb94b95bdbULL;
+
+  static result_type min() { return 0; }
+  static result_type max() { return ~result_type(); }
+
+  explicit pcg64(
+    result_type const seed   = default_seed,
+    result_type const stream = default_stream
+  ) {
+    this->seed(seed, stream);
+  }
+
+  void seed(
+    result_type const seed   = default_seed,
+    result_type const stream = default_stream
+  ) {
+    this->inc_   = (static_cast<state_type>(stream) << 1) | 1u;
+    this->state_ = 0;
+    this->step();
+    this->state_ += seed;
+    this->step();
+  }
+
+  void set_state(state_type const state, state_type const inc) {
+    this->state_ = state;
+    this->inc_   = inc | 1u;
+  }
+
+  state_type state()     const { return this->state_; }
+  state_type increment() const { return this->inc_; }
+
+  result_type operator()() {
+    this->step();
+    return pcg64::output(this->state_);
+  }
+
+  // Jumps ahead in O(log n) using Brown's LCG skip algorithm.
+  void discard(state_type n) {
+    state_type acc_mult = 1, acc_plus = 0;
+    state_type cur_mult = pcg64::multiplier(), cur_plus = this->inc_;
+
+    while (n > 0) {
+      if (n & 1u) {
+        acc_mult *= cur_mult;
+        acc_plus  = acc_plus * cur_mult + cur_plus;
+      }
+      cur_plus  = (cur_mult + 1) * cur_plus;
+      cur_mult *= cur_mult;
+      n >>= 1;
+    }
+
+    this->state_ = acc_mult * this->state_ + acc_plus;
+  }
+
+  template<class OutputIterator>
+  void generate(OutputIterator first, OutputIterator const last) {
+    state_type       state = this->state_;
+    state_type const mult  = pcg64::multiplier();
+    state_type const inc   = this->inc_;
+
+    for (; first != last; ++first) {
+      state  = state * mult + inc;
+      *first = pcg64::output(state);
+    }
+
+    this->state_ = state;
+  }
+
+  bool operator==(pcg64 const& r) const {
+    return this->state_ == r.state_ && this->inc_ == r.inc_;
+  }
+  bool operator!=(pcg64 const& r) const {
+    return !(*this == r);
+  }
+
+private:
+  static state_type multiplier() {
+    return
+      (static_cast<state_type>(2549297995355413924ULL) << 64) |
+      4865540595714422341ULL;
+  }
+
+  static result_type output(state_type const state) {
+    result_type const xored =
+      static_cast<result_type>(state >> 64) ^ static_cast<result_type>(state);
+    unsigned const rot = static_cast<unsigned>(state >> 122);
+    return (xored >> rot) | (xored << ((64 - rot) & 63));
+  }
+
+  void step() {
+    this->state_ = this->state_ * pcg64::multiplier() + this->inc_;
+  }
+
+  state_type state_;
+  state_type inc_;
+};
+
+}} // namespace sml::random
+
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef _SML_RANDOM_PHILOX4X32_HPP
+#define _SML_RANDOM_PHILOX4X32_HPP
+
+#include "sml/ext/cstdint.hpp"
+
+namespace sml { namespace random {
+
+// Philox4x32-10 by Salmon et al.: a counter-based generator.  Output n of
+// stream s is a pure function of (seed, s, n), so streams can be split and
+// jumped in O(1) and handed to threads without shared state.
+class philox4x32 {
+public:
+  typedef sml::ext::uint32_t result_type;
+  typedef sml::ext::uint64_t seed_type;
+
+  static seed_type const default_seed = 20111115ULL;
+
+  static result_type min() { return 0; }
+  static result_type max() { return ~result_type(); }
+
+  explicit philox4x32(
+    seed_type const seed   = default_seed,
+    seed_type const stream = 0
+  ) {
+    this->seed(seed, stream);
+  }
+
+  void seed(seed_type const seed = default_seed, seed_type const stream = 0) {
+    this->key_[0] = static_cast<result_type>(seed);
+    this->key_[1] = static_cast<result_type>(seed >> 32);
+    this->stream_ = stream;
+    this->index_  = 0;
+  }
+
+  seed_type stream() const { return this->stream_; }
+
+  // An independent generator sharing this seed.
+  philox4x32 split(seed_type const stream) const {
+    philox4x32 r(*this);
+    r.stream_ = stream;
+    r.index_  = 0;
+    return r;
+  }
+
+  result_type operator()() {
+    if (this->index_ % 4 == 0) this->fill();
+    return this->buffer_[this->index_++ % 4];
+  }
+
+  void discard(seed_type const n) {
+    this->index_ += n;
+    if (this->index_ % 4 != 0) this->fill();
+  }
+
+  // Block `position` of this stream, independent of the current state.
+  void block(seed_type const position, result_type out[4]) const {
+    out[0] = static_cast<result_type>(position);
+    out[1] = static_cast<result_type>(position >> 32);
+    out[2] = static_cast<result_type>(this->stream_);
+    out[3] = static_cast<result_type>(this->stream_ >> 32);
+    philox4x32::encrypt(this->key_, out);
+  }
+
+  // 64 bits from block `position`; convenient for per-element draws.
+  seed_type at(seed_type const position) const {
+    result_type out[4];
+    this->block(position, out);
+    return (static_cast<seed_type>(out[0]) << 32) | out[1];
+  }
+
+  template<class OutputIterator>
+  void generate(OutputIterator first, OutputIterator const last) {
+    for (; first != last; ++first) {
+      *first = (*this)();
+    }
+  }
+
+  static void encrypt(result_type const key[2], result_type ctr[4]) {
+    result_type k0 = key[0], k1 = key[1];
+
+    for (int round = 0; round < 10; ++round) {
+      sml::ext::uint64_t const p0 =
+        static_cast<sml::ext::uint64_t>(0xD2511F53u) * ctr[0];
+      sml::ext::uint64_t const p1 =
+        static_cast<sml::ext::uint64_t>(0xCD9E8D57u) * ctr[2];
+
+      result_type const hi0 = static_cast<result_type>(p0 >> 32);
+      result_type const lo0 = static_cast<result_type>(p0);
+      result_type const hi1 = static_cast<result_type>(p1 >> 32);
+      result_type const lo1 = static_cast<result_type>(p1);
+
+      ctr[0] = hi1 ^ ctr[1] ^ k0;
+      ctr[1] = lo1;
+      ctr[2] = hi0 ^ ctr[3] ^ k1;
+      ctr[3] = lo0;
+
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+  }
+
+  bool operator==(philox4x32 const& r) const {
+    return
+      this->key_[0] == r.key_[0] && this->key_[1] == r.key_[1] &&
+      this->stream_ == r.stream_ && this->index_ == r.index_;
+  }
+  bool operator!=(philox4x32 const& r) const {
+    return !(*this == r);
+  }
+
+private:
+  void fill() {
+    this->block(this->index_ / 4, this->buffer_);
+  }
+
+  result_type key_[2];
+  seed_type   stream_;
+  seed_type   index_;
+  result_type buffer_[4];
+};
+
+}} // namespace sml::random
+
+#endif
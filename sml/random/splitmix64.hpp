@@ -0,0 +1,62 @@
+#ifndef _SML_RANDOM_SPLITMIX64_HPP
+#define _SML_RANDOM_SPLITMIX64_HPP
+
+#include "sml/ext/cstdint.hpp"
+
+namespace sml { namespace random {
+
+// Weyl sequence with a strong 64-bit finalizer.  Used to expand a single
+// seed word into the state of the larger engines.
+class splitmix64 {
+public:
+  typedef sml::ext::uint64_t result_type;
+
+  static result_type const default_seed = 0x853c49e6748fea9bULL;
+
+  static result_type min() { return 0; }
+  static result_type max() { return ~result_type(); }
+
+  explicit splitmix64(result_type const seed = default_seed) :
+    state_(seed) {
+  }
+
+  void seed(result_type const seed = default_seed) {
+    this->state_ = seed;
+  }
+
+  result_type operator()() {
+    this->state_ += 0x9e3779b97f4a7c15ULL;
+    return splitmix64::mix(this->state_);
+  }
+
+  void discard(result_type const n) {
+    this->state_ += 0x9e3779b97f4a7c15ULL * n;
+  }
+
+  template<class OutputIterator>
+  void generate(OutputIterator first, OutputIterator const last) {
+    for (; first != last; ++first) {
+      *first = (*this)();
+    }
+  }
+
+  static result_type mix(result_type z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  bool operator==(splitmix64 const& r) const {
+    return this->state_ == r.state_;
+  }
+  bool operator!=(splitmix64 const& r) const {
+    return !(*this == r);
+  }
+
+private:
+  result_type state_;
+};
+
+}} // namespace sml::random
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef _SML_RANDOM_UNIFORM_INT_HPP
+#define _SML_RANDOM_UNIFORM_INT_HPP
+
+#include <cstdlib>
+#include "sml/ext/cstdint.hpp"
+
+namespace sml { namespace random {
+
+// Range of a random source.  Anything with min()/max() in the style of
+// <random> engines works; nullary functions are taken to behave like
+// std::rand.
+template<class Random>
+struct engine_traits {
+  static sml::ext::uint64_t min(Random& rand) { return rand.min(); }
+  static sml::ext::uint64_t max(Random& rand) { return rand.max(); }
+};
+
+template<class R>
+struct engine_traits<R()> {
+  static sml::ext::uint64_t min(R (&)()) { return 0; }
+  static sml::ext::uint64_t max(R (&)()) { return RAND_MAX; }
+};
+
+template<class R>
+struct engine_traits<R(*)()> {
+  static sml::ext::uint64_t min(R (*)()) { return 0; }
+  static sml::ext::uint64_t max(R (*)()) { return RAND_MAX; }
+};
+
+#ifdef __cpp_noexcept_function_type
+template<class R>
+struct engine_traits<R() noexcept> {
+  static sml::ext::uint64_t min(R (&)() noexcept) { return 0; }
+  static sml::ext::uint64_t max(R (&)() noexcept) { return RAND_MAX; }
+};
+#endif
+
+namespace detail {
+
+inline void multiply(
+  sml::ext::uint64_t const  a,
+  sml::ext::uint64_t const  b,
+  sml::ext::uint64_t&       high,
+  sml::ext::uint64_t&       low
+) {
+  typedef sml::ext::uint64_t uint64_t;
+
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 const m = static_cast<unsigned __int128>(a) * b;
+  high = static_cast<uint64_t>(m >> 64);
+  low  = static_cast<uint64_t>(m);
+#else
+  uint64_t const MASK = 0xffffffffULL;
+  uint64_t const a_lo = a & MASK, a_hi = a >> 32;
+  uint64_t const b_lo = b & MASK, b_hi = b >> 32;
+
+  uint64_t const ll = a_lo * b_lo;
+  uint64_t const lh = a_lo * b_hi;
+  uint64_t const hl = a_hi * b_lo;
+  uint64_t const hh = a_hi * b_hi;
+
+  uint64_t const mid = (ll >> 32) + (lh & MASK) + (hl & MASK);
+  high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  low  = (mid << 32) | (ll & MASK);
+#endif
+}
+
+} // namespace detail
+
+// Returns `bits` (at most 64) uniformly distributed bits, combining as many
+// draws as the source's range requires.
+template<class Random>
+sml::ext::uint64_t uniform_bits(Random& rand, int const bits) {
+  typedef sml::ext::uint64_t     uint64_t;
+  typedef engine_traits<Random>  traits;
+
+  uint64_t const low   = traits::min(rand);
+  uint64_t const range = traits::max(rand) - low;
+
+  if (range == ~uint64_t()) {
+    uint64_t const v = static_cast<uint64_t>(rand()) - low;
+    return bits == 64 ? v : v >> (64 - bits);
+  }
+
+  int per_draw = 0;
+  while (per_draw < 63 && (uint64_t(2) << per_draw) - 1 <= range) {
+    ++per_draw;
+  }
+
+  uint64_t const mask  = (uint64_t(1) << per_draw) - 1;
+  bool     const exact = (range == mask);
+
+  uint64_t result = 0;
+  for (int got = 0; got < bits; ) {
+    uint64_t const v = static_cast<uint64_t>(rand()) - low;
+    if (!exact && v > mask) continue;
+
+    result = (result << per_draw) | v;
+    got   += per_draw;
+  }
+
+  return bits == 64 ? result : result & ((uint64_t(1) << bits) - 1);
+}
+
+// Uniform integer in [0, bound) by Lemire's multiply-shift with rejection:
+// one multiplication per draw, and a division only on the rare path where
+// the low word falls into the biased zone.
+template<class Random>
+sml::ext::uint64_t bounded_rand(Random& rand, sml::ext::uint64_t const bound) {
+  typedef sml::ext::uint64_t uint64_t;
+  typedef sml::ext::uint32_t uint32_t;
+
+  if (bound <= 1) return 0;
+
+  if (bound <= 0xffffffffULL) {
+    uint32_t const s = static_cast<uint32_t>(bound);
+    uint64_t m = sml::random::uniform_bits(rand, 32) * s;
+    uint32_t l = static_cast<uint32_t>(m);
+
+    if (l < s) {
+      uint32_t const threshold = static_cast<uint32_t>(-s) % s;
+      while (l < threshold) {
+        m = sml::random::uniform_bits(rand, 32) * s;
+        l = static_cast<uint32_t>(m);
+      }
+    }
+
+    return m >> 32;
+  }
+
+  uint64_t high, low;
+  sml::random::detail::multiply(
+    sml::random::uniform_bits(rand, 64), bound, high, low
+  );
+
+  if (low < bound) {
+    uint64_t const threshold = (0 - bound) % bound;
+    while (low < threshold) {
+      sml::random::detail::multiply(
+        sml::random::uniform_bits(rand, 64), bound, high, low
+      );
+    }
+  }
+
+  return high;
+}
+
+}} // namespace sml::random
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _SML_RANDOM_UNIFORM_REAL_HPP
+#define _SML_RANDOM_UNIFORM_REAL_HPP
+
+#include "sml/random/uniform_int.hpp"
+
+namespace sml { namespace random {
+
+// Uniform double in [0, 1) with 53 random bits.
+template<class Random>
+double uniform_real(Random& rand) {
+  return
+    static_cast<double>(sml::random::uniform_bits(rand, 53)) *
+    (1.0 / 9007199254740992.0);
+}
+
+// Uniform double in (0, 1), suitable as the argument of log().
+template<class Random>
+double uniform_positive_real(Random& rand) {
+  return
+    (static_cast<double>(sml::random::uniform_bits(rand, 52)) + 0.5) *
+    (1.0 / 4503599627370496.0);
+}
+
+}} // namespace sml::random
+
+#endif
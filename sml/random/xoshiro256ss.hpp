@@ -0,0 +1,123 @@
+#ifndef _SML_RANDOM_XOSHIRO256SS_HPP
+#define _SML_RANDOM_XOSHIRO256SS_HPP
+
+#include "sml/ext/cstdint.hpp"
+#include "sml/random/splitmix64.hpp"
+
+namespace sml { namespace random {
+
+// xoshiro256** by Blackman and Vigna: 256 bits of state, period 2^256-1.
+class xoshiro256ss {
+public:
+  typedef sml::ext::uint64_t result_type;
+
+  static result_type const default_seed = 0x853c49e6748fea9bULL;
+
+  static result_type min() { return 0; }
+  static result_type max() { return ~result_type(); }
+
+  explicit xoshiro256ss(result_type const seed = default_seed) {
+    this->seed(seed);
+  }
+
+  xoshiro256ss(
+    result_type const s0,
+    result_type const s1,
+    result_type const s2,
+    result_type const s3
+  ) {
+    this->state_[0] = s0;
+    this->state_[1] = s1;
+    this->state_[2] = s2;
+    this->state_[3] = s3;
+  }
+
+  void seed(result_type const seed = default_seed) {
+    sml::random::splitmix64 expander(seed);
+    expander.generate(this->state_, this->state_ + 4);
+  }
+
+  result_type operator()() {
+    return xoshiro256ss::step(
+      this->state_[0], this->state_[1], this->state_[2], this->state_[3]
+    );
+  }
+
+  void discard(result_type n) {
+    for (; n > 0; --n) (*this)();
+  }
+
+  // Keeps the state in registers for the whole batch.
+  template<class OutputIterator>
+  void generate(OutputIterator first, OutputIterator const last) {
+    result_type s0 = this->state_[0], s1 = this->state_[1];
+    result_type s2 = this->state_[2], s3 = this->state_[3];
+
+    for (; first != last; ++first) {
+      *first = xoshiro256ss::step(s0, s1, s2, s3);
+    }
+
+    this->state_[0] = s0, this->state_[1] = s1;
+    this->state_[2] = s2, this->state_[3] = s3;
+  }
+
+  // Advances the state by 2^128 steps, which yields 2^128
+  // non-overlapping subsequences for parallel use.
+  void jump() {
+    static result_type const JUMP[4] = {
+      0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+      0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+
+    result_type s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+      for (int b = 0; b < 64; ++b) {
+        if (JUMP[i] & (result_type(1) << b)) {
+          for (int j = 0; j < 4; ++j) s[j] ^= this->state_[j];
+        }
+        (*this)();
+      }
+    }
+
+    for (int j = 0; j < 4; ++j) this->state_[j] = s[j];
+  }
+
+  bool operator==(xoshiro256ss const& r) const {
+    return
+      this->state_[0] == r.state_[0] && this->state_[1] == r.state_[1] &&
+      this->state_[2] == r.state_[2] && this->state_[3] == r.state_[3];
+  }
+  bool operator!=(xoshiro256ss const& r) const {
+    return !(*this == r);
+  }
+
+private:
+  static result_type rotl(result_type const x, int const k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  static result_type step(
+    result_type& s0,
+    result_type& s1,
+    result_type& s2,
+    result_type& s3
+  ) {
+    result_type const result = xoshiro256ss::rotl(s1 * 5, 7) * 9;
+    result_type const t      = s1 << 17;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3  = xoshiro256ss::rotl(s3, 45);
+
+    return result;
+  }
+
+  result_type state_[4];
+};
+
+}} // namespace sml::random
+
+#endif
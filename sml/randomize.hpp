@@ -3,9 +3,13 @@
 
 #include <iterator>
 #include <utility>
+#include "sml/random/uniform_int.hpp"
 
 namespace sml {
 
+// Fisher-Yates shuffle.  `rand` is either a <random>-style engine
+// (result_type, min(), max()) such as sml::random::xoshiro256ss, or a
+// nullary function like std::rand.
 template<class Iterator, class Random>
 Iterator randomize (const Iterator begin, const Iterator end, Random& rand) {
   using std::swap;
@@ -14,11 +18,41 @@ Iterator randomize (const Iterator begin, const Iterator end, Random& rand) {
     difference_type;
 
   for (difference_type i = end - begin - 1; i > 0; --i) {
-    swap(*(begin+i), *(begin+(rand() % (i+1))));
+    const difference_type j = static_cast<difference_type>(
+      sml::random::bounded_rand(rand, static_cast<sml::ext::uint64_t>(i+1))
+    );
+    swap(*(begin+i), *(begin+j));
   }
   return begin;
 }
 
+// Moves a uniformly chosen k-subset of [begin, end), in random order, to
+// the front with k Fisher-Yates steps.  Returns the end of that prefix.
+template<class Iterator, class Random>
+Iterator randomize_first_k(
+  const Iterator begin,
+  const Iterator end,
+  typename std::iterator_traits<Iterator>::difference_type k,
+  Random& rand
+) {
+  using std::swap;
+  typedef
+    typename std::iterator_traits<Iterator>::difference_type
+    difference_type;
+
+  const difference_type n = end - begin;
+  if (k > n) k = n;
+  if (k < 0) k = 0;
+
+  for (difference_type i = 0; i < k; ++i) {
+    const difference_type j = i + static_cast<difference_type>(
+      sml::random::bounded_rand(rand, static_cast<sml::ext::uint64_t>(n-i))
+    );
+    swap(*(begin+i), *(begin+j));
+  }
+  return begin + k;
+}
+
 } // namespace sml
 
 #endif
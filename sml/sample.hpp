@@ -0,0 +1,154 @@
+#ifndef _SML_SAMPLE_HPP
+#define _SML_SAMPLE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/uniform_real.hpp"
+
+namespace sml { namespace detail {
+
+template<class Key, class Value>
+struct _sample_entry_greater {
+  bool operator()(
+    std::pair<Key, Value> const& a,
+    std::pair<Key, Value> const& b
+  ) const {
+    return b.first < a.first;
+  }
+};
+
+} // namespace detail
+
+// Uniform sample of k elements from a sequence of unknown length in one
+// pass (Li's Algorithm L).  The number of random draws is
+// O(k (1 + log(n/k))); skipped elements are only stepped over.  Writes the
+// sample to [out, out + min(k, n)) and returns the end of it.
+template<class InputIterator, class RandomAccessIterator, class Random>
+RandomAccessIterator reservoir_sample(
+  InputIterator              first,
+  const InputIterator        last,
+  const RandomAccessIterator out,
+  const typename std::iterator_traits<RandomAccessIterator>::difference_type k,
+  Random&                    rand
+) {
+  using std::exp;
+  using std::floor;
+  using std::log;
+  typedef
+    typename std::iterator_traits<RandomAccessIterator>::difference_type
+    difference_type;
+
+  if (k <= 0) return out;
+
+  difference_type filled = 0;
+  for (; filled < k && first != last; ++first, ++filled) {
+    *(out + filled) = *first;
+  }
+  if (first == last) return out + filled;
+
+  double w = exp(log(sml::random::uniform_positive_real(rand)) / k);
+  for (;;) {
+    double skip = floor(
+      log(sml::random::uniform_positive_real(rand)) / log(1.0 - w)
+    );
+
+    for (; skip > 0 && first != last; skip -= 1) ++first;
+    if (first == last) break;
+
+    const difference_type slot = static_cast<difference_type>(
+      sml::random::bounded_rand(rand, static_cast<sml::ext::uint64_t>(k))
+    );
+    *(out + slot) = *first;
+    ++first;
+
+    w *= exp(log(sml::random::uniform_positive_real(rand)) / k);
+  }
+
+  return out + k;
+}
+
+// Weighted sample of k elements without replacement in one pass
+// (Efraimidis and Spirakis' A-ExpJ).  `weight(*it)` gives the weight of an
+// element; elements with non-positive weight are never chosen.  Exponential
+// jumps keep the work on the reservoir at O(k log(n/k)).  The sample is
+// written in no particular order; returns the end of it.
+template<
+  class InputIterator,
+  class RandomAccessIterator,
+  class Weight,
+  class Random
+>
+RandomAccessIterator weighted_sample(
+  InputIterator              first,
+  const InputIterator        last,
+  const RandomAccessIterator out,
+  const typename std::iterator_traits<RandomAccessIterator>::difference_type k,
+  Weight                     weight,
+  Random&                    rand
+) {
+  using std::exp;
+  using std::log;
+  typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+  typedef
+    typename std::iterator_traits<RandomAccessIterator>::difference_type
+    difference_type;
+  typedef std::pair<double, value_type> entry_type;
+  typedef sml::detail::_sample_entry_greater<double, value_type> greater_type;
+
+  if (k <= 0) return out;
+
+  // min-heap on log-keys: log(u^(1/w)) = log(u)/w
+  std::vector<entry_type> heap;
+  heap.reserve(static_cast<typename std::vector<entry_type>::size_type>(k));
+
+  for (; first != last && static_cast<difference_type>(heap.size()) < k; ++first) {
+    const double w = weight(*first);
+    if (!(w > 0)) continue;
+
+    const double key = log(sml::random::uniform_positive_real(rand)) / w;
+    heap.push_back(entry_type(key, *first));
+    std::push_heap(heap.begin(), heap.end(), greater_type());
+  }
+
+  if (first != last) {
+    double jump =
+      log(sml::random::uniform_positive_real(rand)) / heap.front().first;
+
+    for (; first != last; ++first) {
+      const double w = weight(*first);
+      if (!(w > 0)) continue;
+
+      jump -= w;
+      if (jump > 0) continue;
+
+      const double threshold = exp(w * heap.front().first);
+      const double r = threshold +
+        sml::random::uniform_real(rand) * (1.0 - threshold);
+      const double key = log(r > 0 ? r : threshold) / w;
+
+      std::pop_heap(heap.begin(), heap.end(), greater_type());
+      heap.back() = entry_type(key, *first);
+      std::push_heap(heap.begin(), heap.end(), greater_type());
+
+      jump = log(sml::random::uniform_positive_real(rand)) / heap.front().first;
+    }
+  }
+
+  RandomAccessIterator it = out;
+  for (
+    typename std::vector<entry_type>::const_iterator e = heap.begin();
+    e != heap.end();
+    ++e, ++it
+  ) {
+    *it = e->second;
+  }
+  return it;
+}
+
+} // namespace sml
+
+#endif
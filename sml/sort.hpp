@@ -1,10 +1,13 @@
 #ifndef _SML_SORT_HPP
 #define _SML_SORT_HPP
 
+#include <algorithm>
 #include <iterator>
 #include <utility>
 #include "sml/op/lesser.hpp"
+#include "sml/op/order_traits.hpp"
 #include "sml/sort/insertion_sort.hpp"
+#include "sml/sort/radix_sort.hpp"
 
 namespace sml { namespace detail {
 
@@ -53,12 +56,78 @@ void _sort(const Iterator begin, const Iterator end, Lesser lesser) {
   }
 }
 
+enum { _SORT_COMPARE, _SORT_RADIX, _SORT_RADIX_REVERSE };
+
+// Integers in their natural order, or its reverse, are radix sorted once
+// there are enough of them to pay for the counting passes.
+template<class T, class Lesser>
+struct _sort_kernel {
+  enum {
+    value =
+      !sml::sorting::detail::_radix_key<T>::value ? _SORT_COMPARE :
+      sml::op::is_natural_order<Lesser, T>::value ? _SORT_RADIX :
+      sml::op::is_reverse_order<Lesser, T>::value ? _SORT_RADIX_REVERSE :
+      _SORT_COMPARE
+  };
+};
+
+template<int>
+struct _sort_tag {
+};
+
+enum { _RADIX_THRESHOLD = 256 };
+
+template<class Iterator, class Lesser>
+Iterator _sort(
+  const Iterator begin,
+  const Iterator end,
+  Lesser         lesser,
+  _sort_tag<_SORT_COMPARE>
+) {
+  sml::detail::_sort(begin, end, lesser);
+  return sml::sorting::insertion_sort(begin, end, lesser);
+}
+
+template<class Iterator, class Lesser>
+Iterator _sort(
+  const Iterator begin,
+  const Iterator end,
+  Lesser         lesser,
+  _sort_tag<_SORT_RADIX>
+) {
+  if (end - begin < _RADIX_THRESHOLD) {
+    return sml::detail::_sort(begin, end, lesser, _sort_tag<_SORT_COMPARE>());
+  }
+  return sml::sorting::radix_sort(begin, end);
+}
+
+template<class Iterator, class Lesser>
+Iterator _sort(
+  const Iterator begin,
+  const Iterator end,
+  Lesser         lesser,
+  _sort_tag<_SORT_RADIX_REVERSE>
+) {
+  if (end - begin < _RADIX_THRESHOLD) {
+    return sml::detail::_sort(begin, end, lesser, _sort_tag<_SORT_COMPARE>());
+  }
+  sml::sorting::radix_sort(begin, end);
+  std::reverse(begin, end);
+  return begin;
+}
+
 } // namespace detail
 
 template<class Iterator, class Lesser>
 Iterator sort(const Iterator begin, const Iterator end, Lesser lesser) {
-  detail::_sort(begin, end, lesser);
-  return sml::sorting::insertion_sort(begin, end, lesser);
+  typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+  return sml::detail::_sort(
+    begin, end, lesser,
+    sml::detail::_sort_tag<
+      sml::detail::_sort_kernel<value_type, Lesser>::value
+    >()
+  );
 }
 
 template<class Iterator>
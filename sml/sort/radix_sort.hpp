@@ -0,0 +1,166 @@
+#ifndef _SML_SORT_RADIX_SORT_HPP
+#define _SML_SORT_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace sml { namespace sorting { namespace detail {
+
+// Maps a key to an unsigned integer of the same width that orders the
+// same way: signed keys have their sign bit flipped.
+template<class T, class Unsigned>
+struct _radix_key_base {
+  enum { value = true, BYTES = sizeof(Unsigned) };
+  typedef Unsigned key_type;
+
+  static Unsigned encode(const T x) {
+    const Unsigned sign =
+      std::numeric_limits<T>::is_signed ?
+        static_cast<Unsigned>(Unsigned(1) << (8 * sizeof(Unsigned) - 1)) :
+        Unsigned(0);
+    return static_cast<Unsigned>(static_cast<Unsigned>(x) ^ sign);
+  }
+};
+
+// Integer types radix_sort accepts.
+template<class T>
+struct _radix_key {
+  enum { value = false };
+};
+
+template<class T>
+struct _radix_key<const T> : _radix_key<T> {
+};
+
+template<>
+struct _radix_key<char> : _radix_key_base<char, unsigned char> {
+};
+
+template<>
+struct _radix_key<signed char> : _radix_key_base<signed char, unsigned char> {
+};
+
+template<>
+struct _radix_key<unsigned char> :
+  _radix_key_base<unsigned char, unsigned char> {
+};
+
+template<>
+struct _radix_key<short> : _radix_key_base<short, unsigned short> {
+};
+
+template<>
+struct _radix_key<unsigned short> :
+  _radix_key_base<unsigned short, unsigned short> {
+};
+
+template<>
+struct _radix_key<int> : _radix_key_base<int, unsigned int> {
+};
+
+template<>
+struct _radix_key<unsigned int> : _radix_key_base<unsigned int, unsigned int> {
+};
+
+template<>
+struct _radix_key<long> : _radix_key_base<long, unsigned long> {
+};
+
+template<>
+struct _radix_key<unsigned long> :
+  _radix_key_base<unsigned long, unsigned long> {
+};
+
+template<>
+struct _radix_key<long long> : _radix_key_base<long long, unsigned long long> {
+};
+
+template<>
+struct _radix_key<unsigned long long> :
+  _radix_key_base<unsigned long long, unsigned long long> {
+};
+
+template<class InputIterator, class OutputIterator, class Key>
+void _radix_scatter(
+  InputIterator        first,
+  const InputIterator  last,
+  const OutputIterator out,
+  std::size_t* const   offset,
+  const int            shift,
+  Key
+) {
+  for (; first != last; ++first) {
+    const std::size_t digit = (Key::encode(*first) >> shift) & 0xff;
+    *(out + offset[digit]++) = *first;
+  }
+}
+
+} // namespace detail
+
+// Least significant digit first radix sort of integers in ascending order,
+// a byte at a time through a buffer of the same size.  Bytes that all keys
+// share are skipped, so narrow value ranges in wide types cost fewer
+// passes.
+template<class RandomAccessIterator>
+RandomAccessIterator radix_sort(
+  const RandomAccessIterator begin,
+  const RandomAccessIterator end
+) {
+  typedef
+    typename std::iterator_traits<RandomAccessIterator>::value_type
+    value_type;
+  typedef sml::sorting::detail::_radix_key<value_type> key;
+  typedef typename key::key_type                       key_type;
+
+  enum { RADIX = 256 };
+
+  const std::size_t n = end - begin;
+  if (n < 2) return begin;
+
+  std::vector<std::size_t> count(key::BYTES * RADIX);
+  for (RandomAccessIterator it = begin; it != end; ++it) {
+    key_type k = key::encode(*it);
+    for (int b = 0; b < key::BYTES; ++b, k >>= 8) {
+      ++count[b * RADIX + (k & 0xff)];
+    }
+  }
+
+  std::vector<value_type> buffer(n);
+  bool in_buffer = false;
+  const key_type first = key::encode(*begin);
+
+  for (int b = 0; b < key::BYTES; ++b) {
+    std::size_t* const offset = &count[b * RADIX];
+    const int shift = 8 * b;
+    if (offset[(first >> shift) & 0xff] == n) continue;
+
+    std::size_t sum = 0;
+    for (int d = 0; d < RADIX; ++d) {
+      const std::size_t c = offset[d];
+      offset[d] = sum;
+      sum += c;
+    }
+
+    if (in_buffer) {
+      sml::sorting::detail::_radix_scatter(
+        buffer.begin(), buffer.end(), begin, offset, shift, key()
+      );
+    }
+    else {
+      sml::sorting::detail::_radix_scatter(
+        begin, end, buffer.begin(), offset, shift, key()
+      );
+    }
+    in_buffer = !in_buffer;
+  }
+
+  if (in_buffer) std::copy(buffer.begin(), buffer.end(), begin);
+  return begin;
+}
+
+}} // namespace sml::sorting
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef _SML_UTILITY_PREFIX_KEY_HPP
+#define _SML_UTILITY_PREFIX_KEY_HPP
+
+#include <cstddef>
+#include <string>
+#include "sml/ext/cstdint.hpp"
+
+namespace sml { namespace utility {
+
+// Stand-in for a string key in sorts, searches and trees: the first
+// `Bytes` characters as big-endian words, the length, and a pointer to the
+// string itself.  Keys whose prefixes differ, or which fit in the prefix,
+// compare without touching the string; only longer keys with equal
+// prefixes compare the rest of it.  Orders like the string does, with
+// characters compared as unsigned char, and must not outlive the string.
+// `Bytes` is a multiple of 8.
+template<std::size_t Bytes = 8, class String = std::string>
+class prefix_key {
+public:
+  typedef String                     string_type;
+  typedef sml::ext::uint64_t         word_type;
+  typedef typename String::size_type size_type;
+
+  enum { WORDS = Bytes / sizeof(word_type) };
+
+  prefix_key() :
+    size_(0),
+    data_(0),
+    key_(0) {
+    for (int i = 0; i < WORDS; ++i) this->prefix_[i] = 0;
+  }
+
+  explicit prefix_key(const String& key) :
+    size_(key.size()),
+    data_(key.data()),
+    key_(&key) {
+    for (int i = 0; i < WORDS; ++i) {
+      word_type w = 0;
+      for (size_type j = 0; j < sizeof(word_type); ++j) {
+        const size_type at = i * sizeof(word_type) + j;
+        const unsigned char c =
+          at < this->size_ ? static_cast<unsigned char>(this->data_[at]) : 0;
+        w = (w << 8) | c;
+      }
+      this->prefix_[i] = w;
+    }
+  }
+
+  const String& key()  const { return *this->key_; }
+  size_type     size() const { return this->size_; }
+
+  // Negative, zero or positive as this key is less than, equal to or
+  // greater than `other`.
+  int compare(const prefix_key& other) const {
+    for (int i = 0; i < WORDS; ++i) {
+      if (this->prefix_[i] != other.prefix_[i]) {
+        return this->prefix_[i] < other.prefix_[i] ? -1 : 1;
+      }
+    }
+
+    if (this->size_ > Bytes && other.size_ > Bytes) {
+      const size_type n =
+        (this->size_ < other.size_ ? this->size_ : other.size_) - Bytes;
+      const int res = String::traits_type::compare(
+        this->data_ + Bytes, other.data_ + Bytes, n
+      );
+      if (res != 0) return res;
+    }
+    return this->size_ < other.size_ ? -1 : this->size_ > other.size_ ? 1 : 0;
+  }
+
+  friend bool operator<(const prefix_key& a, const prefix_key& b) {
+    return a.compare(b) < 0;
+  }
+
+  friend bool operator>(const prefix_key& a, const prefix_key& b) {
+    return a.compare(b) > 0;
+  }
+
+  friend bool operator<=(const prefix_key& a, const prefix_key& b) {
+    return a.compare(b) <= 0;
+  }
+
+  friend bool operator>=(const prefix_key& a, const prefix_key& b) {
+    return a.compare(b) >= 0;
+  }
+
+  friend bool operator==(const prefix_key& a, const prefix_key& b) {
+    return a.compare(b) == 0;
+  }
+
+  friend bool operator!=(const prefix_key& a, const prefix_key& b) {
+    return a.compare(b) != 0;
+  }
+
+private:
+  word_type     prefix_[WORDS];
+  size_type     size_;
+  const char*   data_;
+  const String* key_;
+};
+
+template<class String>
+prefix_key<8, String> make_prefix_key(const String& key) {
+  return prefix_key<8, String>(key);
+}
+
+}} // namespace sml::utility
+
+#endif
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/binary_search_batch.hpp"
+
+namespace {
+
+using std::list;
+using std::vector;
+
+typedef vector<int>::const_iterator iterator;
+
+struct reverse_comparator {
+  int operator()(int a, int b) const {
+    return b < a ? -1 : (a < b ? 1 : 0);
+  }
+};
+
+void compare_with_std(vector<int> const& seq, vector<int> const& keys) {
+  vector<iterator> res;
+  sml::algorithm::binary_search_batch(
+    seq.begin(), seq.end(), keys.begin(), keys.end(), std::back_inserter(res)
+  );
+
+  ASSERT_EQ(keys.size(), res.size());
+  for (vector<int>::size_type i = 0; i < keys.size(); ++i) {
+    const iterator lb = std::lower_bound(seq.begin(), seq.end(), keys[i]);
+
+    if (lb != seq.end() && *lb == keys[i]) ASSERT_EQ(lb, res[i]);
+    else                                   ASSERT_EQ(seq.end(), res[i]);
+  }
+}
+
+vector<int> make_sequence(int n) {
+  vector<int> seq;
+  for (int i = 0; i < n; ++i) seq.push_back(3 * (i / 2));
+  return seq;
+}
+
+TEST(BinarySearchBatch, NoKeys) {
+  vector<int> seq = make_sequence(10), keys;
+  compare_with_std(seq, keys);
+}
+
+TEST(BinarySearchBatch, EmptyRange) {
+  vector<int> seq, keys;
+  keys.push_back(4), keys.push_back(1), keys.push_back(7);
+  compare_with_std(seq, keys);
+}
+
+TEST(BinarySearchBatch, UnsortedKeys) {
+  for (int n = 1; n < 70; ++n) {
+    const vector<int> seq = make_sequence(n);
+
+    vector<int> keys;
+    for (int i = -2; i < 3 * n / 2 + 2; ++i) keys.push_back(i);
+    std::reverse(keys.begin(), keys.end());
+    std::swap(keys[1], keys[keys.size() / 2]);
+
+    compare_with_std(seq, keys);
+  }
+}
+
+TEST(BinarySearchBatch, SortedKeys) {
+  for (int n = 1; n < 70; ++n) {
+    const vector<int> seq = make_sequence(n);
+
+    vector<int> keys;
+    for (int i = -2; i < 3 * n / 2 + 2; ++i) keys.push_back(i), keys.push_back(i);
+
+    compare_with_std(seq, keys);
+  }
+}
+
+TEST(BinarySearchBatch, SparseSortedKeys) {
+  const vector<int> seq = make_sequence(5000);
+
+  vector<int> keys;
+  keys.push_back(0), keys.push_back(3), keys.push_back(4000),
+  keys.push_back(4001), keys.push_back(7497), keys.push_back(9000);
+
+  compare_with_std(seq, keys);
+}
+
+TEST(BinarySearchBatch, KeysFromList) {
+  int seq[5] = {2, 4, 6, 8, 10};
+
+  list<int> keys;
+  keys.push_back(8), keys.push_back(3), keys.push_back(2);
+
+  int* res[3];
+  int** const last = sml::algorithm::binary_search_batch(
+    seq, seq+5, keys.begin(), keys.end(), res
+  );
+
+  ASSERT_EQ(res+3, last);
+  EXPECT_EQ(seq+3, res[0]);
+  EXPECT_EQ(seq+5, res[1]);
+  EXPECT_EQ(seq,   res[2]);
+}
+
+TEST(BinarySearchBatch, WithComparator) {
+  int seq[6]  = {9, 7, 7, 4, 2, 1};
+  int keys[4] = {7, 3, 1, 9};
+
+  int* res[4];
+  sml::algorithm::binary_search_batch(
+    seq, seq+6, keys, keys+4, res, reverse_comparator()
+  );
+
+  EXPECT_EQ(seq+1, res[0]);
+  EXPECT_EQ(seq+6, res[1]);
+  EXPECT_EQ(seq+5, res[2]);
+  EXPECT_EQ(seq,   res[3]);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
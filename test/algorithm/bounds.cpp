@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/bounds.hpp"
+
+namespace {
+
+using std::pair;
+using std::vector;
+
+typedef vector<int>::const_iterator iterator;
+
+struct reverse_comparator {
+  int operator()(int a, int b) const {
+    return b < a ? -1 : (a < b ? 1 : 0);
+  }
+};
+
+vector<int> make_sequence(int n, int run) {
+  vector<int> seq;
+  for (int i = 0; i < n; ++i) seq.push_back(2 * (i / run));
+  return seq;
+}
+
+void compare_with_std(vector<int> const& seq) {
+  const iterator b = seq.begin(), e = seq.end();
+  const int top = seq.empty() ? 0 : seq.back();
+
+  for (int v = -2; v <= top + 2; ++v) {
+    const iterator lb = std::lower_bound(b, e, v);
+    const iterator ub = std::upper_bound(b, e, v);
+
+    ASSERT_EQ(lb, sml::algorithm::lower_bound(b, e, v));
+    ASSERT_EQ(ub, sml::algorithm::upper_bound(b, e, v));
+
+    const pair<iterator, iterator> range = sml::algorithm::equal_range(b, e, v);
+    ASSERT_EQ(lb, range.first)  << "n " << seq.size() << " v " << v;
+    ASSERT_EQ(ub, range.second) << "n " << seq.size() << " v " << v;
+
+    for (iterator hint = b; ; ++hint) {
+      ASSERT_EQ(lb, sml::algorithm::gallop_lower_bound(b, e, hint, v));
+      ASSERT_EQ(ub, sml::algorithm::gallop_upper_bound(b, e, hint, v));
+      if (hint == e) break;
+    }
+  }
+}
+
+TEST(Bounds, Empty) {
+  compare_with_std(vector<int>());
+}
+
+TEST(Bounds, Distinct) {
+  for (int n = 1; n < 40; ++n) compare_with_std(make_sequence(n, 1));
+}
+
+TEST(Bounds, Runs) {
+  for (int n = 1; n < 40; ++n) compare_with_std(make_sequence(n, 3));
+  compare_with_std(make_sequence(200, 50));
+  compare_with_std(make_sequence(100, 100));
+}
+
+TEST(Bounds, EqualRangeInArray) {
+  const int arr[4] = {1, 4, 4, 9};
+  const pair<const int*, const int*> range =
+    sml::algorithm::equal_range(arr, arr+4, 4);
+
+  EXPECT_EQ(arr+1, range.first);
+  EXPECT_EQ(arr+3, range.second);
+}
+
+TEST(Bounds, WithComparator) {
+  int seq[7] = {9, 7, 7, 7, 4, 2, 1};
+
+  const pair<int*, int*> range =
+    sml::algorithm::equal_range(seq, seq+7, 7, reverse_comparator());
+  EXPECT_EQ(seq+1, range.first);
+  EXPECT_EQ(seq+4, range.second);
+
+  EXPECT_EQ(seq+4, sml::algorithm::lower_bound(seq, seq+7, 5, reverse_comparator()));
+  EXPECT_EQ(seq+1, sml::algorithm::upper_bound(seq, seq+7, 9, reverse_comparator()));
+  EXPECT_EQ(seq+1, sml::algorithm::gallop_lower_bound(
+    seq, seq+7, seq+6, 7, reverse_comparator()
+  ));
+  EXPECT_EQ(seq+4, sml::algorithm::gallop_upper_bound(
+    seq, seq+7, seq, 7, reverse_comparator()
+  ));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
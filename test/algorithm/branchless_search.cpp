@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/branchless_search.hpp"
+
+namespace {
+
+using std::deque;
+using std::vector;
+
+int reverse_comparator(int a, int b) {
+  return a > b ? -1 : a < b ? 1 : 0;
+}
+
+template<class Container>
+void compare_with_std(Container const& seq) {
+  typedef typename Container::const_iterator iterator;
+
+  for (int v = -1; v <= 2 * static_cast<int>(seq.size()) + 1; ++v) {
+    iterator const lb = sml::algorithm::branchless_lower_bound(
+      seq.begin(), seq.end(), v
+    );
+    iterator const ub = sml::algorithm::branchless_upper_bound(
+      seq.begin(), seq.end(), v
+    );
+
+    ASSERT_EQ(std::lower_bound(seq.begin(), seq.end(), v), lb);
+    ASSERT_EQ(std::upper_bound(seq.begin(), seq.end(), v), ub);
+  }
+}
+
+TEST(BranchlessSearch, InEmptyArray) {
+  int seq[0] = {};
+
+  EXPECT_EQ(seq, sml::algorithm::branchless_lower_bound(seq, seq, 0));
+  EXPECT_EQ(seq, sml::algorithm::branchless_upper_bound(seq, seq, 0));
+}
+
+TEST(BranchlessSearch, AllSizesInVector) {
+  for (int n = 1; n < 70; ++n) {
+    vector<int> seq;
+    for (int i = 0; i < n; ++i) seq.push_back(2 * i);
+    compare_with_std(seq);
+  }
+}
+
+TEST(BranchlessSearch, DuplicatesInVector) {
+  vector<int> seq;
+  for (int i = 0; i < 50; ++i) seq.push_back(i / 7);
+  compare_with_std(seq);
+
+  vector<int> same(33, 4);
+  compare_with_std(same);
+}
+
+TEST(BranchlessSearch, InDeque) {
+  deque<int> seq;
+  for (int i = 0; i < 1000; ++i) seq.push_back(i / 3);
+  compare_with_std(seq);
+}
+
+TEST(BranchlessSearch, WithComparator) {
+  int seq[7] = {9, 7, 7, 5, 3, 3, 1};
+
+  EXPECT_EQ(seq+1,
+    sml::algorithm::branchless_lower_bound(seq, seq+7, 7, reverse_comparator));
+  EXPECT_EQ(seq+3,
+    sml::algorithm::branchless_upper_bound(seq, seq+7, 7, reverse_comparator));
+  EXPECT_EQ(seq+7,
+    sml::algorithm::branchless_lower_bound(seq, seq+7, 0, reverse_comparator));
+  EXPECT_EQ(seq,
+    sml::algorithm::branchless_upper_bound(seq, seq+7, 10, reverse_comparator));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/eytzinger_index.hpp"
+
+namespace {
+
+using std::list;
+using std::vector;
+
+typedef sml::algorithm::eytzinger_index<int> index_type;
+typedef index_type::size_type                size_type;
+
+void compare_with_std(vector<int> const& seq) {
+  index_type const index(seq.begin(), seq.end());
+  ASSERT_EQ(seq.size(), index.size());
+
+  for (int v = -2; v <= 2 * static_cast<int>(seq.size()) + 2; ++v) {
+    size_type const lb =
+      std::lower_bound(seq.begin(), seq.end(), v) - seq.begin();
+    size_type const ub =
+      std::upper_bound(seq.begin(), seq.end(), v) - seq.begin();
+
+    ASSERT_EQ(lb, index.lower_bound(v));
+    ASSERT_EQ(ub, index.upper_bound(v));
+    ASSERT_EQ(lb, index.equal_range(v).first);
+    ASSERT_EQ(ub, index.equal_range(v).second);
+    ASSERT_EQ(ub - lb, index.count(v));
+    ASSERT_EQ(lb == ub ? seq.size() : lb, index.find(v));
+  }
+
+  for (size_type i = 0; i < seq.size(); ++i) {
+    ASSERT_EQ(seq[i], index.at(i));
+  }
+}
+
+TEST(EytzingerIndex, Empty) {
+  index_type index;
+
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(0u, index.lower_bound(3));
+  EXPECT_EQ(0u, index.upper_bound(3));
+  EXPECT_EQ(0u, index.find(3));
+}
+
+TEST(EytzingerIndex, AtOutOfRange) {
+  index_type const empty;
+  EXPECT_THROW(empty.at(0), std::out_of_range);
+
+  int const seq[3] = {1, 2, 3};
+  index_type const index(seq, seq + 3);
+  EXPECT_EQ(3, index.at(2));
+  EXPECT_THROW(index.at(3), std::out_of_range);
+  EXPECT_THROW(index.at(100), std::out_of_range);
+}
+
+TEST(EytzingerIndex, Copy) {
+  vector<int> seq;
+  for (int i = 0; i < 100; ++i) seq.push_back(2 * i);
+  index_type const index(seq.begin(), seq.end());
+
+  index_type copy(index), assigned;
+  assigned = index;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(static_cast<size_type>(i), copy.find(2 * i));
+    EXPECT_EQ(static_cast<size_type>(i), assigned.find(2 * i));
+    EXPECT_EQ(2 * i, assigned.at(i));
+  }
+  EXPECT_EQ(100u, copy.find(1));
+
+  assigned = index_type();
+  EXPECT_TRUE(assigned.empty());
+  EXPECT_EQ(0u, assigned.find(0));
+}
+
+TEST(EytzingerIndex, AllSizes) {
+  for (int n = 1; n < 80; ++n) {
+    vector<int> seq;
+    for (int i = 0; i < n; ++i) seq.push_back(2 * i + 1);
+    compare_with_std(seq);
+  }
+}
+
+TEST(EytzingerIndex, Duplicates) {
+  vector<int> seq;
+  for (int i = 0; i < 100; ++i) seq.push_back(i / 6);
+  compare_with_std(seq);
+
+  compare_with_std(vector<int>(17, 5));
+}
+
+TEST(EytzingerIndex, FromList) {
+  list<int> seq;
+  seq.push_back(3), seq.push_back(5), seq.push_back(8);
+  index_type index(seq.begin(), seq.end());
+
+  EXPECT_EQ(1u, index.find(5));
+  EXPECT_EQ(3u, index.find(4));
+  EXPECT_EQ(2u, index.lower_bound(6));
+}
+
+TEST(EytzingerIndex, WithLesser) {
+  int seq[6] = {9, 7, 7, 4, 2, 1};
+  sml::algorithm::eytzinger_index< int, std::greater<int> > index(seq, seq+6);
+
+  EXPECT_EQ(1u, index.lower_bound(7));
+  EXPECT_EQ(3u, index.upper_bound(7));
+  EXPECT_EQ(4u, index.find(2));
+  EXPECT_EQ(6u, index.find(3));
+  EXPECT_EQ(9,  index.at(0));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/learned_index.hpp"
+
+namespace {
+
+using std::vector;
+
+typedef vector<long>::const_iterator iterator;
+
+void compare_with_std(
+  vector<long> const& seq,
+  vector<long> const& keys,
+  const std::size_t   epsilon
+) {
+  const sml::algorithm::learned_index<iterator> index(
+    seq.begin(), seq.end(), epsilon
+  );
+  ASSERT_EQ(seq.size(), index.size());
+
+  for (vector<long>::size_type i = 0; i < keys.size(); ++i) {
+    const long v = keys[i];
+    const iterator lb = std::lower_bound(seq.begin(), seq.end(), v);
+    const iterator ub = std::upper_bound(seq.begin(), seq.end(), v);
+
+    ASSERT_EQ(lb, index.lower_bound(v)) << "v " << v;
+    ASSERT_EQ(ub, index.upper_bound(v)) << "v " << v;
+    ASSERT_EQ(lb, index.equal_range(v).first);
+    ASSERT_EQ(ub, index.equal_range(v).second);
+    ASSERT_EQ(lb == ub ? seq.end() : lb, index.find(v));
+  }
+}
+
+vector<long> every_key(vector<long> const& seq) {
+  vector<long> keys;
+  if (seq.empty()) return keys;
+
+  for (long v = seq.front() - 3; v <= seq.back() + 3; ++v) keys.push_back(v);
+  return keys;
+}
+
+TEST(LearnedIndex, Empty) {
+  vector<long> seq;
+  sml::algorithm::learned_index<iterator> index(seq.begin(), seq.end());
+
+  EXPECT_EQ(0u, index.segments());
+  EXPECT_EQ(seq.end(), index.lower_bound(3));
+  EXPECT_EQ(seq.end(), index.find(3));
+}
+
+TEST(LearnedIndex, Linear) {
+  vector<long> seq;
+  for (long i = 0; i < 10000; ++i) seq.push_back(1000 + 7 * i);
+
+  const sml::algorithm::learned_index<iterator> index(seq.begin(), seq.end());
+  EXPECT_EQ(1u, index.segments());
+  EXPECT_EQ(1u, index.height());
+
+  compare_with_std(seq, every_key(seq), 32);
+}
+
+TEST(LearnedIndex, Piecewise) {
+  vector<long> seq;
+  long v = 0;
+  for (long i = 0; i < 20000; ++i) {
+    v += 1 + (i / 500 % 3) * 5 + (i % 7 == 0 ? 11 : 0);
+    seq.push_back(v);
+  }
+
+  const sml::algorithm::learned_index<iterator> index(seq.begin(), seq.end(), 4);
+  EXPECT_LT(1u, index.segments());
+  EXPECT_LT(1u, index.height());
+  EXPECT_GT(seq.size(), index.segments());
+
+  compare_with_std(seq, every_key(seq), 4);
+  compare_with_std(seq, every_key(seq), 1);
+}
+
+TEST(LearnedIndex, Duplicates) {
+  vector<long> seq;
+  for (long i = 0; i < 3000; ++i) {
+    const int copies = i % 50 == 0 ? 200 : 1 + static_cast<int>(i % 3);
+    for (int j = 0; j < copies; ++j) seq.push_back(i * i / 10);
+  }
+
+  compare_with_std(seq, every_key(seq), 8);
+}
+
+TEST(LearnedIndex, Unsigned) {
+  vector<unsigned> seq;
+  for (unsigned i = 0; i < 1000; ++i) seq.push_back(5 + i * i);
+
+  sml::algorithm::learned_index<unsigned*> index(&seq[0], &seq[0] + seq.size(), 2);
+
+  EXPECT_EQ(&seq[0],        index.lower_bound(0u));
+  EXPECT_EQ(&seq[0] + 31,   index.find(5 + 31 * 31));
+  EXPECT_EQ(&seq[0] + 32,   index.upper_bound(5 + 31 * 31));
+  EXPECT_EQ(&seq[0] + 1000, index.find(7));
+  EXPECT_EQ(&seq[0] + 1000, index.lower_bound(~0u));
+}
+
+TEST(LearnedIndex, ExtremeSignedKeys) {
+  int seq[5] = {INT_MIN, -5, 0, 7, INT_MAX};
+
+  sml::algorithm::learned_index<int*> index(seq, seq + 5, 1);
+  EXPECT_LE(1u, index.height());
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(seq + i,     index.find(seq[i]));
+    EXPECT_EQ(seq + i + 1, index.upper_bound(seq[i]));
+  }
+  EXPECT_EQ(seq + 1, index.lower_bound(INT_MIN + 1));
+  EXPECT_EQ(seq + 2, index.lower_bound(-4));
+  EXPECT_EQ(seq + 5, index.find(8));
+
+  vector<long> wide;
+  for (long i = -500; i < 500; ++i) wide.push_back(i * i * i * 1000003L);
+  compare_with_std(wide, wide, 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
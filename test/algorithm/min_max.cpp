@@ -1,7 +1,14 @@
+#include <list>
 #include <vector>
 #include <utility>
+#include <limits>
+#include <functional>
 #include <gtest/gtest.h>
 #include "sml/algorithm/min_max.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/op/greater.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
 
 namespace {
 
@@ -154,6 +161,151 @@ TEST(MinMax, hasDuplicateMinMax) {
   ASSERT_EQ(102,   *(res.second));  
 }
 
+// First minimum and first maximum, skipping NaNs.
+template<class T>
+pair<const T*, const T*> first_min_max(const T* begin, const T* end) {
+  const T* min = end;
+  const T* max = end;
+  for (const T* it = begin; it != end; ++it) {
+    if (!(*it == *it)) continue;
+    if (min == end || *it < *min) min = it;
+    if (max == end || *max < *it) max = it;
+  }
+  return std::make_pair(min, max);
+}
+
+template<class T>
+void compare_with_reference(vector<T> const& seq) {
+  const T* const begin = seq.empty() ? 0 : &seq[0];
+  const T* const end   = begin + seq.size();
+
+  const pair<const T*, const T*> expected = first_min_max(begin, end);
+  const pair<const T*, const T*> res = sml::algorithm::min_max(begin, end);
+
+  ASSERT_EQ(expected.first,  res.first)  << "n " << seq.size();
+  ASSERT_EQ(expected.second, res.second) << "n " << seq.size();
+}
+
+template<class T>
+void check_vectorized(const T low, const unsigned long spread) {
+  sml::random::xoshiro256ss rand(7);
+
+  const int sizes[9] = {0, 1, 2, 7, 512, 513, 1100, 2049, 5000};
+  for (int s = 0; s < 9; ++s) {
+    vector<T> seq;
+    for (int i = 0; i < sizes[s]; ++i) {
+      seq.push_back(low + T(sml::random::bounded_rand(rand, spread)));
+    }
+    compare_with_reference(seq);
+  }
+}
+
+TEST(MinMax, VectorizedInt32) {
+  check_vectorized<sml::ext::int32_t>(-50, 100);
+  check_vectorized<sml::ext::int32_t>(-2000000000, 4000000000ul);
+}
+
+TEST(MinMax, VectorizedUInt32) {
+  check_vectorized<sml::ext::uint32_t>(0, 100);
+  check_vectorized<sml::ext::uint32_t>(10, 4000000000ul);
+}
+
+TEST(MinMax, VectorizedInt64) {
+  check_vectorized<sml::ext::int64_t>(-50, 100);
+  check_vectorized<sml::ext::int64_t>(-(1L << 62), ~0ul);
+}
+
+TEST(MinMax, VectorizedUInt64) {
+  check_vectorized<sml::ext::uint64_t>(0, 100);
+  check_vectorized<sml::ext::uint64_t>(1ul << 62, ~0ul);
+}
+
+TEST(MinMax, VectorizedFloat) {
+  check_vectorized<float>(-50.0f, 100);
+  check_vectorized<double>(-50.0, 100);
+}
+
+TEST(MinMax, ExtremesAcrossBlocks) {
+  vector<int> seq(3000, 5);
+  seq[1700] = -7, seq[2600] = -7, seq[900] = 12, seq[2999] = 12;
+  compare_with_reference(seq);
+
+  vector<int> same(2000, std::numeric_limits<int>::max());
+  compare_with_reference(same);
+}
+
+TEST(MinMax, NaN) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+
+  vector<double> seq(1500, 1.0);
+  seq[0] = nan, seq[3] = nan, seq[700] = nan, seq[1400] = -inf;
+  seq[1000] = 2.0, seq[1499] = nan;
+  compare_with_reference(seq);
+
+  vector<double> nans(600, nan);
+  pair<double*, double*> res = sml::algorithm::min_max(&nans[0], &nans[0] + 600);
+  ASSERT_EQ(&nans[0] + 600, res.first);
+  ASSERT_EQ(&nans[0] + 600, res.second);
+
+  nans[599] = inf;
+  res = sml::algorithm::min_max(&nans[0], &nans[0] + 600);
+  ASSERT_EQ(&nans[599], res.first);
+  ASSERT_EQ(&nans[599], res.second);
+}
+
+TEST(MinMax, NaNSameThroughIterators) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  vector<double> seq(4, nan);
+  seq[1] = 1.0, seq[2] = 2.0, seq[3] = 0.5;
+
+  const pair<double*, double*> raw =
+    sml::algorithm::min_max(&seq[0], &seq[0] + 4);
+  const pair<vector<double>::iterator, vector<double>::iterator> it =
+    sml::algorithm::min_max(seq.begin(), seq.end());
+
+  ASSERT_EQ(&seq[3], raw.first);
+  ASSERT_EQ(&seq[2], raw.second);
+  ASSERT_EQ(seq.begin() + 3, it.first);
+  ASSERT_EQ(seq.begin() + 2, it.second);
+
+  std::list<double> nans(3, nan);
+  ASSERT_TRUE(
+    sml::algorithm::min_max(nans.begin(), nans.end()).first == nans.end()
+  );
+
+  const pair<vector<double>::iterator, vector<double>::iterator> rev =
+    sml::algorithm::min_max(seq.begin(), seq.end(), sml::op::greater());
+  ASSERT_EQ(seq.begin() + 2, rev.first);
+  ASSERT_EQ(seq.begin() + 3, rev.second);
+}
+
+TEST(MinMax, SameThroughIterators) {
+  vector<int> seq(3000, 5);
+  seq[1700] = -7, seq[2600] = -7, seq[900] = 12, seq[2999] = 12;
+
+  const pair<int*, int*> raw = sml::algorithm::min_max(&seq[0], &seq[0] + 3000);
+  const pair<vector<int>::iterator, vector<int>::iterator> it =
+    sml::algorithm::min_max(seq.begin(), seq.end());
+  ASSERT_EQ(raw.first  - &seq[0], it.first  - seq.begin());
+  ASSERT_EQ(raw.second - &seq[0], it.second - seq.begin());
+}
+
+TEST(MinMax, ReverseOrder) {
+  vector<int> seq(3000, 5);
+  seq[1700] = -7, seq[2600] = -7, seq[900] = 12, seq[2999] = 12;
+
+  pair<int*, int*> res =
+    sml::algorithm::min_max(&seq[0], &seq[0] + 3000, sml::op::greater());
+  ASSERT_EQ(&seq[900],  res.first);
+  ASSERT_EQ(&seq[1700], res.second);
+
+  res = sml::algorithm::min_max(&seq[0], &seq[0] + 3000, std::greater<int>());
+  ASSERT_EQ(&seq[900],  res.first);
+  ASSERT_EQ(&seq[1700], res.second);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
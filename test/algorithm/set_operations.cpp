@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/set_operations.hpp"
+
+namespace {
+
+using std::pair;
+using std::vector;
+
+struct reverse_comparator {
+  int operator()(int a, int b) const {
+    return b < a ? -1 : (a < b ? 1 : 0);
+  }
+};
+
+// Every step-th number of [offset, n).
+template<class T>
+vector<T> make_set(int n, int step, int offset) {
+  vector<T> seq;
+  for (int i = offset; i < n; i += step) seq.push_back(T(i));
+  return seq;
+}
+
+template<class T>
+void compare_with_std(vector<T> const& a, vector<T> const& b) {
+  const T* const fa = a.empty() ? 0 : &a[0];
+  const T* const la = fa + a.size();
+  const T* const fb = b.empty() ? 0 : &b[0];
+  const T* const lb = fb + b.size();
+
+  vector<T> expected, res;
+
+  std::set_intersection(fa, la, fb, lb, std::back_inserter(expected));
+  sml::algorithm::set_intersection(fa, la, fb, lb, std::back_inserter(res));
+  ASSERT_EQ(expected, res);
+  ASSERT_EQ(expected.size(), sml::algorithm::set_intersection_size(fa, la, fb, lb));
+
+  expected.clear(), res.clear();
+  std::set_union(fa, la, fb, lb, std::back_inserter(expected));
+  sml::algorithm::set_union(fa, la, fb, lb, std::back_inserter(res));
+  ASSERT_EQ(expected, res);
+  ASSERT_EQ(expected.size(), sml::algorithm::set_union_size(fa, la, fb, lb));
+
+  expected.clear(), res.clear();
+  std::set_difference(fa, la, fb, lb, std::back_inserter(expected));
+  sml::algorithm::set_difference(fa, la, fb, lb, std::back_inserter(res));
+  ASSERT_EQ(expected, res);
+  ASSERT_EQ(expected.size(), sml::algorithm::set_difference_size(fa, la, fb, lb));
+
+  expected.clear(), res.clear();
+  std::set_difference(fb, lb, fa, la, std::back_inserter(expected));
+  sml::algorithm::set_difference(b.begin(), b.end(), a.begin(), a.end(),
+                                 std::back_inserter(res));
+  ASSERT_EQ(expected, res);
+}
+
+template<class T>
+void check_all() {
+  const int steps[6] = {1, 2, 3, 5, 7, 64};
+
+  for (int n = 0; n < 300; n += 23) {
+    for (int i = 0; i < 6; ++i) {
+      for (int j = 0; j < 6; ++j) {
+        compare_with_std(
+          make_set<T>(n, steps[i], i), make_set<T>(n + 5 * j, steps[j], j)
+        );
+      }
+    }
+  }
+  compare_with_std(make_set<T>(5000, 1, 0), make_set<T>(5000, 400, 7));
+  compare_with_std(make_set<T>(5000, 700, 3), make_set<T>(5000, 1, 0));
+}
+
+TEST(SetOperations, Int) {
+  check_all<int>();
+}
+
+TEST(SetOperations, Unsigned) {
+  check_all<unsigned>();
+}
+
+TEST(SetOperations, Long) {
+  check_all<long>();
+}
+
+TEST(SetOperations, Negative) {
+  int a[6] = {-9, -4, -1, 0, 3, 8};
+  int b[7] = {-8, -4, -2, 0, 2, 3, 9};
+
+  vector<int> res;
+  sml::algorithm::set_intersection(a, a+6, b, b+7, std::back_inserter(res));
+
+  ASSERT_EQ(3u, res.size());
+  EXPECT_EQ(-4, res[0]);
+  EXPECT_EQ(0,  res[1]);
+  EXPECT_EQ(3,  res[2]);
+}
+
+TEST(SetOperations, WithComparator) {
+  int a[5] = {9, 7, 5, 3, 1};
+  int b[4] = {8, 7, 3, 0};
+
+  vector<int> res;
+  sml::algorithm::set_union(a, a+5, b, b+4, std::back_inserter(res),
+                            reverse_comparator());
+
+  int expected[7] = {9, 8, 7, 5, 3, 1, 0};
+  ASSERT_EQ(vector<int>(expected, expected+7), res);
+
+  EXPECT_EQ(2u, sml::algorithm::set_intersection_size(
+    a, a+5, b, b+4, reverse_comparator()
+  ));
+}
+
+TEST(SetOperations, KWayIntersection) {
+  const vector<int> a = make_set<int>(10000, 2, 0);
+  const vector<int> b = make_set<int>(10000, 3, 0);
+  const vector<int> c = make_set<int>(10000, 5, 0);
+  const vector<int> d = make_set<int>(10000, 1, 0);
+
+  typedef vector<int>::const_iterator iterator;
+  vector< pair<iterator, iterator> > ranges;
+  ranges.push_back(std::make_pair(a.begin(), a.end()));
+  ranges.push_back(std::make_pair(b.begin(), b.end()));
+  ranges.push_back(std::make_pair(c.begin(), c.end()));
+  ranges.push_back(std::make_pair(d.begin(), d.end()));
+
+  vector<int> res;
+  sml::algorithm::kway_set_intersection(
+    ranges.begin(), ranges.end(), std::back_inserter(res)
+  );
+
+  ASSERT_EQ(make_set<int>(10000, 30, 0), res);
+
+  const vector<int> empty;
+  ranges.push_back(std::make_pair(empty.begin(), empty.end()));
+  res.clear();
+  sml::algorithm::kway_set_intersection(
+    ranges.begin(), ranges.end(), std::back_inserter(res)
+  );
+  EXPECT_TRUE(res.empty());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
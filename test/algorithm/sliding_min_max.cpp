@@ -0,0 +1,223 @@
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <gtest/gtest.h>
+#include "sml/algorithm/sliding_min_max.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+using std::vector;
+using std::string;
+
+using sml::algorithm::sliding_min_max;
+using sml::algorithm::timed_sliding_min_max;
+
+TEST(SlidingMinMax, Empty) {
+  sliding_min_max<int> window(3);
+
+  ASSERT_TRUE(window.empty());
+  ASSERT_EQ(0u, window.size());
+  ASSERT_EQ(3u, window.window());
+}
+
+TEST(SlidingMinMax, FillsUpToWindow) {
+  sliding_min_max<int> window(3);
+
+  window.push(5);
+  ASSERT_EQ(1u, window.size());
+  ASSERT_EQ(5, window.min());
+  ASSERT_EQ(5, window.max());
+
+  window.push(2);
+  window.push(7);
+  ASSERT_EQ(3u, window.size());
+  ASSERT_EQ(2, window.min());
+  ASSERT_EQ(7, window.max());
+
+  window.push(4);
+  ASSERT_EQ(3u, window.size());
+  ASSERT_EQ(2, window.min());
+  ASSERT_EQ(7, window.max());
+
+  window.push(6);
+  ASSERT_EQ(4, window.min());
+  ASSERT_EQ(7, window.max());
+
+  window.push(5);
+  ASSERT_EQ(4, window.min());
+  ASSERT_EQ(6, window.max());
+}
+
+TEST(SlidingMinMax, WindowOfOne) {
+  sliding_min_max<int> window(1);
+  const int seq[5] = {3, 1, 4, 1, 5};
+
+  for (int i = 0; i < 5; ++i) {
+    window.push(seq[i]);
+    ASSERT_EQ(seq[i], window.min());
+    ASSERT_EQ(seq[i], window.max());
+  }
+}
+
+TEST(SlidingMinMax, WindowOfZeroStaysEmpty) {
+  sliding_min_max<int> window(0);
+  window.push(1);
+
+  ASSERT_TRUE(window.empty());
+}
+
+TEST(SlidingMinMax, Clear) {
+  sliding_min_max<int> window(2);
+  window.push(1);
+  window.push(9);
+  window.clear();
+
+  ASSERT_TRUE(window.empty());
+
+  window.push(4);
+  ASSERT_EQ(4, window.min());
+  ASSERT_EQ(4, window.max());
+}
+
+TEST(SlidingMinMax, CustomLesser) {
+  sliding_min_max<int, std::greater<int> > window(2, std::greater<int>());
+  window.push(1);
+  window.push(3);
+
+  ASSERT_EQ(3, window.min());
+  ASSERT_EQ(1, window.max());
+}
+
+TEST(SlidingMinMax, Strings) {
+  sliding_min_max<string> window(2);
+  window.push("pear");
+  window.push("apple");
+  window.push("plum");
+
+  ASSERT_EQ("apple", window.min());
+  ASSERT_EQ("plum", window.max());
+}
+
+TEST(SlidingMinMax, RandomAgainstScan) {
+  sml::random::xoshiro256ss rand(38);
+
+  const int sizes[4] = {1, 2, 7, 64};
+  for (int s = 0; s < 4; ++s) {
+    const std::size_t n = sizes[s];
+    sliding_min_max<int> window(n);
+    vector<int> seq;
+
+    for (int i = 0; i < 1000; ++i) {
+      seq.push_back(int(sml::random::bounded_rand(rand, 51)));
+      window.push(seq.back());
+
+      const std::size_t first = seq.size() > n ? seq.size() - n : 0;
+      ASSERT_EQ(seq.size() - first, window.size());
+      ASSERT_EQ(*std::min_element(seq.begin() + first, seq.end()), window.min());
+      ASSERT_EQ(*std::max_element(seq.begin() + first, seq.end()), window.max());
+    }
+  }
+}
+
+TEST(TimedSlidingMinMax, Empty) {
+  timed_sliding_min_max<int> window(10.0);
+
+  ASSERT_TRUE(window.empty());
+  ASSERT_EQ(10.0, window.span());
+}
+
+TEST(TimedSlidingMinMax, ExpiresByTime) {
+  timed_sliding_min_max<int, int> window(10);
+
+  window.push(0, 8);
+  window.push(3, 2);
+  window.push(6, 5);
+  ASSERT_EQ(2, window.min());
+  ASSERT_EQ(8, window.max());
+
+  window.push(10, 4);
+  ASSERT_EQ(2, window.min());
+  ASSERT_EQ(8, window.max());
+
+  window.push(11, 6);
+  ASSERT_EQ(2, window.min());
+  ASSERT_EQ(6, window.max());
+
+  window.advance(14);
+  ASSERT_EQ(4, window.min());
+  ASSERT_EQ(6, window.max());
+  ASSERT_EQ(14, window.now());
+}
+
+TEST(TimedSlidingMinMax, AdvanceEmptiesWindow) {
+  timed_sliding_min_max<int, int> window(5);
+  window.push(0, 1);
+  window.push(1, 2);
+  window.advance(7);
+
+  ASSERT_TRUE(window.empty());
+
+  window.push(8, 3);
+  ASSERT_EQ(3, window.min());
+  ASSERT_EQ(3, window.max());
+}
+
+TEST(TimedSlidingMinMax, UnsignedTimeBeforeSpan) {
+  timed_sliding_min_max<int, unsigned> window(100);
+
+  window.push(5, 42);
+  ASSERT_FALSE(window.empty());
+  ASSERT_EQ(42, window.min());
+  ASSERT_EQ(42, window.max());
+
+  window.push(50, 7);
+  window.advance(105);
+  ASSERT_EQ(7,  window.min());
+  ASSERT_EQ(42, window.max());
+
+  window.advance(106);
+  ASSERT_EQ(7, window.max());
+
+  window.advance(151);
+  ASSERT_TRUE(window.empty());
+}
+
+TEST(TimedSlidingMinMax, CustomLesser) {
+  timed_sliding_min_max<int, int, std::greater<int> > window(5);
+  window.push(0, 1);
+  window.push(1, 3);
+
+  ASSERT_EQ(3, window.min());
+  ASSERT_EQ(1, window.max());
+}
+
+TEST(TimedSlidingMinMax, RandomAgainstScan) {
+  sml::random::xoshiro256ss rand(83);
+
+  timed_sliding_min_max<int, int> window(20);
+  vector<int> times;
+  vector<int> seq;
+  int now = 0;
+
+  for (int i = 0; i < 1000; ++i) {
+    now += int(sml::random::bounded_rand(rand, 4));
+    times.push_back(now);
+    seq.push_back(int(sml::random::bounded_rand(rand, 51)));
+    window.push(now, seq.back());
+
+    const std::size_t first =
+      std::lower_bound(times.begin(), times.end(), now - 20) - times.begin();
+    ASSERT_EQ(*std::min_element(seq.begin() + first, seq.end()), window.min());
+    ASSERT_EQ(*std::max_element(seq.begin() + first, seq.end()), window.max());
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/static_search_tree.hpp"
+
+namespace {
+
+using std::list;
+using std::vector;
+
+template<class T>
+void compare_with_std(vector<T> const& seq, vector<T> const& keys) {
+  typedef typename sml::algorithm::static_search_tree<T>::size_type size_type;
+
+  const sml::algorithm::static_search_tree<T> tree(seq.begin(), seq.end());
+  ASSERT_EQ(seq.size(), tree.size());
+
+  for (typename vector<T>::size_type i = 0; i < keys.size(); ++i) {
+    const T v = keys[i];
+    const size_type lb =
+      std::lower_bound(seq.begin(), seq.end(), v) - seq.begin();
+    const size_type ub =
+      std::upper_bound(seq.begin(), seq.end(), v) - seq.begin();
+
+    ASSERT_EQ(lb, tree.lower_bound(v)) << "n " << seq.size() << " v " << v;
+    ASSERT_EQ(ub, tree.upper_bound(v));
+    ASSERT_EQ(lb, tree.equal_range(v).first);
+    ASSERT_EQ(ub, tree.equal_range(v).second);
+    ASSERT_EQ(lb == ub ? seq.size() : lb, tree.find(v));
+  }
+}
+
+template<class T>
+void check_sizes(const T low, const int max_n) {
+  for (int n = 0; n <= max_n; n += n < 40 ? 1 : 37) {
+    vector<T> seq, keys;
+    for (int i = 0; i < n; ++i) seq.push_back(low + T(2 * (i / 3)));
+    for (int i = -1; i < 2 * (n / 3) + 3; ++i) keys.push_back(low + T(i));
+    compare_with_std(seq, keys);
+  }
+}
+
+TEST(StaticSearchTree, Empty) {
+  sml::algorithm::static_search_tree<int> tree;
+
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(0u, tree.lower_bound(5));
+  EXPECT_EQ(0u, tree.upper_bound(5));
+  EXPECT_EQ(0u, tree.find(5));
+}
+
+TEST(StaticSearchTree, Int32) {
+  check_sizes<sml::ext::int32_t>(-1000, 2000);
+}
+
+TEST(StaticSearchTree, UInt32) {
+  check_sizes<sml::ext::uint32_t>(1, 2000);
+  check_sizes<sml::ext::uint32_t>(0x7ffffff0u, 200);
+}
+
+TEST(StaticSearchTree, Int64) {
+  check_sizes<sml::ext::int64_t>(-1000, 2000);
+}
+
+TEST(StaticSearchTree, UInt64) {
+  check_sizes<sml::ext::uint64_t>(1, 2000);
+  check_sizes<sml::ext::uint64_t>(0x7ffffffffffffff0ull, 200);
+}
+
+TEST(StaticSearchTree, Extremes) {
+  typedef sml::ext::uint32_t T;
+  const T MAX = std::numeric_limits<T>::max();
+
+  vector<T> seq, keys;
+  seq.push_back(0), seq.push_back(0), seq.push_back(7),
+  seq.push_back(MAX), seq.push_back(MAX);
+  keys.push_back(0), keys.push_back(1), keys.push_back(MAX - 1),
+  keys.push_back(MAX);
+
+  compare_with_std(seq, keys);
+}
+
+TEST(StaticSearchTree, Copy) {
+  list<int> seq;
+  for (int i = 0; i < 100; ++i) seq.push_back(i * 5);
+
+  sml::algorithm::static_search_tree<int> tree(seq.begin(), seq.end());
+  sml::algorithm::static_search_tree<int> copy(tree), assigned;
+  assigned = tree;
+
+  EXPECT_EQ(20u, copy.find(100));
+  EXPECT_EQ(20u, assigned.find(100));
+  EXPECT_EQ(100u, copy.find(101));
+  EXPECT_EQ(495, assigned.at(99));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include <cmath>
+#include <limits>
+#include <list>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/algorithm/statistics.hpp"
+
+namespace {
+
+using std::vector;
+
+struct naive {
+  explicit naive(vector<double> const& seq) :
+    count(0), min(1e300), max(-1e300), sum(0.0), variance(0.0) {
+    for (vector<double>::size_type i = 0; i < seq.size(); ++i) {
+      if (seq[i] != seq[i]) continue;
+      ++count, sum += seq[i];
+      min = std::min(min, seq[i]), max = std::max(max, seq[i]);
+    }
+    const double mean = sum / count;
+    for (vector<double>::size_type i = 0; i < seq.size(); ++i) {
+      if (seq[i] != seq[i]) continue;
+      variance += (seq[i] - mean) * (seq[i] - mean);
+    }
+    variance /= count;
+  }
+
+  std::size_t count;
+  double min, max, sum, variance;
+};
+
+template<unsigned Stats>
+void expect_near(sml::algorithm::statistics<Stats> const& stats, naive const& ref) {
+  EXPECT_EQ(ref.count, stats.count());
+  EXPECT_EQ(ref.min,   stats.min());
+  EXPECT_EQ(ref.max,   stats.max());
+  EXPECT_NEAR(ref.sum,            stats.sum(),      1e-9 * std::fabs(ref.sum) + 1e-9);
+  EXPECT_NEAR(ref.sum / ref.count, stats.mean(),    1e-9);
+  EXPECT_NEAR(ref.variance,       stats.variance(), 1e-9 * ref.variance + 1e-12);
+}
+
+vector<double> make_column(int n) {
+  vector<double> seq;
+  for (int i = 0; i < n; ++i) seq.push_back(std::sin(i * 0.37) * 100 + i % 13);
+  return seq;
+}
+
+TEST(Statistics, Empty) {
+  vector<double> seq;
+  const sml::algorithm::statistics<> stats =
+    sml::algorithm::summarize(seq.begin(), seq.end());
+
+  EXPECT_EQ(0u, stats.count());
+  EXPECT_EQ(0.0, stats.sum());
+  EXPECT_EQ(0.0, stats.variance());
+  EXPECT_EQ(0.0, stats.sample_variance());
+}
+
+TEST(Statistics, SmallList) {
+  std::list<int> seq;
+  seq.push_back(2), seq.push_back(4), seq.push_back(4), seq.push_back(4),
+  seq.push_back(5), seq.push_back(5), seq.push_back(7), seq.push_back(9);
+
+  const sml::algorithm::statistics<> stats =
+    sml::algorithm::summarize(seq.begin(), seq.end());
+
+  EXPECT_EQ(8u,   stats.count());
+  EXPECT_EQ(2.0,  stats.min());
+  EXPECT_EQ(9.0,  stats.max());
+  EXPECT_EQ(40.0, stats.sum());
+  EXPECT_EQ(5.0,  stats.mean());
+  EXPECT_EQ(4.0,  stats.variance());
+  EXPECT_NEAR(32.0 / 7, stats.sample_variance(), 1e-12);
+}
+
+TEST(Statistics, ArraysMatchElementwise) {
+  const int sizes[5] = {1, 1023, 1024, 3000, 10001};
+  for (int s = 0; s < 5; ++s) {
+    const vector<double> seq = make_column(sizes[s]);
+
+    expect_near(
+      sml::algorithm::summarize(&seq[0], &seq[0] + seq.size()), naive(seq)
+    );
+    expect_near(
+      sml::algorithm::summarize(seq.begin(), seq.end()), naive(seq)
+    );
+  }
+}
+
+TEST(Statistics, SkipsNaN) {
+  vector<double> seq = make_column(5000);
+  seq[0] = seq[1500] = seq[4999] = std::numeric_limits<double>::quiet_NaN();
+  for (int i = 2048; i < 3072; ++i) {
+    seq[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  expect_near(sml::algorithm::summarize(&seq[0], &seq[0] + 5000), naive(seq));
+}
+
+TEST(Statistics, Merge) {
+  const vector<double> seq = make_column(7000);
+
+  sml::algorithm::statistics<> left, right, empty;
+  left.add(&seq[0], &seq[0] + 2500);
+  right.add(seq.begin() + 2500, seq.end());
+  left.merge(right).merge(empty);
+
+  expect_near(left, naive(seq));
+
+  empty.merge(left);
+  expect_near(empty, naive(seq));
+}
+
+TEST(Statistics, CompensatedSum) {
+  vector<double> seq(1, 1e16);
+  for (int i = 0; i < 4000; ++i) seq.push_back(1.0);
+
+  EXPECT_EQ(1e16 + 4000, sml::algorithm::summarize(&seq[0], &seq[0] + 4001).sum());
+  EXPECT_EQ(1e16 + 4000,
+            sml::algorithm::summarize(seq.begin(), seq.end()).sum());
+}
+
+TEST(Statistics, StableVariance) {
+  vector<double> seq;
+  for (int i = 0; i < 5000; ++i) seq.push_back(1e9 + (i % 2 ? 1.0 : -1.0));
+
+  EXPECT_NEAR(1.0, sml::algorithm::summarize(&seq[0], &seq[0] + 5000).variance(), 1e-6);
+}
+
+TEST(Statistics, SelectedOnly) {
+  int seq[4] = {3, 1, 4, 1};
+  const sml::algorithm::statistics<
+    sml::algorithm::STAT_MIN | sml::algorithm::STAT_SUM
+  > stats = sml::algorithm::summarize<
+    sml::algorithm::STAT_MIN | sml::algorithm::STAT_SUM
+  >(seq, seq+4);
+
+  EXPECT_EQ(4u,  stats.count());
+  EXPECT_EQ(1.0, stats.min());
+  EXPECT_EQ(9.0, stats.sum());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
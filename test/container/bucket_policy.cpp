@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/container/bucket_policy.hpp"
+
+namespace {
+
+using sml::container::modulo_bucket_policy;
+using sml::container::power_of_two_bucket_policy;
+using sml::container::fastrange_bucket_policy;
+
+// every bucket gets some of `n` consecutive integer hashes
+template<class Policy>
+bool covers(std::size_t const bucket_count, std::size_t const n) {
+  std::vector<std::size_t> hits(bucket_count);
+  for (std::size_t h = 0; h < n; ++h) {
+    std::size_t const idx = Policy::index(h, bucket_count);
+    if (idx >= bucket_count) return false;
+    ++hits[idx];
+  }
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    if (hits[i] == 0) return false;
+  }
+  return true;
+}
+
+TEST(BucketPolicy, Modulo) {
+  ASSERT_EQ(17u, modulo_bucket_policy::bucket_count(17));
+  ASSERT_EQ(5u,  modulo_bucket_policy::index(22, 17));
+  ASSERT_TRUE(covers<modulo_bucket_policy>(17, 17));
+}
+
+TEST(BucketPolicy, PowerOfTwoCounts) {
+  ASSERT_EQ(1u,    power_of_two_bucket_policy::bucket_count(0));
+  ASSERT_EQ(1u,    power_of_two_bucket_policy::bucket_count(1));
+  ASSERT_EQ(2u,    power_of_two_bucket_policy::bucket_count(2));
+  ASSERT_EQ(32u,   power_of_two_bucket_policy::bucket_count(17));
+  ASSERT_EQ(1024u, power_of_two_bucket_policy::bucket_count(1024));
+  ASSERT_EQ(2048u, power_of_two_bucket_policy::bucket_count(1025));
+}
+
+TEST(BucketPolicy, PowerOfTwoSpreadsWeakHashes) {
+  ASSERT_TRUE(covers<power_of_two_bucket_policy>(1, 1));
+  ASSERT_TRUE(covers<power_of_two_bucket_policy>(64, 64 * 8));
+
+  // multiples of the bucket count would all mask to bucket 0
+  std::vector<std::size_t> hits(64);
+  for (std::size_t h = 0; h < 64 * 64 * 8; h += 64) {
+    ++hits[power_of_two_bucket_policy::index(h, 64)];
+  }
+  for (std::size_t i = 0; i < hits.size(); ++i) ASSERT_LT(0u, hits[i]);
+}
+
+TEST(BucketPolicy, PowerOfTwoSpreadsHighBitHashes) {
+  // hashes differing only in their top 16 bits
+  std::size_t const shift = sizeof(std::size_t) * 8 - 16;
+
+  std::vector<std::size_t> hits(1024);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    ++hits[power_of_two_bucket_policy::index(i << shift, 1024)];
+  }
+
+  std::size_t used = 0, longest = 0;
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    used    += hits[i] != 0;
+    longest  = hits[i] > longest ? hits[i] : longest;
+  }
+  ASSERT_LE(550u, used);
+  ASSERT_GE(8u,   longest);
+}
+
+TEST(BucketPolicy, Fastrange) {
+  std::size_t const top = ~std::size_t();
+
+  ASSERT_EQ(17u, fastrange_bucket_policy::bucket_count(17));
+  ASSERT_EQ(0u,  fastrange_bucket_policy::index(0,   17));
+  ASSERT_EQ(16u, fastrange_bucket_policy::index(top, 17));
+  ASSERT_EQ(8u,  fastrange_bucket_policy::index(top / 2 + 1, 17));
+
+  // hashes spread over the word land in every bucket
+  std::vector<std::size_t> hits(17);
+  std::size_t const step = top / 170;
+  for (std::size_t i = 0; i < 170; ++i) {
+    std::size_t const idx = fastrange_bucket_policy::index(i * step, 17);
+    ASSERT_GT(17u, idx);
+    ++hits[idx];
+  }
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    ASSERT_LE(9u,  hits[i]);
+    ASSERT_GE(11u, hits[i]);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -944,6 +944,625 @@ TEST_F(ChainHashMapFixiture, MaxLoadFactor) {
   }
 }
 
+// -----------------------
+// ---- Cached Hashes -----
+// -----------------------
+
+struct counting_hash {
+  std::size_t operator()(int const x) const {
+    ++counting_hash::calls;
+    return static_cast<std::size_t>(x);
+  }
+
+  static int calls;
+};
+
+int counting_hash::calls = 0;
+
+struct constant_hash {
+  std::size_t operator()(int) const { return 7; }
+};
+
+struct counting_equal {
+  bool operator()(int const a, int const b) const {
+    ++counting_equal::calls;
+    return a == b;
+  }
+
+  static int calls;
+};
+
+int counting_equal::calls = 0;
+
+TEST(ChainHashMap, GrowthDoesNotCallHasher) {
+  typedef sml::container::chain_hash_map<int, int, counting_hash> int_map;
+
+  int_map m;
+  counting_hash::calls = 0;
+  for (int i = 0; i < 1000; ++i) m[i] = i;
+
+  ASSERT_EQ(1000, counting_hash::calls);
+
+  int_map const copy(m);
+  ASSERT_EQ(1000, counting_hash::calls);
+
+  for (int i = 0; i < 1000; ++i) ASSERT_EQ(i, copy.at(i));
+}
+
+TEST(ChainHashMap, LookupSkipsOtherHashes) {
+  typedef
+    sml::container::chain_hash_map<int, int, counting_hash, counting_equal>
+    int_map;
+
+  // 0, 10, 20, ... share bucket 0 of 10 buckets but not their hashes
+  int_map m(10);
+  m.max_load_factor(100.0f);
+  for (int i = 0; i < 50; ++i) m[i * 10] = i;
+  ASSERT_EQ(10u, m.bucket_count());
+
+  counting_equal::calls = 0;
+  for (int i = 0; i < 50; ++i) ASSERT_EQ(i, m.find(i * 10)->second);
+  ASSERT_EQ(50, counting_equal::calls);
+
+  counting_equal::calls = 0;
+  ASSERT_TRUE(m.find(1000) == m.end());
+  ASSERT_EQ(0, counting_equal::calls);
+}
+
+TEST(ChainHashMap, CollidingHashes) {
+  typedef sml::container::chain_hash_map<int, int, constant_hash> int_map;
+
+  int_map m;
+  for (int i = 0; i < 100; ++i) m[i] = i * 2;
+  for (int i = 0; i < 100; i += 2) ASSERT_EQ(1u, m.erase(i));
+
+  ASSERT_EQ(50u, m.size());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(static_cast<size_type>(i % 2), m.count(i));
+  }
+}
+
+// ------------------------
+// ---- Bucket Policies ----
+// ------------------------
+
+template<class Policy>
+void bucket_policy_test() {
+  typedef
+    sml::container::chain_hash_map<
+      int, int, hash<int>, std::equal_to<int>, allocator< pair<int const, int> >,
+      Policy
+    >
+    int_map;
+
+  int_map m;
+  for (int i = 0; i < 1000; ++i) m[i * 3] = i;
+
+  ASSERT_EQ(1000u, m.size());
+  ASSERT_GE(m.max_load_factor(), m.load_factor());
+  for (int i = 0; i < 3000; ++i) {
+    ASSERT_EQ(static_cast<size_type>(i % 3 == 0), m.count(i));
+  }
+
+  for (int i = 0; i < 1000; i += 2) ASSERT_EQ(1u, m.erase(i * 3));
+  ASSERT_EQ(500u, m.size());
+
+  for (size_type n = 0; n < m.bucket_count(); ++n) {
+    for (
+      typename int_map::local_iterator iter = m.begin(n);
+      iter != m.end(n);
+      ++iter
+    ) {
+      ASSERT_EQ(n, m.bucket(iter->first));
+    }
+  }
+
+  int_map const copy(m);
+  ASSERT_TRUE(copy == m);
+}
+
+TEST(ChainHashMap, ModuloBuckets) {
+  bucket_policy_test<sml::container::modulo_bucket_policy>();
+}
+
+TEST(ChainHashMap, PowerOfTwoBuckets) {
+  bucket_policy_test<sml::container::power_of_two_bucket_policy>();
+
+  typedef
+    sml::container::chain_hash_map<
+      int, int, hash<int>, std::equal_to<int>, allocator< pair<int const, int> >,
+      sml::container::power_of_two_bucket_policy
+    >
+    int_map;
+
+  int_map m;
+  ASSERT_EQ(32u, m.bucket_count());
+
+  for (int i = 0; i < 100; ++i) m[i] = i;
+  size_type const count = m.bucket_count();
+  ASSERT_EQ(0u, count & (count - 1));
+
+  m.rehash(1000);
+  ASSERT_EQ(1024u, m.bucket_count());
+}
+
+TEST(ChainHashMap, FastrangeBuckets) {
+  bucket_policy_test<sml::container::fastrange_bucket_policy>();
+}
+
+// ---------------------------
+// ---- Incremental Rehash ----
+// ---------------------------
+
+typedef sml::container::chain_hash_map<int, int, hash<int> > int_map_type;
+
+size_type moved_size(int_map_type const& m) {
+  size_type size = 0;
+  for (size_type n = 0; n < m.bucket_count(); ++n) size += m.bucket_size(n);
+  return size;
+}
+
+TEST(ChainHashMap, IncrementalRehash) {
+  int_map_type m;
+  m.rehash_step(1);
+  ASSERT_EQ(1u, m.rehash_step());
+
+  bool partial = false;
+  for (int i = 0; i < 2000; ++i) {
+    m[i] = i * 2;
+
+    // a growth leaves elements behind for later calls to move
+    if (moved_size(m) < m.size()) partial = true;
+
+    if (i % 97 == 0) {
+      std::vector<int> seen(i + 1);
+      for (
+        int_map_type::const_iterator iter = m.begin();
+        iter != m.end();
+        ++iter
+      ) {
+        ++seen[iter->first];
+      }
+      ASSERT_EQ(std::vector<int>(i + 1, 1), seen);
+    }
+  }
+  ASSERT_TRUE(partial);
+
+  for (int i = 0; i < 2000; ++i) ASSERT_EQ(i * 2, m.at(i));
+  ASSERT_TRUE(m.find(2000) == m.end());
+
+  m.complete_rehash();
+  ASSERT_EQ(m.size(), moved_size(m));
+}
+
+TEST(ChainHashMap, IncrementalRehashEraseAndCopy) {
+  int_map_type m;
+  m.rehash_step(2);
+
+  for (int i = 0; i < 1000; ++i) m[i] = i;
+  for (int i = 0; i < 1000; i += 3) ASSERT_EQ(1u, m.erase(i));
+
+  int_map_type const copy(m);
+  ASSERT_EQ(2u, copy.rehash_step());
+  ASSERT_TRUE(copy == m);
+
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(static_cast<size_type>(i % 3 != 0), m.count(i));
+    ASSERT_EQ(static_cast<size_type>(i % 3 != 0), copy.count(i));
+  }
+
+  // erasing by iterator, across both bucket arrays
+  int_map_type::iterator iter = m.begin();
+  while (iter != m.end()) {
+    iter = iter->first % 2 ? m.erase(iter) : sml::iterator::next(iter);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(static_cast<size_type>(i % 3 != 0 && i % 2 == 0), m.count(i));
+  }
+}
+
+TEST(ChainHashMap, IncrementalRehashClearAndSwap) {
+  int_map_type m;
+  int_map_type n;
+  m.rehash_step(1);
+
+  for (int i = 0; i < 500; ++i) m[i] = i;
+  m.swap(n);
+  ASSERT_TRUE(m.empty());
+  ASSERT_EQ(500u, n.size());
+  for (int i = 0; i < 500; ++i) ASSERT_EQ(i, n.at(i));
+
+  n.clear();
+  ASSERT_TRUE(n.empty());
+  ASSERT_TRUE(n.begin() == n.end());
+
+  for (int i = 0; i < 500; ++i) n[i] = i;
+  n.rehash_step(0);
+  ASSERT_EQ(n.size(), moved_size(n));
+}
+
+// A piece of a buffer, looked up in a string map without copying it.
+struct slice {
+  slice(char const* const data, std::size_t const size) :
+    data(data),
+    size(size) {
+  }
+
+  char const* data;
+  std::size_t size;
+};
+
+int string_hashes = 0;
+
+struct slice_hash {
+  typedef void is_transparent;
+
+  std::size_t operator()(slice const& s) const {
+    std::size_t h = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < s.size; ++i) {
+      h = (h ^ static_cast<unsigned char>(s.data[i])) * 1099511628211ULL;
+    }
+    return h;
+  }
+
+  std::size_t operator()(string const& s) const {
+    ++string_hashes;
+    return (*this)(slice(s.data(), s.size()));
+  }
+};
+
+struct slice_equal {
+  typedef void is_transparent;
+
+  bool operator()(string const& a, slice const& b) const {
+    return a.size() == b.size && a.compare(0, a.size(), b.data, b.size) == 0;
+  }
+
+  bool operator()(string const& a, string const& b) const {
+    return a == b;
+  }
+};
+
+typedef
+  sml::container::chain_hash_map< string, int, slice_hash, slice_equal >
+  slice_map_type;
+
+TEST(ChainHashMap, TransparentLookup) {
+  slice_map_type m;
+  m["alpha"] = 1;
+  m["beta"]  = 2;
+  m["gamma"] = 3;
+
+  char const buffer[] = "xxbetaxx";
+  slice const beta(buffer + 2, 4);
+  slice const bet(buffer + 2, 3);
+
+  string_hashes = 0;
+  ASSERT_EQ(2, m.find(beta)->second);
+  ASSERT_TRUE(m.find(bet) == m.end());
+  ASSERT_EQ(1u, m.count(beta));
+  ASSERT_EQ(0u, m.count(bet));
+  ASSERT_EQ(2, m.at(beta));
+  ASSERT_THROW(m.at(bet), out_of_range);
+
+  slice_map_type const& c = m;
+  ASSERT_EQ(2, c.find(beta)->second);
+  ASSERT_EQ(2, c.at(beta));
+  pair<
+    slice_map_type::const_iterator, slice_map_type::const_iterator
+  > const range = c.equal_range(beta);
+  ASSERT_EQ(1, std::distance(range.first, range.second));
+  ASSERT_TRUE(m.equal_range(bet).first == m.end());
+
+  ASSERT_EQ(1u, m.erase(beta));
+  ASSERT_EQ(0u, m.erase(beta));
+  ASSERT_EQ(0, string_hashes);
+
+  ASSERT_EQ(2u, m.size());
+  ASSERT_EQ(1, m.find(string("alpha"))->second);
+  ASSERT_EQ(1, string_hashes);
+}
+
+TEST(ChainHashMap, TransparentEraseByIterator) {
+  slice_map_type m;
+  m["alpha"] = 1;
+  m["beta"]  = 2;
+
+  slice_map_type::iterator const pos = m.find(slice("beta", 4));
+  m.erase(pos);
+  ASSERT_EQ(1u, m.size());
+  ASSERT_EQ(0u, m.count(slice("beta", 4)));
+}
+
+TEST(ChainHashMap, TransparentLookupTrait) {
+  ASSERT_TRUE((
+    sml::container::is_transparent_lookup<slice_hash, slice_equal>::value
+  ));
+  ASSERT_FALSE((
+    sml::container::is_transparent_lookup<
+      slice_hash, std::equal_to<string>
+    >::value
+  ));
+  ASSERT_FALSE((
+    sml::container::is_transparent_lookup<hasher, key_equal>::value
+  ));
+
+  // without both, a const char* is still converted to the key
+  map_type m;
+  m["abc"] = 1;
+  ASSERT_EQ(1u, m.count("abc"));
+  ASSERT_EQ(1u, m.erase("abc"));
+}
+
+// A mapped value that counts how it was built.
+struct tracked {
+  tracked() : value(0) { ++tracked::constructions; }
+
+  tracked(int const v) : value(v) { ++tracked::constructions; }
+
+  tracked(tracked const& r) : value(r.value) { ++tracked::copies; }
+
+#if __cplusplus >= 201103L
+  tracked(tracked&& r) : value(r.value) { ++tracked::moves; }
+#endif
+
+  tracked& operator=(tracked const& r) {
+    this->value = r.value;
+    ++tracked::assignments;
+    return *this;
+  }
+
+  static void reset() {
+    tracked::constructions = 0;
+    tracked::copies        = 0;
+    tracked::moves         = 0;
+    tracked::assignments   = 0;
+  }
+
+  int value;
+
+  static int constructions;
+  static int copies;
+  static int moves;
+  static int assignments;
+};
+
+int tracked::constructions = 0;
+int tracked::copies        = 0;
+int tracked::moves         = 0;
+int tracked::assignments   = 0;
+
+typedef
+  sml::container::chain_hash_map< int, tracked, hash<int> >
+  tracked_map_type;
+
+TEST(ChainHashMap, InsertCopiesOnce) {
+  tracked_map_type m;
+  tracked_map_type::value_type const v(1, tracked(10));
+
+  tracked::reset();
+  ASSERT_TRUE(m.insert(v).second);
+  ASSERT_EQ(1, tracked::copies);
+  ASSERT_FALSE(m.insert(v).second);
+  ASSERT_EQ(1, tracked::copies);
+  ASSERT_EQ(10, m.at(1).value);
+
+  tracked::reset();
+  m[2];
+  ASSERT_EQ(1, tracked::constructions);
+  ASSERT_EQ(1u, m.count(2));
+  ASSERT_EQ(0, m[2].value);
+  ASSERT_EQ(1, tracked::constructions);
+}
+
+TEST(ChainHashMap, TryEmplace) {
+  tracked_map_type m;
+
+  tracked::reset();
+  pair<tracked_map_type::iterator, bool> r = m.try_emplace(1, 5);
+  ASSERT_TRUE(r.second);
+  ASSERT_EQ(1, r.first->first);
+  ASSERT_EQ(5, r.first->second.value);
+  ASSERT_EQ(1, tracked::constructions);
+
+  tracked::reset();
+  r = m.try_emplace(1, 6);
+  ASSERT_FALSE(r.second);
+  ASSERT_EQ(5, r.first->second.value);
+  ASSERT_EQ(0, tracked::constructions);
+  ASSERT_EQ(0, tracked::copies);
+
+  r = m.try_emplace(2);
+  ASSERT_TRUE(r.second);
+  ASSERT_EQ(0, r.first->second.value);
+  ASSERT_EQ(2u, m.size());
+}
+
+TEST(ChainHashMap, InsertOrAssign) {
+  tracked_map_type m;
+  tracked const t(7);
+
+  pair<tracked_map_type::iterator, bool> r = m.insert_or_assign(1, t);
+  ASSERT_TRUE(r.second);
+  ASSERT_EQ(7, r.first->second.value);
+
+  tracked::reset();
+  r = m.insert_or_assign(1, tracked(8));
+  ASSERT_FALSE(r.second);
+  ASSERT_EQ(8, m.at(1).value);
+  ASSERT_EQ(1, tracked::assignments);
+  ASSERT_EQ(0, tracked::copies);
+  ASSERT_EQ(1u, m.size());
+}
+
+TEST(ChainHashMap, Emplace) {
+  tracked_map_type m;
+
+  tracked::reset();
+  pair<tracked_map_type::iterator, bool> r = m.emplace(1, 3);
+  ASSERT_TRUE(r.second);
+  ASSERT_EQ(3, r.first->second.value);
+  ASSERT_EQ(1, tracked::constructions);
+  ASSERT_EQ(0, tracked::copies);
+
+  r = m.emplace(1, 4);
+  ASSERT_FALSE(r.second);
+  ASSERT_EQ(3, r.first->second.value);
+  ASSERT_EQ(1u, m.size());
+
+  for (int i = 2; i < 1000; ++i) ASSERT_TRUE(m.emplace(i, i).second);
+  ASSERT_EQ(999u, m.size());
+  for (int i = 2; i < 1000; ++i) ASSERT_EQ(i, m.at(i).value);
+}
+
+TEST(ChainHashMap, EraseInsertedIterator) {
+  int_map_type m;
+  for (int i = 0; i < 100; ++i) m[i] = i;
+
+  m.erase(m.try_emplace(100, 1).first);
+  m.erase(m.emplace(101, 1).first);
+  m.erase(m.insert_or_assign(102, 1).first);
+  m.erase(m.insert(make_pair(103, 1)).first);
+
+  ASSERT_EQ(100u, m.size());
+  for (int i = 0; i < 100; ++i) ASSERT_EQ(i, m.at(i));
+  for (int i = 100; i < 104; ++i) ASSERT_EQ(0u, m.count(i));
+  ASSERT_EQ(100, std::distance(m.begin(), m.end()));
+
+  // walking on from a returned iterator meets every later element once
+  vector<int> seen;
+  for (
+    int_map_type::iterator it = m.try_emplace(200, 0).first;
+    it != m.end();
+    ++it
+  ) {
+    seen.push_back(it->first);
+  }
+  std::sort(seen.begin(), seen.end());
+  ASSERT_TRUE(std::adjacent_find(seen.begin(), seen.end()) == seen.end());
+  ASSERT_GE(m.size(), seen.size());
+}
+
+#if __cplusplus >= 201103L
+TEST(ChainHashMap, MoveInsertsWithoutCopies) {
+  tracked_map_type m;
+
+  tracked_map_type::value_type v(1, tracked(1));
+
+  tracked::reset();
+  ASSERT_TRUE(m.insert(std::move(v)).second);
+  ASSERT_TRUE(m.try_emplace(2, tracked(2)).second);
+  ASSERT_TRUE(m.insert_or_assign(3, tracked(3)).second);
+  ASSERT_TRUE(m.emplace(4, tracked(4)).second);
+  ASSERT_EQ(0, tracked::copies);
+  ASSERT_EQ(4, tracked::moves);
+
+  sml::container::chain_hash_map< string, int, hash<string> > s;
+  string key(100, 'k');
+  s[std::move(key)] = 1;
+  ASSERT_EQ(1, s.at(string(100, 'k')));
+}
+#endif
+
+// (key, position in the input) pairs over `keys` distinct keys, each
+// repeated about n / keys times in scrambled order.
+vector< pair<int, int> > bulk_input(int const n, int const keys) {
+  vector< pair<int, int> > input;
+  for (int i = 0; i < n; ++i) {
+    input.push_back(make_pair(static_cast<int>((i * 7919u) % keys), i));
+  }
+  return input;
+}
+
+struct add_mapped {
+  void operator()(int& mapped, int const incoming) const {
+    mapped += incoming;
+  }
+};
+
+TEST(ChainHashMap, BulkInsertMatchesSequential) {
+  vector< pair<int, int> > const input = bulk_input(20000, 5000);
+
+  for (unsigned threads = 1; threads <= 4; threads *= 2) {
+    int_map_type first;
+    int_map_type last;
+    int_map_type sum;
+    first.bulk_insert(input.begin(), input.end(), threads);
+    last.bulk_insert(
+      input.begin(), input.end(), threads,
+      sml::container::keep_last_duplicate()
+    );
+    sum.bulk_insert(input.begin(), input.end(), threads, add_mapped());
+
+    int_map_type first_expected;
+    int_map_type last_expected;
+    int_map_type sum_expected;
+    for (size_t i = 0; i < input.size(); ++i) {
+      first_expected.insert(input[i]);
+      last_expected[input[i].first] = input[i].second;
+      sum_expected[input[i].first] += input[i].second;
+    }
+
+    ASSERT_EQ(5000u, first.size());
+    ASSERT_TRUE(first == first_expected);
+    ASSERT_TRUE(last  == last_expected);
+    ASSERT_TRUE(sum   == sum_expected);
+    ASSERT_EQ(first.size(), moved_size(first));
+    ASSERT_LE(first.load_factor(), first.max_load_factor());
+  }
+}
+
+TEST(ChainHashMap, BulkInsertIntoFilledMap) {
+  int_map_type m;
+  m.rehash_step(1);
+  for (int i = 0; i < 3000; ++i) m[i * 2] = -1;
+
+  vector< pair<int, int> > input;
+  for (int i = 0; i < 4000; ++i) input.push_back(make_pair(i, i));
+  m.bulk_insert(
+    input.begin(), input.end(), 3, sml::container::keep_last_duplicate()
+  );
+
+  ASSERT_EQ(5000u, m.size());
+  ASSERT_EQ(m.size(), moved_size(m));
+  for (int i = 0; i < 4000; ++i) ASSERT_EQ(i, m.at(i));
+  for (int i = 4000; i < 6000; i += 2) ASSERT_EQ(-1, m.at(i));
+
+  m.bulk_insert(input.begin(), input.begin(), 2);
+  ASSERT_EQ(5000u, m.size());
+
+  for (int i = 0; i < 6000; ++i) m.erase(i);
+  ASSERT_TRUE(m.empty());
+}
+
+TEST(ChainHashMap, BulkInsertStrings) {
+  vector< pair<string, int> > input;
+  for (int i = 0; i < 1000; ++i) {
+    input.push_back(make_pair(string(1 + i % 50, 'a' + i % 26), i));
+  }
+
+  map_type m;
+  m.bulk_insert(input.begin(), input.end(), 4);
+
+  map_type expected(input.begin(), input.end());
+  ASSERT_TRUE(m == expected);
+}
+
+TEST(ChainHashMap, RangeConstructorGrowsOnce) {
+  vector< pair<int, int> > const input = bulk_input(1000, 1000);
+
+  int_map_type m(input.begin(), input.end());
+  int_map_type r;
+  r.reserve(1000);
+
+  ASSERT_EQ(1000u, m.size());
+  ASSERT_EQ(r.bucket_count(), m.bucket_count());
+
+  int_map_type big(5000);
+  big.insert(input.begin(), input.end());
+  ASSERT_EQ(5000u, big.bucket_count());
+}
+
 // ----------------
 // ---- Types -----
 // ----------------
@@ -0,0 +1,239 @@
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <tr1/functional>
+#include <gtest/gtest.h>
+#include "sml/container/concurrent_hash_map.hpp"
+#include "sml/parallel/parallel_for.hpp"
+
+namespace {
+
+using std::make_pair;
+using std::size_t;
+using std::string;
+using std::vector;
+using std::tr1::hash;
+
+typedef sml::container::concurrent_hash_map< int, int, hash<int> > map_type;
+typedef map_type::size_type size_type;
+
+TEST(ConcurrentHashMap, Empty) {
+  map_type m;
+
+  ASSERT_TRUE(m.empty());
+  ASSERT_EQ(0u, m.size());
+  ASSERT_EQ(0u, m.count(1));
+
+  int v = -1;
+  ASSERT_FALSE(m.find(1, v));
+  ASSERT_EQ(-1, v);
+}
+
+TEST(ConcurrentHashMap, StripesAndBuckets) {
+  map_type m(10, 5);
+
+  ASSERT_EQ(8u,  m.stripe_count());
+  ASSERT_EQ(16u, m.bucket_count());
+
+  map_type d;
+  size_type const s = d.stripe_count();
+  ASSERT_EQ(0u, s & (s - 1));
+  ASSERT_LE(s, d.bucket_count());
+}
+
+TEST(ConcurrentHashMap, InsertFindErase) {
+  map_type m(1, 4);
+
+  for (int i = 0; i < 1000; ++i) ASSERT_TRUE(m.insert(make_pair(i, i * 2)));
+  ASSERT_FALSE(m.insert(make_pair(5, 0)));
+  ASSERT_EQ(1000u, m.size());
+  ASSERT_LE(1000u, m.bucket_count());
+
+  for (int i = 0; i < 1000; ++i) {
+    int v = -1;
+    ASSERT_TRUE(m.find(i, v));
+    ASSERT_EQ(i * 2, v);
+  }
+  ASSERT_EQ(0u, m.count(1000));
+
+  ASSERT_FALSE(m.insert_or_assign(5, 55));
+  ASSERT_TRUE(m.insert_or_assign(5000, 1));
+  int v = 0;
+  ASSERT_TRUE(m.find(5, v));
+  ASSERT_EQ(55, v);
+
+  for (int i = 0; i < 1000; i += 2) ASSERT_EQ(1u, m.erase(i));
+  ASSERT_EQ(0u, m.erase(0));
+  ASSERT_EQ(501u, m.size());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(static_cast<size_type>(i % 2), m.count(i));
+  }
+
+  m.clear();
+  ASSERT_TRUE(m.empty());
+  ASSERT_EQ(0u, m.count(1));
+
+  ASSERT_TRUE(m.insert(make_pair(1, 1)));
+  ASSERT_EQ(1u, m.count(1));
+}
+
+TEST(ConcurrentHashMap, StringKeys) {
+  sml::container::concurrent_hash_map< string, int, hash<string> > m;
+
+  m.insert(make_pair(string("abc"), 1));
+  m.insert(make_pair(string("def"), 2));
+
+  int v = 0;
+  ASSERT_TRUE(m.find("def", v));
+  ASSERT_EQ(2, v);
+  ASSERT_EQ(0u, m.count("xyz"));
+}
+
+// Every task inserts and reads back its own keys, erases every third one
+// and overwrites the next, while the other tasks do the same.
+struct worker {
+  worker(map_type& m, int const per_task) : m(&m), per_task(per_task) {}
+
+  void operator()(size_t const task) {
+    int const base = static_cast<int>(task) * this->per_task;
+
+    for (int i = 0; i < this->per_task; ++i) {
+      if (!this->m->insert(make_pair(base + i, base + i))) {
+        __sync_fetch_and_add(&this->errors, 1);
+      }
+    }
+    for (int i = 0; i < this->per_task; ++i) {
+      int v = -1;
+      if (!this->m->find(base + i, v) || v != base + i) {
+        __sync_fetch_and_add(&this->errors, 1);
+      }
+    }
+    for (int i = 0; i < this->per_task; i += 3) {
+      if (this->m->erase(base + i) != 1) {
+        __sync_fetch_and_add(&this->errors, 1);
+      }
+    }
+    for (int i = 1; i < this->per_task; i += 3) {
+      this->m->insert_or_assign(base + i, -(base + i));
+    }
+  }
+
+  map_type*    m;
+  int          per_task;
+  int          errors;
+};
+
+TEST(ConcurrentHashMap, ManyThreads) {
+  int const tasks    = 32;
+  int const per_task = 3000;
+
+  map_type m(1, 16);
+  worker w(m, per_task);
+  w.errors = 0;
+
+  sml::parallel::parallel_for(tasks, 8, w);
+
+  ASSERT_EQ(0, w.errors);
+
+  size_type expected = 0;
+  for (int k = 0; k < tasks * per_task; ++k) {
+    int const i = k % per_task;
+    int v = 0;
+    bool const found = m.find(k, v);
+
+    ASSERT_EQ(i % 3 != 0, found);
+    if (i % 3 == 1) {
+      ASSERT_EQ(-k, v);
+    }
+    if (i % 3 == 2) {
+      ASSERT_EQ(k, v);
+    }
+    if (found) ++expected;
+  }
+  ASSERT_EQ(expected, m.size());
+  ASSERT_LE(m.size(), m.bucket_count());
+}
+
+string value_of(int const key, int const version) {
+  std::ostringstream s;
+  s << "key " << key << " version " << version;
+  return s.str();
+}
+
+// Tasks 0 and 1 rewrite, erase and reinsert their own keys, growing the
+// table from one bucket; the others look keys up without a lock and check
+// every value they find is intact.
+struct readers_and_writers {
+  typedef
+    sml::container::concurrent_hash_map< int, string, hash<int> >
+    map_type;
+
+  readers_and_writers() :
+    m(1, 4),
+    done(0),
+    errors(0),
+    found(0) {
+  }
+
+  void operator()(size_t const task) {
+    if (task < 2) {
+      for (int round = 0; round < 4; ++round) {
+        for (int k = static_cast<int>(task); k < KEYS; k += 2) {
+          this->m.insert_or_assign(k, value_of(k, round));
+        }
+        for (int k = static_cast<int>(task); k < KEYS; k += 4) {
+          this->m.erase(k + 2 * (round % 2));
+        }
+      }
+      __sync_fetch_and_add(&this->done, 1);
+      return;
+    }
+
+    size_t found = 0;
+    while (__sync_fetch_and_add(&this->done, 0) < 2) {
+      for (int k = 0; k < KEYS; ++k) {
+        string v;
+        if (!this->m.find(k, v)) continue;
+        ++found;
+
+        bool valid = false;
+        for (int round = 0; round < 4; ++round) {
+          valid = valid || v == value_of(k, round);
+        }
+        if (!valid) __sync_fetch_and_add(&this->errors, 1);
+      }
+    }
+    __sync_fetch_and_add(&this->found, found);
+  }
+
+  static int const KEYS = 2000;
+
+  map_type     m;
+  int volatile done;
+  int volatile errors;
+  size_t       found;
+};
+
+TEST(ConcurrentHashMap, ReadersDuringWrites) {
+  readers_and_writers tasks;
+  sml::parallel::parallel_for(4, 4, tasks);
+
+  ASSERT_EQ(0, tasks.errors);
+  ASSERT_EQ(
+    static_cast<size_type>(readers_and_writers::KEYS / 2), tasks.m.size()
+  );
+
+  string v;
+  ASSERT_TRUE(tasks.m.find(0, v));
+  ASSERT_EQ(value_of(0, 3), v);
+  ASSERT_FALSE(tasks.m.find(2, v));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,244 @@
+#include <climits>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sched.h>
+#include <tr1/functional>
+#include <gtest/gtest.h>
+#include "sml/container/epoch_hash_map.hpp"
+#include "sml/parallel/parallel_for.hpp"
+
+namespace {
+
+using std::make_pair;
+using std::size_t;
+using std::string;
+using std::tr1::hash;
+
+typedef sml::container::epoch_hash_map< int, int, hash<int> > map_type;
+typedef map_type::size_type size_type;
+
+TEST(EpochHashMap, Empty) {
+  map_type m;
+
+  ASSERT_TRUE(m.empty());
+  ASSERT_EQ(0u, m.size());
+  ASSERT_EQ(0u, m.count(1));
+  ASSERT_EQ(0u, m.erase(1));
+
+  int v = -1;
+  ASSERT_FALSE(m.find(1, v));
+  ASSERT_EQ(-1, v);
+}
+
+TEST(EpochHashMap, InsertFindErase) {
+  map_type m(1);
+
+  for (int i = 0; i < 1000; ++i) ASSERT_TRUE(m.insert(make_pair(i, i * 2)));
+  ASSERT_FALSE(m.insert(make_pair(5, 0)));
+  ASSERT_EQ(1000u, m.size());
+  ASSERT_LE(1000u, m.bucket_count());
+
+  for (int i = 0; i < 1000; ++i) {
+    int v = -1;
+    ASSERT_TRUE(m.find(i, v));
+    ASSERT_EQ(i * 2, v);
+  }
+  ASSERT_EQ(0u, m.count(1000));
+
+  ASSERT_FALSE(m.insert_or_assign(5, 55));
+  ASSERT_TRUE(m.insert_or_assign(5000, 1));
+  int v = 0;
+  ASSERT_TRUE(m.find(5, v));
+  ASSERT_EQ(55, v);
+
+  for (int i = 0; i < 1000; i += 2) ASSERT_EQ(1u, m.erase(i));
+  ASSERT_EQ(0u, m.erase(0));
+  ASSERT_EQ(501u, m.size());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(static_cast<size_type>(i % 2), m.count(i));
+  }
+
+  m.clear();
+  ASSERT_TRUE(m.empty());
+  ASSERT_EQ(0u, m.count(1));
+
+  ASSERT_TRUE(m.insert(make_pair(1, 1)));
+  ASSERT_EQ(1u, m.count(1));
+}
+
+TEST(EpochHashMap, ThrowsWithoutPthreadKeys) {
+  std::vector<map_type*> maps;
+  bool threw = false;
+  for (int i = 0; i <= PTHREAD_KEYS_MAX && !threw; ++i) {
+    try {
+      maps.push_back(new map_type(1));
+    }
+    catch (std::runtime_error const&) {
+      threw = true;
+    }
+  }
+  for (size_t i = 0; i < maps.size(); ++i) delete maps[i];
+
+  ASSERT_TRUE(threw);
+
+  map_type m(1);
+  ASSERT_TRUE(m.insert(make_pair(1, 1)));
+  ASSERT_EQ(1u, m.count(1));
+}
+
+TEST(EpochHashMap, ReclaimsWithoutReaders) {
+  map_type m;
+
+  for (int i = 0; i < 100; ++i) m.insert(make_pair(i, i));
+  for (int i = 0; i < 100; i += 2) m.insert_or_assign(i, -i);
+  for (int i = 1; i < 100; i += 2) m.erase(i);
+  ASSERT_EQ(0u, m.retired());
+
+  int v = 0;
+  ASSERT_TRUE(m.find(10, v));
+  ASSERT_EQ(-10, v);
+}
+
+// Holds a lookup of GATE inside its read section until released.
+int const GATE = 7;
+int volatile gate_entered  = 0;
+int volatile gate_released = 0;
+
+struct gate_eq {
+  bool operator()(int const a, int const b) const {
+    if (b == GATE && !__sync_fetch_and_add(&gate_entered, 0)) {
+      __sync_lock_test_and_set(&gate_entered, 1);
+      while (!__sync_fetch_and_add(&gate_released, 0)) sched_yield();
+    }
+    return a == b;
+  }
+};
+
+typedef
+  sml::container::epoch_hash_map< int, int, hash<int>, gate_eq >
+  gated_map_type;
+
+struct gated_reader_and_writer {
+  explicit gated_reader_and_writer(gated_map_type& m) :
+    m(&m),
+    retired_while_reading(0) {
+  }
+
+  void operator()(size_t const task) {
+    if (task == 0) {
+      int v = 0;
+      this->m->find(GATE, v);
+      return;
+    }
+
+    while (!__sync_fetch_and_add(&gate_entered, 0)) sched_yield();
+    this->m->erase(GATE + 1);
+    this->m->insert_or_assign(GATE + 2, 0);
+    this->retired_while_reading = this->m->retired();
+    __sync_lock_test_and_set(&gate_released, 1);
+  }
+
+  gated_map_type* m;
+  size_type       retired_while_reading;
+};
+
+TEST(EpochHashMap, ReaderDefersReclamation) {
+  gated_map_type m;
+  for (int i = 0; i < 10; ++i) m.insert(make_pair(i, i));
+
+  gated_reader_and_writer tasks(m);
+  sml::parallel::parallel_for(2, 2, tasks);
+
+  ASSERT_EQ(2u, tasks.retired_while_reading);
+  m.synchronize();
+  ASSERT_EQ(0u, m.retired());
+  ASSERT_EQ(0u, m.count(GATE + 1));
+  ASSERT_EQ(9u, m.size());
+}
+
+string value_of(int const key, int const version) {
+  std::ostringstream s;
+  s << "key " << key << " version " << version;
+  return s.str();
+}
+
+// Task 0 rewrites, erases and reinserts keys, growing the table from one
+// bucket; the others look them up and check every value they find is
+// intact.
+struct readers_and_writer {
+  typedef
+    sml::container::epoch_hash_map< int, string, hash<int> >
+    map_type;
+
+  readers_and_writer() :
+    m(1),
+    done(0),
+    errors(0),
+    found(0) {
+  }
+
+  void operator()(size_t const task) {
+    if (task == 0) {
+      for (int round = 0; round < 4; ++round) {
+        for (int k = 0; k < KEYS; ++k) {
+          this->m.insert_or_assign(k, value_of(k, round));
+        }
+        for (int k = round % 2; k < KEYS; k += 2) this->m.erase(k);
+      }
+      __sync_lock_test_and_set(&this->done, 1);
+      return;
+    }
+
+    size_t found = 0;
+    while (!__sync_fetch_and_add(&this->done, 0)) {
+      for (int k = 0; k < KEYS; ++k) {
+        string v;
+        if (!this->m.find(k, v)) continue;
+        ++found;
+
+        bool valid = false;
+        for (int round = 0; round < 4; ++round) {
+          valid = valid || v == value_of(k, round);
+        }
+        if (!valid) __sync_fetch_and_add(&this->errors, 1);
+      }
+    }
+    __sync_fetch_and_add(&this->found, found);
+  }
+
+  static int const KEYS = 2000;
+
+  map_type     m;
+  int volatile done;
+  int volatile errors;
+  size_t       found;
+};
+
+TEST(EpochHashMap, ReadersDuringWrites) {
+  readers_and_writer tasks;
+  sml::parallel::parallel_for(4, 4, tasks);
+
+  ASSERT_EQ(0, tasks.errors);
+  ASSERT_EQ(
+    static_cast<size_type>(readers_and_writer::KEYS / 2), tasks.m.size()
+  );
+
+  string v;
+  ASSERT_TRUE(tasks.m.find(0, v));
+  ASSERT_EQ(value_of(0, 3), v);
+  ASSERT_FALSE(tasks.m.find(1, v));
+
+  tasks.m.synchronize();
+  ASSERT_EQ(0u, tasks.m.retired());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
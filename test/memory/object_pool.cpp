@@ -0,0 +1,202 @@
+#include <memory>
+#include <new>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/memory/object_pool.hpp"
+
+namespace {
+
+struct Counter {
+  Counter(int i) : id(i), pad(0) {
+    Counter::throw_except();
+    ++Counter::count;
+  }
+
+  Counter(Counter const& r) : id(r.id), pad(0) {
+    Counter::throw_except();
+    ++Counter::count;
+  }
+
+  ~Counter() {
+    --Counter::count;
+  }
+
+  static void throw_except() {
+    if (Counter::count == Counter::except_count) {
+      throw Counter::count;
+    }
+  }
+
+  static int count;
+  static int except_count;
+  int id;
+  void* pad;
+};
+
+int Counter::count = 0;
+int Counter::except_count = -1;
+
+typedef sml::memory::object_pool< std::allocator<Counter> > pool_type;
+typedef pool_type::pointer pointer;
+typedef pool_type::size_type size_type;
+
+class ObjectPool : public testing::Test {
+protected:
+  void SetUp() {
+    Counter::count = 0;
+    Counter::except_count = -1;
+  }
+};
+
+TEST_F(ObjectPool, Constructor) {
+  pool_type pool;
+
+  ASSERT_EQ(0u, pool.size());
+  ASSERT_EQ(0u, pool.capacity());
+}
+
+TEST_F(ObjectPool, Construct) {
+  pool_type pool;
+  std::vector<pointer> objects;
+
+  for (int i = 0; i < 1000; ++i) objects.push_back(pool.construct(Counter(i)));
+
+  ASSERT_EQ(1000,  Counter::count);
+  ASSERT_EQ(1000u, pool.size());
+  ASSERT_LE(1000u, pool.capacity());
+
+  std::set<pointer> distinct(objects.begin(), objects.end());
+  ASSERT_EQ(objects.size(), distinct.size());
+
+  for (int i = 0; i < 1000; ++i) ASSERT_EQ(i, objects[i]->id);
+
+  for (int i = 0; i < 1000; ++i) pool.destroy(objects[i]);
+  ASSERT_EQ(0, Counter::count);
+}
+
+TEST_F(ObjectPool, ChunksGrowUpToMaximum) {
+  pool_type pool(std::allocator<Counter>(), 64);
+  std::vector<pointer> objects;
+
+  objects.push_back(pool.construct(Counter(0)));
+  ASSERT_EQ(16u, pool.capacity());
+
+  while (objects.size() < 16) objects.push_back(pool.construct(Counter(0)));
+  ASSERT_EQ(16u, pool.capacity());
+
+  objects.push_back(pool.construct(Counter(0)));
+  ASSERT_EQ(16u + 32u, pool.capacity());
+
+  while (objects.size() < 16 + 32 + 64 + 1) {
+    objects.push_back(pool.construct(Counter(0)));
+  }
+  ASSERT_EQ(16u + 32u + 64u + 64u, pool.capacity());
+
+  for (size_type i = 0; i < objects.size(); ++i) pool.destroy(objects[i]);
+}
+
+TEST_F(ObjectPool, DestroyedSlotsAreReused) {
+  pool_type pool;
+
+  pointer const a = pool.construct(Counter(1));
+  pointer const b = pool.construct(Counter(2));
+  size_type const capacity = pool.capacity();
+
+  pool.destroy(a);
+  ASSERT_EQ(1, Counter::count);
+  ASSERT_EQ(1u, pool.size());
+
+  pointer const c = pool.construct(Counter(3));
+  ASSERT_EQ(a, c);
+  ASSERT_EQ(3, c->id);
+  ASSERT_EQ(2, b->id);
+
+  for (int i = 0; i < 10000; ++i) pool.destroy(pool.construct(Counter(i)));
+  ASSERT_EQ(capacity, pool.capacity());
+
+  pool.destroy(b);
+  pool.destroy(c);
+  ASSERT_EQ(0, Counter::count);
+}
+
+TEST_F(ObjectPool, Purge) {
+  pool_type pool;
+
+  for (int i = 0; i < 100; ++i) pool.destroy(pool.construct(Counter(i)));
+  for (int i = 0; i < 100; ++i) pool.construct(Counter(i));
+
+  pool.purge();
+  ASSERT_EQ(0u, pool.size());
+  ASSERT_EQ(0u, pool.capacity());
+
+  pointer const p = pool.construct(Counter(7));
+  ASSERT_EQ(7, p->id);
+  ASSERT_EQ(16u, pool.capacity());
+  pool.destroy(p);
+}
+
+TEST_F(ObjectPool, Swap) {
+  pool_type a;
+  pool_type b;
+
+  pointer const p = a.construct(Counter(5));
+  a.swap(b);
+
+  ASSERT_EQ(0u, a.size());
+  ASSERT_EQ(1u, b.size());
+  ASSERT_EQ(5, p->id);
+
+  b.destroy(p);
+  ASSERT_EQ(0, Counter::count);
+}
+
+TEST_F(ObjectPool, ConstructInSlot) {
+  pool_type pool;
+
+  pointer const p = pool.allocate_slot();
+  ASSERT_EQ(1u, pool.size());
+  ASSERT_EQ(0, Counter::count);
+
+  ::new (static_cast<void*>(p)) Counter(4);
+  ASSERT_EQ(1, Counter::count);
+  pool.destroy(p);
+  ASSERT_EQ(0u, pool.size());
+
+  pointer const q = pool.allocate_slot();
+  ASSERT_EQ(p, q);
+  pool.deallocate_slot(q);
+  ASSERT_EQ(0u, pool.size());
+  ASSERT_EQ(q, pool.construct(Counter(5)));
+  pool.destroy(q);
+  ASSERT_EQ(0, Counter::count);
+}
+
+TEST_F(ObjectPool, ExceptionInValueCopyConstructor) {
+  pool_type pool;
+
+  pointer const a = pool.construct(Counter(1));
+  pool.destroy(a);
+
+  Counter const value(2);
+  Counter::except_count = 1;
+  try {
+    pool.construct(value);
+    FAIL() << "a exception must be thrown";
+  }
+  catch (...) {
+    ASSERT_EQ(1, Counter::count);
+    ASSERT_EQ(0u, pool.size());
+  }
+
+  Counter::except_count = -1;
+  ASSERT_EQ(a, pool.construct(value));
+  pool.destroy(a);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
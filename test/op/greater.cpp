@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "sml/op/greater.hpp"
+
+namespace {
+
+class Greater : public testing::Test {
+protected:
+
+  void SetUp() {
+    for (int i = 0; i < Greater::SIZE; ++i) {
+      this->arr_[i] = i;
+    }
+  }
+
+  static const int SIZE = 3;
+  int arr_[SIZE];
+  sml::op::greater greater_;
+};
+
+TEST_F(Greater, Less) {
+  for (int i = 0; i < Greater::SIZE - 1; ++i) {
+    ASSERT_FALSE(this->greater_(this->arr_[i], this->arr_[i+1]));
+  }
+}
+
+TEST_F(Greater, Greater) {
+  for (int i = 0; i < Greater::SIZE - 1; ++i) {
+    ASSERT_TRUE(this->greater_(this->arr_[i+1], this->arr_[i]));
+  }
+}
+
+TEST_F(Greater, Equal) {
+  for (int i = 0; i < Greater::SIZE; ++i) {
+    ASSERT_FALSE(this->greater_(this->arr_[i], this->arr_[i]));
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
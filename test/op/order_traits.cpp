@@ -0,0 +1,52 @@
+#include <functional>
+#include <string>
+#include <gtest/gtest.h>
+#include "sml/op/order_traits.hpp"
+
+namespace {
+
+using std::string;
+
+using sml::op::is_natural_order;
+using sml::op::is_reverse_order;
+
+struct by_length {
+  bool operator()(const string& a, const string& b) const {
+    return a.size() < b.size();
+  }
+};
+
+TEST(OrderTraits, NaturalOrders) {
+  ASSERT_TRUE((is_natural_order<sml::op::lesser, int>::value));
+  ASSERT_TRUE((is_natural_order<sml::op::comparator, double>::value));
+  ASSERT_TRUE((is_natural_order<sml::op::lesser, string>::value));
+  ASSERT_TRUE((is_natural_order<std::less<long>, long>::value));
+  ASSERT_TRUE((is_natural_order<const sml::op::lesser, int>::value));
+}
+
+TEST(OrderTraits, NotNaturalOrders) {
+  ASSERT_FALSE((is_natural_order<sml::op::greater, int>::value));
+  ASSERT_FALSE((is_natural_order<std::less<long>, int>::value));
+  ASSERT_FALSE((is_natural_order<std::greater<int>, int>::value));
+  ASSERT_FALSE((is_natural_order<by_length, string>::value));
+}
+
+TEST(OrderTraits, ReverseOrders) {
+  ASSERT_TRUE((is_reverse_order<sml::op::greater, int>::value));
+  ASSERT_TRUE((is_reverse_order<std::greater<float>, float>::value));
+  ASSERT_TRUE((is_reverse_order<const sml::op::greater, int>::value));
+}
+
+TEST(OrderTraits, NotReverseOrders) {
+  ASSERT_FALSE((is_reverse_order<sml::op::lesser, int>::value));
+  ASSERT_FALSE((is_reverse_order<sml::op::comparator, int>::value));
+  ASSERT_FALSE((is_reverse_order<std::greater<short>, int>::value));
+  ASSERT_FALSE((is_reverse_order<by_length, string>::value));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/parallel/parallel_for.hpp"
+
+namespace {
+
+using std::size_t;
+using std::vector;
+
+struct counter {
+  explicit counter(size_t const n) : hits(n) {}
+
+  void operator()(size_t const task) {
+    __sync_fetch_and_add(&this->hits[task], 1);
+  }
+
+  vector<int> hits;
+};
+
+struct thrower {
+  void operator()(size_t const task) {
+    if (task == 0) throw std::runtime_error("task 0");
+  }
+};
+
+TEST(ParallelFor, NoTask) {
+  counter c(0);
+  sml::parallel::parallel_for(0, 4, c);
+}
+
+TEST(ParallelFor, EveryTaskOnce) {
+  unsigned const threads[4] = {0, 1, 3, 16};
+
+  for (int t = 0; t < 4; ++t) {
+    counter c(1000);
+    sml::parallel::parallel_for(1000, threads[t], c);
+
+    for (size_t i = 0; i < 1000; ++i) {
+      ASSERT_EQ(1, c.hits[i]);
+    }
+  }
+}
+
+TEST(ParallelFor, RethrowsOnCallingThread) {
+  thrower t;
+  EXPECT_THROW(sml::parallel::parallel_for(1, 1, t), std::runtime_error);
+}
+
+TEST(ParallelFor, HardwareConcurrency) {
+  EXPECT_LE(1u, sml::parallel::hardware_concurrency());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/parallel/randomize.hpp"
+
+namespace {
+
+using std::vector;
+
+vector<int> iota(int const n) {
+  vector<int> seq(n);
+  for (int i = 0; i < n; ++i) seq[i] = i;
+  return seq;
+}
+
+void check_permutation(vector<int> seq) {
+  std::sort(seq.begin(), seq.end());
+  for (vector<int>::size_type i = 0; i < seq.size(); ++i) {
+    ASSERT_EQ(static_cast<int>(i), seq[i]);
+  }
+}
+
+TEST(ParallelRandomize, InEmptyVector) {
+  vector<int> seq;
+  EXPECT_EQ(seq.begin(),
+            sml::parallel::randomize(seq.begin(), seq.end(), 1));
+}
+
+TEST(ParallelRandomize, SmallRange) {
+  vector<int> seq = iota(100);
+  int* const begin = &seq[0];
+
+  EXPECT_EQ(begin, sml::parallel::randomize(begin, begin + 100, 1, 4));
+  EXPECT_FALSE(std::is_sorted(seq.begin(), seq.end()));
+  check_permutation(seq);
+}
+
+TEST(ParallelRandomize, IndependentOfThreadCount) {
+  int const N = 300000;
+  vector<int> reference = iota(N);
+  sml::parallel::randomize(reference.begin(), reference.end(), 42, 1);
+
+  EXPECT_FALSE(std::is_sorted(reference.begin(), reference.end()));
+  check_permutation(reference);
+
+  unsigned const threads[4] = {0, 2, 3, 8};
+  for (int t = 0; t < 4; ++t) {
+    vector<int> seq = iota(N);
+    sml::parallel::randomize(seq.begin(), seq.end(), 42, threads[t]);
+    EXPECT_TRUE(seq == reference);
+  }
+
+  vector<int> other = iota(N);
+  sml::parallel::randomize(other.begin(), other.end(), 43, 2);
+  EXPECT_TRUE(other != reference);
+}
+
+TEST(ParallelRandomize, PositionsAreUniform) {
+  int const N = 200000;
+  vector<int> seq = iota(N);
+  sml::parallel::randomize(seq.begin(), seq.end(), 7, 4);
+
+  // elements from the first half should land in each quarter equally often
+  int quarters[4] = {0, 0, 0, 0};
+  for (int i = 0; i < N; ++i) {
+    if (seq[i] < N / 2) ++quarters[i / (N / 4)];
+  }
+  for (int q = 0; q < 4; ++q) {
+    EXPECT_NEAR(N / 8, quarters[q], N / 100);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
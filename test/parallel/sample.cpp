@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/parallel/sample.hpp"
+
+namespace {
+
+using std::back_inserter;
+using std::vector;
+
+TEST(ParallelSample, EmptyRange) {
+  vector<int> seq, out;
+  sml::parallel::sample(seq.begin(), seq.end(), back_inserter(out), 3, 1);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(ParallelSample, KLargerThanRange) {
+  int seq[5] = {0, 1, 2, 3, 4};
+  vector<int> out;
+
+  sml::parallel::sample(seq, seq+5, back_inserter(out), 10, 1, 2);
+  ASSERT_EQ(5u, out.size());
+  std::sort(out.begin(), out.end());
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(i, out[i]);
+}
+
+TEST(ParallelSample, IndependentOfThreadCount) {
+  vector<int> seq(500000);
+  for (int i = 0; i < 500000; ++i) seq[i] = i;
+
+  vector<int> reference;
+  sml::parallel::sample(
+    seq.begin(), seq.end(), back_inserter(reference), 1000, 99, 1
+  );
+  ASSERT_EQ(1000u, reference.size());
+
+  vector<int> sorted(reference);
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_EQ(sorted.end(), std::adjacent_find(sorted.begin(), sorted.end()));
+
+  unsigned const threads[3] = {0, 3, 8};
+  for (int t = 0; t < 3; ++t) {
+    vector<int> out;
+    sml::parallel::sample(
+      seq.begin(), seq.end(), back_inserter(out), 1000, 99, threads[t]
+    );
+    EXPECT_TRUE(out == reference);
+  }
+}
+
+TEST(ParallelSample, Uniform) {
+  int const TRIALS = 4000;
+  int seq[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  vector<int> hist(10);
+
+  for (int t = 0; t < TRIALS; ++t) {
+    int out[2];
+    sml::parallel::sample(seq, seq+10, out, 2, t, 1);
+    ++hist[out[0]], ++hist[out[1]];
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NEAR(TRIALS * 2 / 10, hist[i], TRIALS * 2 / 10 * 0.15);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
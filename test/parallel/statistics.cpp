@@ -0,0 +1,64 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/parallel/statistics.hpp"
+
+namespace {
+
+using std::vector;
+
+TEST(ParallelStatistics, EmptyRange) {
+  vector<double> seq;
+  EXPECT_EQ(0u, sml::parallel::summarize(seq.begin(), seq.end()).count());
+}
+
+TEST(ParallelStatistics, MatchesSequential) {
+  vector<double> seq(300000);
+  for (int i = 0; i < 300000; ++i) seq[i] = std::cos(i * 0.01) * 50 + i % 7;
+
+  const sml::algorithm::statistics<> expected =
+    sml::algorithm::summarize(&seq[0], &seq[0] + seq.size());
+
+  for (unsigned threads = 1; threads <= 4; ++threads) {
+    const sml::algorithm::statistics<> stats =
+      sml::parallel::summarize(&seq[0], &seq[0] + seq.size(), threads);
+
+    EXPECT_EQ(expected.count(), stats.count());
+    EXPECT_EQ(expected.min(),   stats.min());
+    EXPECT_EQ(expected.max(),   stats.max());
+    EXPECT_NEAR(expected.sum(),      stats.sum(),      1e-6);
+    EXPECT_NEAR(expected.mean(),     stats.mean(),     1e-9);
+    EXPECT_NEAR(expected.variance(), stats.variance(), 1e-9);
+  }
+}
+
+TEST(ParallelStatistics, IndependentOfThreadCount) {
+  vector<int> seq(200000);
+  for (int i = 0; i < 200000; ++i) seq[i] = (i * 7919) % 1000;
+
+  const sml::algorithm::statistics<> one =
+    sml::parallel::summarize(seq.begin(), seq.end(), 1);
+  const sml::algorithm::statistics<> three =
+    sml::parallel::summarize(seq.begin(), seq.end(), 3);
+
+  EXPECT_EQ(one.sum(),      three.sum());
+  EXPECT_EQ(one.variance(), three.variance());
+}
+
+TEST(ParallelStatistics, SelectedOnly) {
+  vector<int> seq(100000, 2);
+  seq[70000] = -5;
+
+  const sml::algorithm::statistics<sml::algorithm::STAT_MIN> stats =
+    sml::parallel::summarize<sml::algorithm::STAT_MIN>(seq.begin(), seq.end());
+
+  EXPECT_EQ(100000u, stats.count());
+  EXPECT_EQ(-5.0,    stats.min());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
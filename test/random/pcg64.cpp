@@ -0,0 +1,51 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/random/pcg64.hpp"
+
+namespace {
+
+using std::vector;
+using sml::random::pcg64;
+
+TEST(Pcg64, ReferenceSequence) {
+  pcg64 rand(42, 54);
+
+  EXPECT_EQ(0x86b1da1d72062b68ULL, rand());
+  EXPECT_EQ(0x1304aa46c9853d39ULL, rand());
+  EXPECT_EQ(0xa3670e9e0dd50358ULL, rand());
+}
+
+TEST(Pcg64, Streams) {
+  pcg64 rand1(42, 1), rand2(42, 2);
+
+  EXPECT_TRUE(rand1 != rand2);
+  EXPECT_NE(rand1(), rand2());
+}
+
+TEST(Pcg64, Discard) {
+  pcg64 rand1(3, 4), rand2(3, 4);
+
+  rand1.discard(1000);
+  for (int i = 0; i < 1000; ++i) rand2();
+
+  EXPECT_TRUE(rand1 == rand2);
+  EXPECT_EQ(rand2(), rand1());
+}
+
+TEST(Pcg64, Generate) {
+  pcg64 rand1, rand2;
+  vector<pcg64::result_type> seq(100);
+
+  rand1.generate(seq.begin(), seq.end());
+  for (vector<pcg64::result_type>::size_type i = 0; i < seq.size(); ++i) {
+    EXPECT_EQ(rand2(), seq[i]);
+  }
+  EXPECT_TRUE(rand1 == rand2);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
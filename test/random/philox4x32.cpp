@@ -0,0 +1,100 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/random/philox4x32.hpp"
+
+namespace {
+
+using std::vector;
+using sml::random::philox4x32;
+
+typedef philox4x32::result_type result_type;
+
+TEST(Philox4x32, KnownAnswers) {
+  {
+    result_type const key[2] = {0, 0};
+    result_type ctr[4] = {0, 0, 0, 0};
+    philox4x32::encrypt(key, ctr);
+
+    EXPECT_EQ(0x6627e8d5u, ctr[0]);
+    EXPECT_EQ(0xe169c58du, ctr[1]);
+    EXPECT_EQ(0xbc57ac4cu, ctr[2]);
+    EXPECT_EQ(0x9b00dbd8u, ctr[3]);
+  }
+  {
+    result_type const key[2] = {0xffffffffu, 0xffffffffu};
+    result_type ctr[4] = {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu};
+    philox4x32::encrypt(key, ctr);
+
+    EXPECT_EQ(0x408f276du, ctr[0]);
+    EXPECT_EQ(0x41c83b0eu, ctr[1]);
+    EXPECT_EQ(0xa20bc7c6u, ctr[2]);
+    EXPECT_EQ(0x6d5451fdu, ctr[3]);
+  }
+  {
+    result_type const key[2] = {0xa4093822u, 0x299f31d0u};
+    result_type ctr[4] = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+    philox4x32::encrypt(key, ctr);
+
+    EXPECT_EQ(0xd16cfe09u, ctr[0]);
+    EXPECT_EQ(0x94fdccebu, ctr[1]);
+    EXPECT_EQ(0x5001e420u, ctr[2]);
+    EXPECT_EQ(0x24126ea1u, ctr[3]);
+  }
+}
+
+TEST(Philox4x32, SequenceIsCounterBlocks) {
+  philox4x32 rand(0, 0);
+
+  EXPECT_EQ(0x6627e8d5u, rand());
+  EXPECT_EQ(0xe169c58du, rand());
+  EXPECT_EQ(0xbc57ac4cu, rand());
+  EXPECT_EQ(0x9b00dbd8u, rand());
+
+  result_type block[4];
+  rand.block(1, block);
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(block[i], rand());
+}
+
+TEST(Philox4x32, Discard) {
+  for (int skip = 0; skip < 9; ++skip) {
+    philox4x32 rand1(77, 3), rand2(77, 3);
+
+    rand1.discard(skip);
+    for (int i = 0; i < skip; ++i) rand2();
+
+    EXPECT_TRUE(rand1 == rand2);
+    for (int i = 0; i < 6; ++i) EXPECT_EQ(rand2(), rand1());
+  }
+}
+
+TEST(Philox4x32, Split) {
+  philox4x32 rand(5);
+  philox4x32 s1 = rand.split(1), s1_again = rand.split(1), s2 = rand.split(2);
+
+  EXPECT_EQ(1u, s1.stream());
+  EXPECT_TRUE(s1 == s1_again);
+  EXPECT_TRUE(s1 != s2);
+
+  vector<result_type> seq1(8), seq2(8);
+  s1.generate(seq1.begin(), seq1.end());
+  s2.generate(seq2.begin(), seq2.end());
+  EXPECT_TRUE(seq1 != seq2);
+}
+
+TEST(Philox4x32, At) {
+  philox4x32 rand(9, 4);
+  result_type block[4];
+  rand.block(123, block);
+
+  EXPECT_EQ(
+    (static_cast<philox4x32::seed_type>(block[0]) << 32) | block[1],
+    rand.at(123)
+  );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
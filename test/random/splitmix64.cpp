@@ -0,0 +1,43 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/random/splitmix64.hpp"
+
+namespace {
+
+using std::vector;
+using sml::random::splitmix64;
+
+TEST(SplitMix64, ReferenceSequence) {
+  splitmix64 rand(0);
+
+  EXPECT_EQ(0xe220a8397b1dcdafULL, rand());
+  EXPECT_EQ(0x6e789e6aa1b965f4ULL, rand());
+  EXPECT_EQ(0x06c45d188009454fULL, rand());
+}
+
+TEST(SplitMix64, Discard) {
+  splitmix64 rand1(123), rand2(123);
+
+  rand1.discard(5);
+  for (int i = 0; i < 5; ++i) rand2();
+
+  EXPECT_TRUE(rand1 == rand2);
+  EXPECT_EQ(rand2(), rand1());
+}
+
+TEST(SplitMix64, Generate) {
+  splitmix64 rand1(7), rand2(7);
+  vector<splitmix64::result_type> seq(10);
+
+  rand1.generate(seq.begin(), seq.end());
+  for (vector<splitmix64::result_type>::size_type i = 0; i < seq.size(); ++i) {
+    EXPECT_EQ(rand2(), seq[i]);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
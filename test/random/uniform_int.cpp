@@ -0,0 +1,108 @@
+#include <vector>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+using std::vector;
+using std::rand;
+using sml::random::bounded_rand;
+using sml::random::uniform_bits;
+using sml::random::xoshiro256ss;
+
+typedef sml::ext::uint64_t uint64_t;
+
+// An engine with an awkward range: [3, 12].
+class narrow_engine {
+public:
+  typedef unsigned result_type;
+
+  narrow_engine() : rand_(1) {}
+
+  static result_type min() { return 3; }
+  static result_type max() { return 12; }
+
+  result_type operator()() {
+    return static_cast<result_type>(3 + bounded_rand(this->rand_, 10));
+  }
+
+private:
+  xoshiro256ss rand_;
+};
+
+template<class Random>
+void check_distribution(Random& rand, uint64_t const bound) {
+  int const DRAWS = 20000;
+  vector<int> hist(bound);
+
+  for (int i = 0; i < DRAWS; ++i) {
+    uint64_t const v = bounded_rand(rand, bound);
+    ASSERT_LT(v, bound);
+    ++hist[v];
+  }
+
+  double const expected = static_cast<double>(DRAWS) / bound;
+  for (uint64_t i = 0; i < bound; ++i) {
+    EXPECT_GT(hist[i], expected * 0.8);
+    EXPECT_LT(hist[i], expected * 1.2);
+  }
+}
+
+TEST(UniformInt, BoundedByStdRand) {
+  check_distribution(rand, 7);
+}
+
+TEST(UniformInt, BoundedByEngine) {
+  xoshiro256ss rand(17);
+  check_distribution(rand, 10);
+}
+
+TEST(UniformInt, BoundedByNarrowEngine) {
+  narrow_engine rand;
+  check_distribution(rand, 5);
+}
+
+TEST(UniformInt, TrivialBound) {
+  xoshiro256ss rand;
+
+  EXPECT_EQ(0u, bounded_rand(rand, 0));
+  EXPECT_EQ(0u, bounded_rand(rand, 1));
+}
+
+TEST(UniformInt, LargeBound) {
+  xoshiro256ss rand(3);
+  uint64_t const bound = 0x300000000ULL;
+  bool high_seen = false;
+
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t const v = bounded_rand(rand, bound);
+    ASSERT_LT(v, bound);
+    if (v >= 0x200000000ULL) high_seen = true;
+  }
+  EXPECT_TRUE(high_seen);
+}
+
+TEST(UniformInt, BitsFromStdRand) {
+  uint64_t acc_or = 0, acc_and = ~uint64_t();
+
+  for (int i = 0; i < 200; ++i) {
+    uint64_t const v = uniform_bits(rand, 64);
+    acc_or  |= v;
+    acc_and &= v;
+  }
+  EXPECT_EQ(~uint64_t(), acc_or);
+  EXPECT_EQ(0u, acc_and);
+
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_LE(uniform_bits(rand, 32), 0xffffffffULL);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,61 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+using std::vector;
+using sml::random::xoshiro256ss;
+
+TEST(Xoshiro256ss, ReferenceSequence) {
+  xoshiro256ss rand(1, 2, 3, 4);
+
+  EXPECT_EQ(11520ULL,                rand());
+  EXPECT_EQ(0ULL,                    rand());
+  EXPECT_EQ(1509978240ULL,           rand());
+  EXPECT_EQ(1215971899390074240ULL,  rand());
+}
+
+TEST(Xoshiro256ss, SeedBySplitMix64) {
+  xoshiro256ss rand(42);
+
+  EXPECT_EQ(0x15780b2e0c2ec716ULL, rand());
+  EXPECT_EQ(0x6104d9866d113a7eULL, rand());
+  EXPECT_EQ(0xae17533239e499a1ULL, rand());
+}
+
+TEST(Xoshiro256ss, Reseed) {
+  xoshiro256ss rand1(42), rand2;
+
+  EXPECT_TRUE(rand1 != rand2);
+  rand2.seed(42);
+  EXPECT_TRUE(rand1 == rand2);
+}
+
+TEST(Xoshiro256ss, Generate) {
+  xoshiro256ss rand1(9), rand2(9);
+  vector<xoshiro256ss::result_type> seq(100);
+
+  rand1.generate(seq.begin(), seq.end());
+  for (vector<xoshiro256ss::result_type>::size_type i = 0; i < seq.size(); ++i) {
+    EXPECT_EQ(rand2(), seq[i]);
+  }
+  EXPECT_TRUE(rand1 == rand2);
+}
+
+TEST(Xoshiro256ss, Jump) {
+  xoshiro256ss rand1(5), rand2(5);
+
+  rand1.jump();
+  EXPECT_TRUE(rand1 != rand2);
+
+  rand2.jump();
+  EXPECT_TRUE(rand1 == rand2);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
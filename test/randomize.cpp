@@ -3,12 +3,16 @@
 #include <cstdlib>
 #include <gtest/gtest.h>
 #include "sml/randomize.hpp"
+#include "sml/random/pcg64.hpp"
+#include "sml/random/xoshiro256ss.hpp"
 
 namespace {
 
 using std::vector;
 using std::find;
 using std::rand;
+using sml::random::pcg64;
+using sml::random::xoshiro256ss;
   
 TEST(Randomize, InEmptyArray) {
   int seq[0] = {};
@@ -79,6 +83,90 @@ TEST(Randomize, RangeInVector) {
   EXPECT_EQ('E', seq[4]);
 }
 
+TEST(Randomize, IsPermutationWithEngine) {
+  vector<int> seq(1000);
+  for (int i = 0; i < 1000; ++i) seq[i] = i;
+
+  xoshiro256ss rand(2);
+  sml::randomize(seq.begin(), seq.end(), rand);
+
+  EXPECT_FALSE(std::is_sorted(seq.begin(), seq.end()));
+  std::sort(seq.begin(), seq.end());
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(i, seq[i]);
+}
+
+TEST(Randomize, SameSeedSameOrder) {
+  vector<int> seq1(100), seq2(100);
+  for (int i = 0; i < 100; ++i) seq1[i] = seq2[i] = i;
+
+  pcg64 rand1(11), rand2(11);
+  sml::randomize(seq1.begin(), seq1.end(), rand1);
+  sml::randomize(seq2.begin(), seq2.end(), rand2);
+
+  EXPECT_TRUE(seq1 == seq2);
+}
+
+TEST(Randomize, UniformPermutations) {
+  int const SHUFFLES = 60000;
+  int count[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+
+  xoshiro256ss rand(5);
+  for (int n = 0; n < SHUFFLES; ++n) {
+    int seq[3] = {0, 1, 2};
+    sml::randomize(seq, seq+3, rand);
+    for (int i = 0; i < 3; ++i) ++count[i][seq[i]];
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    for (int v = 0; v < 3; ++v) {
+      EXPECT_GT(count[i][v], SHUFFLES / 3 * 0.95);
+      EXPECT_LT(count[i][v], SHUFFLES / 3 * 1.05);
+    }
+  }
+}
+
+TEST(RandomizeFirstK, ZeroK) {
+  int seq[3] = {1, 2, 3};
+  xoshiro256ss rand;
+
+  EXPECT_EQ(seq, sml::randomize_first_k(seq, seq+3, 0, rand));
+  EXPECT_EQ(1, seq[0]);
+  EXPECT_EQ(2, seq[1]);
+  EXPECT_EQ(3, seq[2]);
+}
+
+TEST(RandomizeFirstK, KLargerThanRange) {
+  vector<int> seq(10);
+  for (int i = 0; i < 10; ++i) seq[i] = i;
+  xoshiro256ss rand;
+
+  EXPECT_EQ(seq.end(), sml::randomize_first_k(seq.begin(), seq.end(), 20, rand));
+  std::sort(seq.begin(), seq.end());
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(i, seq[i]);
+}
+
+TEST(RandomizeFirstK, OnlyPrefixIsDrawn) {
+  int const TRIALS = 20000;
+  vector<int> hist(10);
+  xoshiro256ss rand(3);
+
+  for (int t = 0; t < TRIALS; ++t) {
+    int seq[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int* res = sml::randomize_first_k(seq, seq+10, 3, rand);
+    ASSERT_EQ(seq+3, res);
+
+    for (int i = 0; i < 3; ++i) ++hist[seq[i]];
+    std::sort(seq, seq+10);
+    for (int i = 0; i < 10; ++i) ASSERT_EQ(i, seq[i]);
+  }
+
+  double const expected = TRIALS * 3.0 / 10;
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_GT(hist[i], expected * 0.9);
+    EXPECT_LT(hist[i], expected * 1.1);
+  }
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
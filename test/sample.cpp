@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <list>
+#include <vector>
+#include <gtest/gtest.h>
+#include "sml/sample.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+using std::list;
+using std::sort;
+using std::vector;
+using sml::random::xoshiro256ss;
+
+double identity_weight(int v) {
+  return v;
+}
+
+double even_weight(int v) {
+  return v % 2 == 0 ? 1.0 : 0.0;
+}
+
+TEST(ReservoirSample, EmptySequence) {
+  list<int> seq;
+  int out[3] = {0, 0, 0};
+  xoshiro256ss rand;
+
+  EXPECT_EQ(out, sml::reservoir_sample(seq.begin(), seq.end(), out, 3, rand));
+}
+
+TEST(ReservoirSample, ShorterThanK) {
+  list<int> seq;
+  seq.push_back(1), seq.push_back(2);
+  int out[3] = {0, 0, 0};
+  xoshiro256ss rand;
+
+  int* res = sml::reservoir_sample(seq.begin(), seq.end(), out, 3, rand);
+  EXPECT_EQ(out+2, res);
+  EXPECT_EQ(1, out[0]);
+  EXPECT_EQ(2, out[1]);
+}
+
+TEST(ReservoirSample, DistinctElements) {
+  list<int> seq;
+  for (int i = 0; i < 10000; ++i) seq.push_back(i);
+  vector<int> out(50);
+  xoshiro256ss rand(4);
+
+  EXPECT_EQ(out.end(),
+            sml::reservoir_sample(seq.begin(), seq.end(), out.begin(), 50, rand));
+  sort(out.begin(), out.end());
+  EXPECT_EQ(out.end(), std::adjacent_find(out.begin(), out.end()));
+  EXPECT_LE(0,     out.front());
+  EXPECT_GT(10000, out.back());
+}
+
+TEST(ReservoirSample, Uniform) {
+  int const TRIALS = 20000;
+  vector<int> seq(20);
+  for (int i = 0; i < 20; ++i) seq[i] = i;
+  vector<int> hist(20);
+  xoshiro256ss rand(8);
+
+  for (int t = 0; t < TRIALS; ++t) {
+    int out[5];
+    sml::reservoir_sample(seq.begin(), seq.end(), out, 5, rand);
+    for (int i = 0; i < 5; ++i) ++hist[out[i]];
+  }
+
+  double const expected = TRIALS * 5.0 / 20;
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_GT(hist[i], expected * 0.9);
+    EXPECT_LT(hist[i], expected * 1.1);
+  }
+}
+
+TEST(WeightedSample, SkipsZeroWeights) {
+  vector<int> seq;
+  for (int i = 0; i < 100; ++i) seq.push_back(i);
+  vector<int> out(10);
+  xoshiro256ss rand(1);
+
+  vector<int>::iterator res = sml::weighted_sample(
+    seq.begin(), seq.end(), out.begin(), 10, even_weight, rand
+  );
+
+  EXPECT_EQ(out.end(), res);
+  sort(out.begin(), out.end());
+  EXPECT_EQ(out.end(), std::adjacent_find(out.begin(), out.end()));
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(0, out[i] % 2);
+}
+
+TEST(WeightedSample, FewerCandidatesThanK) {
+  int seq[4] = {0, 3, 0, 5};
+  int out[4] = {0, 0, 0, 0};
+  xoshiro256ss rand(2);
+
+  int* res = sml::weighted_sample(seq, seq+4, out, 4, identity_weight, rand);
+  EXPECT_EQ(out+2, res);
+  sort(out, res);
+  EXPECT_EQ(3, out[0]);
+  EXPECT_EQ(5, out[1]);
+}
+
+TEST(WeightedSample, ProportionalForSingleDraw) {
+  int const TRIALS = 30000;
+  int seq[3] = {1, 2, 3};
+  int hist[4] = {0, 0, 0, 0};
+  xoshiro256ss rand(6);
+
+  for (int t = 0; t < TRIALS; ++t) {
+    int out;
+    sml::weighted_sample(seq, seq+3, &out, 1, identity_weight, rand);
+    ++hist[out];
+  }
+
+  EXPECT_NEAR(TRIALS / 6.0,     hist[1], TRIALS * 0.02);
+  EXPECT_NEAR(TRIALS * 2 / 6.0, hist[2], TRIALS * 0.02);
+  EXPECT_NEAR(TRIALS * 3 / 6.0, hist[3], TRIALS * 0.02);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
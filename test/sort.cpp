@@ -1,6 +1,9 @@
 #include <vector>
 #include <cstdlib>
+#include <functional>
+#include <string>
 #include <gtest/gtest.h>
+#include "sml/op/greater.hpp"
 #include "sml/sort.hpp"
 
 namespace {
@@ -167,6 +170,49 @@ TEST(SmlSort, InArrayOfMillion) {
   }
 }
 
+TEST(SmlSort, NegativeIntsInVector) {
+  vector<int> seq;
+  for (int i = 0; i < 5000; ++i) {
+    seq.push_back(rand() - RAND_MAX / 2);
+  }
+  vector<int> expected(seq);
+  std::sort(expected.begin(), expected.end());
+
+  sml::sort(seq.begin(), seq.end());
+
+  ASSERT_EQ(expected, seq);
+}
+
+TEST(SmlSort, ReverseOrders) {
+  vector<long> seq;
+  for (int i = 0; i < 5000; ++i) {
+    seq.push_back(rand() - RAND_MAX / 2);
+  }
+  vector<long> expected(seq);
+  std::sort(expected.begin(), expected.end(), std::greater<long>());
+
+  vector<long> by_greater(seq);
+  sml::sort(by_greater.begin(), by_greater.end(), sml::op::greater());
+  ASSERT_EQ(expected, by_greater);
+
+  vector<long> by_std_greater(seq);
+  sml::sort(by_std_greater.begin(), by_std_greater.end(), std::greater<long>());
+  ASSERT_EQ(expected, by_std_greater);
+}
+
+TEST(SmlSort, StringsInVector) {
+  vector<std::string> seq;
+  for (int i = 0; i < 500; ++i) {
+    seq.push_back(std::string(1 + i % 7, char('a' + rand() % 26)));
+  }
+  vector<std::string> expected(seq);
+  std::sort(expected.begin(), expected.end());
+
+  sml::sort(seq.begin(), seq.end());
+
+  ASSERT_EQ(expected, seq);
+}
+
 TEST(PerformanceOfSmlSort, InArrayOfMillion) {
   int seq[1000000];
   for (int i = 0; i < 1000000; ++i) {
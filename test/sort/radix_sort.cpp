@@ -0,0 +1,102 @@
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <gtest/gtest.h>
+#include "sml/sort/radix_sort.hpp"
+#include "sml/ext/cstdint.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+
+namespace {
+
+using std::vector;
+
+template<class T>
+void check_against_std_sort(vector<T> seq) {
+  vector<T> expected(seq);
+  std::sort(expected.begin(), expected.end());
+
+  const typename vector<T>::iterator res =
+    sml::sorting::radix_sort(seq.begin(), seq.end());
+
+  ASSERT_EQ(seq.begin(), res);
+  ASSERT_EQ(expected, seq);
+}
+
+template<class T>
+vector<T> random_values(const std::size_t n, const unsigned long long seed) {
+  sml::random::xoshiro256ss rand(seed);
+  vector<T> seq;
+  for (std::size_t i = 0; i < n; ++i) seq.push_back(static_cast<T>(rand()));
+  return seq;
+}
+
+TEST(RadixSort, InEmptyArray) {
+  int seq[0] = {};
+  int* res   = sml::sorting::radix_sort(seq, seq);
+
+  ASSERT_EQ(seq, res);
+}
+
+TEST(RadixSort, OneInArray) {
+  int seq[1] = {3};
+  int* res   = sml::sorting::radix_sort(seq, seq+1);
+
+  ASSERT_EQ(seq, res);
+  ASSERT_EQ(3, seq[0]);
+}
+
+TEST(RadixSort, RangeInArray) {
+  int seq[5] = {102, 50, 88, 71, 21};
+  int* res   = sml::sorting::radix_sort(seq+1, seq+4);
+
+  ASSERT_EQ(seq+1, res);
+  ASSERT_EQ(102, seq[0]);
+  ASSERT_EQ(50,  seq[1]);
+  ASSERT_EQ(71,  seq[2]);
+  ASSERT_EQ(88,  seq[3]);
+  ASSERT_EQ(21,  seq[4]);
+}
+
+TEST(RadixSort, NegativeInts) {
+  int seq[6] = {3, -1, 0, std::numeric_limits<int>::min(), -70000, 70000};
+  sml::sorting::radix_sort(seq, seq+6);
+
+  ASSERT_EQ(std::numeric_limits<int>::min(), seq[0]);
+  ASSERT_EQ(-70000, seq[1]);
+  ASSERT_EQ(-1,     seq[2]);
+  ASSERT_EQ(0,      seq[3]);
+  ASSERT_EQ(3,      seq[4]);
+  ASSERT_EQ(70000,  seq[5]);
+}
+
+TEST(RadixSort, AllEqual) {
+  check_against_std_sort(vector<int>(1000, 42));
+}
+
+TEST(RadixSort, NarrowRangeInWideType) {
+  vector<sml::ext::int64_t> seq;
+  sml::random::xoshiro256ss rand(3);
+  for (int i = 0; i < 5000; ++i) {
+    seq.push_back(sml::ext::int64_t(sml::random::bounded_rand(rand, 1000)) - 500);
+  }
+  check_against_std_sort(seq);
+}
+
+TEST(RadixSort, RandomOfEveryWidth) {
+  check_against_std_sort(random_values<signed char>(3000, 1));
+  check_against_std_sort(random_values<unsigned char>(3000, 2));
+  check_against_std_sort(random_values<short>(3000, 3));
+  check_against_std_sort(random_values<unsigned short>(3000, 4));
+  check_against_std_sort(random_values<sml::ext::int32_t>(3000, 5));
+  check_against_std_sort(random_values<sml::ext::uint32_t>(3000, 6));
+  check_against_std_sort(random_values<sml::ext::int64_t>(3000, 7));
+  check_against_std_sort(random_values<sml::ext::uint64_t>(3000, 8));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,140 @@
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <gtest/gtest.h>
+#include "sml/algorithm/binary_search.hpp"
+#include "sml/container/red_black_tree.hpp"
+#include "sml/random/uniform_int.hpp"
+#include "sml/random/xoshiro256ss.hpp"
+#include "sml/sort.hpp"
+#include "sml/utility/prefix_key.hpp"
+
+namespace {
+
+using std::vector;
+using std::string;
+
+using sml::utility::prefix_key;
+
+template<class Key>
+int sign_of_compare(const string& a, const string& b) {
+  const int res = Key(a).compare(Key(b));
+  return res < 0 ? -1 : res > 0 ? 1 : 0;
+}
+
+int sign_of(const int x) {
+  return x < 0 ? -1 : x > 0 ? 1 : 0;
+}
+
+vector<string> random_strings(const int n, const unsigned long long seed) {
+  sml::random::xoshiro256ss rand(seed);
+  vector<string> seq;
+  for (int i = 0; i < n; ++i) {
+    // long shared prefixes and embedded zeros make ties in the prefix
+    string s(sml::random::bounded_rand(rand, 3) * 8, 'k');
+    const int len = int(sml::random::bounded_rand(rand, 20));
+    for (int j = 0; j < len; ++j) {
+      s += char(sml::random::bounded_rand(rand, 4) * 85);
+    }
+    seq.push_back(s);
+  }
+  return seq;
+}
+
+TEST(PrefixKey, Accessors) {
+  const string s("hello, world");
+  const prefix_key<> key(s);
+
+  ASSERT_EQ(&s, &key.key());
+  ASSERT_EQ(s.size(), key.size());
+}
+
+TEST(PrefixKey, ShortKeys) {
+  ASSERT_EQ(-1, sign_of_compare< prefix_key<> >("ab", "abc"));
+  ASSERT_EQ(1,  sign_of_compare< prefix_key<> >("b", "abc"));
+  ASSERT_EQ(0,  sign_of_compare< prefix_key<> >("abc", "abc"));
+  ASSERT_EQ(-1, sign_of_compare< prefix_key<> >("", "a"));
+  ASSERT_EQ(0,  sign_of_compare< prefix_key<> >("", ""));
+}
+
+TEST(PrefixKey, TrailingZeros) {
+  const string a("ab"), b("ab\0", 3), c("ab\0\0\0\0\0\0\0x", 10);
+
+  ASSERT_EQ(-1, sign_of_compare< prefix_key<> >(a, b));
+  ASSERT_EQ(-1, sign_of_compare< prefix_key<> >(b, c));
+  ASSERT_EQ(1,  sign_of_compare< prefix_key<> >(c, a));
+}
+
+TEST(PrefixKey, HighCharacters) {
+  ASSERT_EQ(1, sign_of_compare< prefix_key<> >("\xff", "a"));
+  ASSERT_EQ(1, sign_of_compare< prefix_key<16> >("\xff", "a"));
+}
+
+TEST(PrefixKey, EqualPrefixes) {
+  ASSERT_EQ(-1, sign_of_compare< prefix_key<> >("prefix_a_long", "prefix_b"));
+  ASSERT_EQ(-1, sign_of_compare< prefix_key<> >("prefix_key_a", "prefix_key_b"));
+  ASSERT_EQ(1,  sign_of_compare< prefix_key<> >("prefix_key_ab", "prefix_key_a"));
+  ASSERT_EQ(0,  sign_of_compare< prefix_key<> >("prefix_key_a", "prefix_key_a"));
+}
+
+TEST(PrefixKey, AgainstStringCompare) {
+  const vector<string> seq = random_strings(300, 40);
+
+  for (size_t i = 0; i < seq.size(); ++i) {
+    for (size_t j = 0; j < seq.size(); ++j) {
+      const int expected = sign_of(seq[i].compare(seq[j]));
+      ASSERT_EQ(expected, sign_of_compare< prefix_key<> >(seq[i], seq[j]));
+      ASSERT_EQ(expected, sign_of_compare< prefix_key<16> >(seq[i], seq[j]));
+    }
+  }
+}
+
+TEST(PrefixKey, SortAndSearch) {
+  const vector<string> seq = random_strings(2000, 41);
+
+  vector< prefix_key<> > keys;
+  for (size_t i = 0; i < seq.size(); ++i) keys.push_back(prefix_key<>(seq[i]));
+  sml::sort(keys.begin(), keys.end());
+
+  vector<string> expected(seq);
+  std::sort(expected.begin(), expected.end());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(expected[i], keys[i].key());
+  }
+
+  for (size_t i = 0; i < seq.size(); ++i) {
+    const vector< prefix_key<> >::iterator pos = sml::algorithm::binary_search(
+      keys.begin(), keys.end(), prefix_key<>(seq[i])
+    );
+    ASSERT_TRUE(pos != keys.end());
+    ASSERT_EQ(seq[i], pos->key());
+  }
+
+  const string missing("kkkkkkkkz");
+  ASSERT_TRUE(
+    sml::algorithm::binary_search(keys.begin(), keys.end(), prefix_key<>(missing))
+      == keys.end()
+  );
+}
+
+TEST(PrefixKey, TreeLookups) {
+  const vector<string> seq = random_strings(500, 42);
+
+  sml::container::red_black_tree<prefix_key<>, size_t> tree;
+  for (size_t i = 0; i < seq.size(); ++i) {
+    tree.insert(std::make_pair(prefix_key<>(seq[i]), i));
+  }
+
+  for (size_t i = 0; i < seq.size(); ++i) {
+    ASSERT_TRUE(tree.find(prefix_key<>(seq[i])) != tree.end());
+    ASSERT_EQ(seq[i], tree.find(prefix_key<>(seq[i]))->first.key());
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}